@@ -0,0 +1,37 @@
+#ifndef AILEVEL_H
+#define AILEVEL_H
+
+#include "chesscore.h"
+
+// Niveaux de l'IA : un temps de réponse visé plutôt qu'une profondeur, pour que l'IA réponde aussi vite
+// dans toutes les positions et sur toutes les machines. Le budget de noeuds vaut ce temps
+// multiplié par la vitesse mesurée au lancement ; le plafond arrête la recherche si les noeuds
+// coûtent plus cher que prévu. Les niveaux faibles tirent leur coup au sort parmi les
+// variantes proches de la meilleure (multi-PV) au lieu de chercher moins profond.
+typedef enum // Niveau de difficulté (budgets dans AI_LEVELS, ailevel.c)
+{
+    DIFF_EASY, // ~0,1 s de recherche, coup tiré parmi les 4 meilleurs, Delay = 3s
+    DIFF_MEDIUM, // ~0,4 s, coup tiré parmi les 2 meilleurs, Delay = 2s
+    DIFF_HARD // ~1,5 s, meilleur coup, Delay = 1s
+} AIDifficulty;
+
+typedef struct
+{
+    double targetMs;  // Temps de recherche visé (budget de noeuds)
+    double capMs;     // Arrêt immédiat au-delà
+    int depth;        // Profondeur maximale : au-delà de ce que le budget atteint d'ordinaire, mais une
+                      // position déjà cherchée aussi loin (apprentissage) est rejouée sans recherche
+    int lines;        // Variantes candidates (1 = toujours le meilleur coup)
+    int marginCp;     // Écart de score maximal avec la meilleure variante
+} AILevel;
+
+#define AI_REFERENCE_NPS 150000.0 // Vitesse supposée tant qu'aucune mesure n'est faite
+#define AI_MIN_NODES 2000
+
+const AILevel *AILevel_Get(AIDifficulty difficulty);
+long AILevel_Nodes(AIDifficulty difficulty, double engineNps);  // Budget de noeuds pour cette vitesse
+
+// Limites de la recherche pour le niveau (control : plafond de temps, ou NULL)
+SearchLimits AILevel_Limits(AIDifficulty difficulty, long nodes, SearchControl *control);
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef ANALYSIS_H
+#define ANALYSIS_H
+
+#include "chesscore.h"
+#include <stdbool.h>
+
+// Analyse continue d'une position sur un thread à part (partie à deux joueurs) : recherche
+// sans limite, multi-PV, relancée à chaque coup avec la même table de transposition.
+// Le jeu ne fait que déposer la position et relire le dernier résultat : aucun appel ne bloque
+// sur la recherche, sauf Analysis_Stop (au plus une itération de profondeur 1).
+#define ANALYSIS_MAX_LINES 3
+#define ANALYSIS_LINE_TEXT 96
+#define ANALYSIS_THREAD_STACK (8 * 1024 * 1024)
+
+typedef struct
+{
+    int score;                      // Point de vue des Blancs (±INFINITY = mat)
+    Move move;                      // Premier coup de la variante
+    char text[ANALYSIS_LINE_TEXT];  // Variante en notation algébrique
+} AnalysisLine;
+
+typedef struct
+{
+    unsigned int positionId;        // Celui passé à Analysis_SetPosition
+    int depth;                      // Dernière itération terminée (0 = rien encore)
+    long nodes;
+    double nps;
+    int lineCount;
+    AnalysisLine lines[ANALYSIS_MAX_LINES];
+} AnalysisInfo;
+
+// Lance le thread (threads = threads de recherche, lazy SMP) ; sans effet s'il tourne déjà
+bool Analysis_Start(int threads, int lineCount);
+bool Analysis_IsRunning(void);
+
+// Nouvelle position à analyser : la recherche en cours est abandonnée
+void Analysis_SetPosition(const Board *board, unsigned int positionId);
+
+// Dernier résultat publié (copie) ; false avant la première itération de la position courante
+bool Analysis_GetInfo(AnalysisInfo *info);
+
+// Arrête la recherche et le thread
+void Analysis_Stop(void);
+
+#endif
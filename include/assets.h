@@ -0,0 +1,48 @@
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Paquet d'assets : images et sons déjà décodés, dans un seul fichier projeté en mémoire.
+// Produit par "./build/game --pack assets/bundle.pak" (ou "make bundle").
+#define BUNDLE_MAGIC "CHPK"
+#define BUNDLE_VERSION 1
+#define BUNDLE_PATH "assets/bundle.pak"
+#define BUNDLE_ALIGN 64
+
+#define BUNDLE_KIND_IMAGE 0 // a = largeur, b = hauteur, c = format raylib, d = mipmaps
+#define BUNDLE_KIND_WAVE 1  // a = frames, b = fréquence, c = bits par échantillon, d = canaux
+#define BUNDLE_KIND_RAW 2   // Données brutes (rectangles de l'atlas)
+
+typedef struct
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+} BundleHeader;
+
+typedef struct
+{
+    char name[32];
+    uint32_t kind;
+    int32_t a, b, c, d;
+    uint32_t reserved;
+    uint64_t offset; // Depuis le début du fichier, aligné sur BUNDLE_ALIGN
+    uint64_t size;
+} BundleEntry;
+
+// Lance le décodage sur un thread de travail (paquet si présent, sinon fichiers d'origine)
+bool Assets_StartLoading(const char *bundlePath);
+
+// Thread principal, une fois par image : envoie au GPU / à l'audio ce qui est prêt.
+// Renvoie true quand tout est chargé.
+bool Assets_Update(void);
+float Assets_Progress(void);
+void Assets_Unload(void);
+
+// Décode tous les assets d'origine et écrit le paquet (sans fenêtre)
+bool Assets_WriteBundle(const char *path);
+
+#endif
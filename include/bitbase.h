@@ -0,0 +1,39 @@
+#ifndef BITBASE_H
+#define BITBASE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Bitbases Roi + (Pion | Tour | Reine) contre Roi, produites par tools/bbgen.c.
+// Le camp fort est toujours rangé comme "Blanc" : 1 bit par position = gain, 0 = nul.
+#define BITBASE_MAGIC "CHBB"
+#define BITBASE_VERSION 1
+#define BITBASE_POSITIONS (2 * 64 * 64 * 64)
+
+// stm : 0 = camp fort au trait, 1 = camp faible au trait ; cases = y * 8 + x
+#define BITBASE_INDEX(stm, strongKing, weakKing, pieceSq) \
+    ((((stm) * 64 + (strongKing)) * 64 + (weakKing)) * 64 + (pieceSq))
+
+typedef struct
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t pieceID;    // ID (blanc) de la pièce du camp fort : 6, 12 ou 8
+    uint32_t positions;  // BITBASE_POSITIONS
+} BitbaseHeader;
+
+typedef enum
+{
+    BITBASE_NONE,        // Position non couverte
+    BITBASE_DRAW,
+    BITBASE_WHITE_WINS,
+    BITBASE_BLACK_WINS
+} BitbaseResult;
+
+int Bitbase_Load(const char *directory); // Renvoie le nombre de bitbases projetées
+void Bitbase_Unload(void);
+
+// squares[y * 8 + x] = ID de la pièce (0 = vide)
+BitbaseResult Bitbase_Probe(const int squares[64], int sideToMove);
+
+#endif
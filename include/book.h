@@ -0,0 +1,37 @@
+#ifndef BOOK_H
+#define BOOK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Livre d'ouverture : entrées de 16 octets (gros-boutiste) triées par clé, disposition Polyglot.
+// Les clés sont celles du moteur (zobrist.c), pas les clés Polyglot officielles.
+typedef struct
+{
+    uint64_t key;
+    uint16_t move;    // Bits 0-2 colonne d'arrivée, 3-5 rangée d'arrivée, 6-8 colonne de départ, 9-11 rangée de départ
+    uint16_t weight;
+    uint32_t learn;
+} BookEntry;
+
+#define BOOK_ENTRY_SIZE 16
+
+// Encodage des coups (rangée 0 = rangée 1 de l'échiquier, donc y = 7 - rangée)
+#define BOOK_MOVE(fromX, fromY, toX, toY) \
+    (uint16_t)(((7 - (fromY)) << 9) | ((fromX) << 6) | ((7 - (toY)) << 3) | (toX))
+#define BOOK_MOVE_FROM_X(m) (((m) >> 6) & 7)
+#define BOOK_MOVE_FROM_Y(m) (7 - (((m) >> 9) & 7))
+#define BOOK_MOVE_TO_X(m) ((m) & 7)
+#define BOOK_MOVE_TO_Y(m) (7 - (((m) >> 3) & 7))
+
+bool Book_Open(const char *path);
+void Book_Close(void);
+bool Book_IsOpen(void);
+
+// Toutes les entrées d'une position (au plus maxEntries), renvoie leur nombre
+int Book_Probe(uint64_t key, BookEntry *entries, int maxEntries);
+
+// Écriture d'un livre (entrées déjà triées par clé)
+bool Book_Write(const char *path, const BookEntry *entries, long count);
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef BOOKBUILD_H
+#define BOOKBUILD_H
+
+#include <stdbool.h>
+
+typedef struct
+{
+    int maxPlies;    // Profondeur maximale (demi-coups) enregistrée par partie
+    int minWeight;   // Les coups dont le poids total est inférieur sont écartés
+    bool uniform;    // true : chaque occurrence compte 1 ; false : gain 2, nul 1, défaite 0
+} BookBuildOptions;
+
+// Construit un livre d'ouverture à partir de fichiers PGN, renvoie le nombre d'entrées écrites (-1 si erreur)
+long BuildBookFromPGN(const char *outPath, const char *const *pgnFiles, int fileCount, const BookBuildOptions *options);
+
+#endif
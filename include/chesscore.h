@@ -0,0 +1,117 @@
+#ifndef CHESSCORE_H
+#define CHESSCORE_H
+
+// Moteur d'échecs sans raylib (build/libchesscore.a) : règles, génération de coups, FEN,
+// évaluation et recherche. Le jeu (game.c) et les outils en ligne de commande s'appuient dessus.
+
+#include "nnue.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BOARD_COLS 8
+#define BOARD_ROWS 8
+#define BOARD_SIZE 8
+#define MAX_LAYERS 4
+#define INFINITY 2000000
+#define INFINITY_SCORE 999999
+#define MAX_MOVES 256 // Augmenté pour la génération de coups
+#define START_FEN "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
+#define PROMOTION_DEFERRED -1 // ApplyMove : le pion reste, la pièce est choisie plus tard (PromotePawn)
+
+typedef struct
+{
+    int layers[MAX_LAYERS];     // indices dans gTileTextures
+    int layerCount;             // nombre de couches utilisées
+} Tile;
+
+typedef struct
+{
+    int startX, startY; // Ligne et colonne avant le mouvement
+    int endX, endY; // Après le mouvement
+    int movingPieceID; // Quel pièce est joué
+    int capturedPieceID; // Stocke la pièce mangé si y'en a une
+    bool isEnPassant;       // Est-ce un coup de prise en passant ?
+    int prevEnPassantX;     // Pour restaurer l'état du plateau dans UnmakeMove
+    int prevEnPassantY;     // Pour restaurer l'état du plateau dans UnmakeMove
+} Move;
+
+// Position : tout ce que les règles et la recherche doivent connaître
+typedef struct
+{
+    Tile tiles[BOARD_ROWS][BOARD_COLS];
+    int sideToMove; // 0 = Blancs, 1 = Noirs (changé par l'appelant après ApplyMove)
+    bool kingMoved[2]; // ROQUE : [0]=Blanc, [1]=Noir (mis à jour par les coups réels seulement)
+    bool rookMoved[2][2]; // Tours : [couleur][0=gauche, 1=droite]
+    int enPassantX; // Coordonnée X de la case "fantôme" attaquable (-1 si aucune)
+    int enPassantY; // Coordonnée Y de la case "fantôme" attaquable (-1 si aucune)
+    Move lastMove; // Stocke le dernier coup
+    int capturedByWhite[16]; // Liste des ID des pièces mangées par les Blancs
+    int capturedByWhiteCount; // Nombre de pièces mangées par les Blancs
+    int capturedByBlack[16]; // Liste des ID des pièces mangées par les Noirs
+    int capturedByBlackCount; // Nombre de pièces mangées par les Noirs
+    unsigned int version; // Incrémentée à chaque vrai changement (caches de l'interface)
+    int pieceCount; // Pièces sur le plateau, rois compris (bitbases : 3 pièces seulement)
+    NNUEAccumulator nnue; // Accumulateur du réseau d'évaluation (mis à jour par MakeMove/UnmakeMove)
+} Board;
+
+// RÈGLES (rules.c)
+void BoardReset(Board *board);                   // Position initiale, Blancs au trait
+bool BoardFromFEN(Board *board, const char *fen, int *sideToMove);
+int GetPieceColor(int pieceID);                  // 0 = Blanc, 1 = Noir, -1 = sol
+int GenerateLegalMoves(Board *board, Move movelist[], int playerColor);
+bool IsKingInCheck(const Board *board, int kingColor);
+void SimulateMove(Board *board, Move move);      // Joue un coup sans toucher à la partie réelle
+void UndoSimulatedMove(Board *board, Move move);
+void ApplyMove(Board *board, Move move, int promotionPieceID); // Coup réel (0 = promotion en Dame)
+void PromotePawn(Board *board, int x, int y, int pieceID);     // Remplace le pion promu
+uint64_t PositionKey(const Board *board, int sideToMove);      // Clé Zobrist de la position
+void MoveToString(Move move, char out[6]);       // Notation "e2e4"
+
+// Pilotage d'une recherche depuis un autre thread (UCI : stop, ponderhit). Les échéances
+// sont des instants Clock_NowNs() ; 0 = aucune.
+typedef struct
+{
+    atomic_bool stop;                      // Arrêt demandé : la recherche rend le coup de la dernière itération finie
+    atomic_uint_least64_t deadlineNs;      // Arrêt immédiat, même au milieu d'une itération
+    atomic_uint_least64_t softDeadlineNs;  // Aucune nouvelle itération après cet instant
+} SearchControl;
+
+// Limites d'une recherche (champs à 0 = pas de limite). La première itération va toujours au bout.
+typedef struct
+{
+    int depth;                  // Profondeur maximale (0 = SEARCH_MAX_DEPTH)
+    long nodes;                 // Noeuds maximum du thread principal
+    int threads;                // Threads de recherche (lazy SMP : table de transposition partagée), 1 par défaut
+    bool materialEval;          // Évaluation matérielle même si un réseau NNUE est chargé
+    bool noBitbases;            // Ignore les bitbases de finales
+    int multiPV;                // Variantes à garder (SearchStats.lines), 0 ou 1 = la meilleure seulement
+    SearchControl *control;     // Facultatif
+    void (*onIteration)(void *user); // Après chaque itération, sur le thread de la recherche (GetLastSearchStats)
+    void *user;
+} SearchLimits;
+
+// RECHERCHE (search.c)
+Move SearchPosition(Board *board, const SearchLimits *limits); // Approfondissement itératif pour le camp au trait
+Move FindBestMove(Board *board, int depth);      // SearchPosition à profondeur fixe, un seul thread
+Move ChooseMove(Board *board, int depth);        // Livre, puis mat forcé, puis FindBestMove
+Move ChooseMoveWithLimits(Board *board, const SearchLimits *limits); // Idem avec SearchPosition (arrêt possible)
+double MeasureSearchSpeed(double budgetMs);      // Noeuds/s de cette machine (recherche d'environ budgetMs)
+
+// Recherche par tranches, sans thread : la décision de ChooseMoveWithLimits (limits->threads ignoré)
+// découpée en appels de sliceMs depuis la boucle de jeu. Une seule à la fois, toujours sur le même
+// thread ; la position est copiée au départ. Step rend true avec le coup (GetLastSearchStats à jour).
+void SliceSearch_Start(const Board *board, const SearchLimits *limits); // limits->control doit rester valide
+bool SliceSearch_Step(double sliceMs, Move *bestMove);
+bool SliceSearch_IsActive(void);
+void SliceSearch_Abort(void);
+
+void SearchControl_Reset(SearchControl *control);  // Ni arrêt ni échéance
+void SearchControl_SetTime(SearchControl *control, double softMs, double hardMs); // Depuis maintenant, 0 = aucune
+void SearchControl_Stop(SearchControl *control);   // Utilisable depuis n'importe quel thread
+
+// Temps à consacrer au coup avec une pendule (ms) : échéance douce (pas de nouvelle itération)
+// et dure (arrêt immédiat), à passer à SearchControl_SetTime. movesToGo = 0 si inconnu.
+void AllocateMoveTime(double clockMs, double incMs, int movesToGo, double overheadMs, double *softMs, double *hardMs);
+
+#endif
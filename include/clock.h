@@ -0,0 +1,13 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+
+// Horloge monotone portable (QueryPerformanceCounter sous Windows, CLOCK_MONOTONIC ailleurs).
+// Indépendante de la fenêtre raylib : utilisable avant InitWindow et depuis n'importe quel thread.
+uint64_t Clock_NowNs(void);
+double Clock_Seconds(void);
+
+int Clock_CoreCount(void); // Coeurs logiques disponibles (outils parallèles), 1 si inconnu
+
+#endif
@@ -2,6 +2,10 @@
 #define GAME_H
 
 #include "raylib.h"
+#include "ailevel.h"
+#include "chesscore.h"
+#include "gameclock.h"
+#include "history.h"
 
 extern Sound gPieceSound;
 extern Sound gCheckSound;
@@ -10,22 +14,9 @@ extern Sound gEatingSound;
 extern Texture2D gMenuBackground;
 
 #define TILE_SIZE 32
-#define BOARD_COLS 8
-#define BOARD_ROWS 8
-#define MAX_LAYERS 4
-#define INFINITY 2000000
-#define INFINITY_SCORE 999999
-#define MAX_MOVES 256 // Augmenté pour la génération de coups
-#define BOARD_SIZE 8
 #define ID_IA 1 // ID du joueur IA (Noir)
 #define MAX_CAPTURED_PIECES 8 // 8 pions sont le maximum de pièces capturées du même type
 
-typedef struct
-{
-    int layers[MAX_LAYERS];     // indices dans gTileTextures
-    int layerCount;             // nombre de couches utilisées
-} Tile;
-
 typedef enum // Etat possible du jeu
 {
     STATE_MAIN_MENU, // Etat : sur le menu <- NOUVEL ÉTAT INITIAL
@@ -35,13 +26,6 @@ typedef enum // Etat possible du jeu
     STATE_GAMEOVER // Etat : Fin du jeu
 } GameState;
 
-typedef enum // Niveau de difficulté
-{
-    DIFF_EASY, // Depth = 1, Delay = 3s
-    DIFF_MEDIUM, // Depth = 3, Delay = 2s
-    DIFF_HARD // Depth = 5, Delay = 1s
-} AIDifficulty;
-
 typedef enum
 {
     MODE_NONE, // Aucun mode
@@ -56,47 +40,31 @@ typedef enum
     TURN_IA_MOVING
 } TurnState;
 
+// Partie affichée : la position (moteur, chesscore.h) et l'état de l'interface
 typedef struct
 {
-    int startX, startY; // Ligne et colonne avant le mouvement
-    int endX, endY; // Après le mouvement
-    int movingPieceID; // Quel pièce est joué
-    int capturedPieceID; // Stocke la pièce mangé si y'en a une    
-    bool isEnPassant;       // Est-ce un coup de prise en passant ?
-    int prevEnPassantX;     // Pour restaurer l'état du plateau dans UnmakeMove
-    int prevEnPassantY;     // Pour restaurer l'état du plateau dans UnmakeMove
-} Move;
-
-typedef struct 
-{
-    float whiteTime; // Temps restant pout les Blancs (en secondes)
-    float blackTime; // Temps restant pout les Noirs (en secondes)
-} Timer;
-
-typedef struct
-{
-    Tile tiles[BOARD_ROWS][BOARD_COLS];
-    Timer timer; 
+    Board board;
+    GameClock timer; // Pendules (débitées aux changements de trait, voir gameclock.h)
     GameState state;
     GameMode mode;
     int winner; // 0 = Blanc, 1 = Noir, -1 = Non-défini
-    Move move;
     float IADelay; // Délai avant que l'IA puisse jouer
     TurnState turnState;
     AIDifficulty difficulty; // Difficulté choisie
-    int AIDepth; // Profondeur AlphaBeta
     float AIDefaultDelay; // Délai par défaut
-    Move lastMove; // Stocke le dernier coup
-    int capturedByWhite[16]; // Liste des ID des pièces mangées par les Blancs
-    int capturedByWhiteCount; // Nombre de pièces mangées par les Blancs
-    int capturedByBlack[16]; // Liste des ID des pièces mangées par les Noirs
-    int capturedByBlackCount; // Nombre de pièces mangées par les Noirs
-    int enPassantX; // Coordonnée X de la case "fantôme" attaquable (-1 si aucune)
-    int enPassantY; // Coordonnée Y de la case "fantôme" attaquable (-1 si aucune)
-} Board;
+    GameHistory history; // Coups joués depuis le début (retour arrière, revue de la partie)
+    int viewPly; // Position affichée en revue (flèches), -1 = position en cours
+} Game;
 
-void GameInit(Board *board);
-void GameUpdate(Board *board, float dt);
-void GameDraw(Board *board);
+void GameInit(Game *game);
+void GameUpdate(Game *game, float dt);
+void GameDraw(Game *game);
+void GameUnload(void); // Libère les ressources graphiques créées par GameDraw
+void GameSetPondering(bool enabled); // Réflexion de l'IA pendant le tour du joueur (activée par défaut)
+void GameSetEngineSpeed(double nodesPerSecond); // Vitesse mesurée (MeasureSearchSpeed) : règle les budgets de l'IA
+void GameSetSearchSlice(double sliceMs); // > 0 : recherche de l'IA par tranches de sliceMs par image, sans thread
+void GameSetTimeControl(const GameClock *clock); // Cadence des parties contre l'IA (10 minutes par défaut)
+void GameSetFrameClock(bool enabled); // Pendules au temps des images (somme des dt) : rejeux déterministes
+double GameIdleSeconds(const Game *game); // Mode économe : secondes sans image nécessaire hors entrées (0 = images continues)
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,47 @@
+#ifndef GAMECLOCK_H
+#define GAMECLOCK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Pendule d'échecs : le temps n'est compté qu'aux changements de trait, à partir d'instants
+// monotones (Clock_NowNs), et non image par image. Le restant est gardé en nanosecondes : un coup
+// n'est pas arrondi à la milliseconde, et mille coups courts ne font pas gagner une seconde. Une image longue (recherche bloquante
+// de l'IA, fenêtre déplacée) est donc débitée une seule fois, au camp qui avait le trait.
+#define GAMECLOCK_NS_PER_MS 1000000LL
+
+typedef enum
+{
+    GAMECLOCK_FISCHER,   // Incrément ajouté après chaque coup (0 = K.O.)
+    GAMECLOCK_DELAY,     // Délai simple : les premières secondes de chaque coup ne sont pas débitées
+    GAMECLOCK_BRONSTEIN  // Temps du coup rendu, au plus l'incrément
+} GameClockMode;
+
+typedef struct
+{
+    GameClockMode mode;
+    int64_t baseMs;
+    int64_t incrementMs;      // Incrément ou délai selon le mode
+    int64_t remainingNs[2];   // Blancs, Noirs (à la fin du dernier coup de chacun)
+    int running;              // Camp dont la pendule tourne, -1 = arrêtée
+    uint64_t turnStartNs;     // Début du coup en cours
+} GameClock;
+
+void GameClock_Init(GameClock *clock, GameClockMode mode, int64_t baseMs, int64_t incrementMs);
+void GameClock_Start(GameClock *clock, int side, uint64_t nowNs); // Début du coup de 'side'
+void GameClock_Stop(GameClock *clock, uint64_t nowNs);            // Coup en cours débité sans incrément, pendule arrêtée
+void GameClock_Restart(GameClock *clock, int side, uint64_t nowNs); // Coup en cours débité sans incrément, puis 'side'
+bool GameClock_IsRunning(const GameClock *clock);
+
+// Coup joué par le camp dont la pendule tourne : débit (moins le délai), incrément, pendule adverse lancée
+void GameClock_Press(GameClock *clock, uint64_t nowNs);
+
+// Temps restant à l'instant nowNs (coup en cours compris), jamais négatif
+int64_t GameClock_RemainingMs(const GameClock *clock, int side, uint64_t nowNs);
+bool GameClock_Flagged(const GameClock *clock, int side, uint64_t nowNs);
+
+// "10", "3+2" (Fischer), "5d3" (délai), "5b3" (Bronstein) : minutes puis secondes ; false si invalide
+bool GameClock_Parse(GameClock *clock, const char *text);
+void GameClock_Describe(const GameClock *clock, char *out, int size); // Texte lisible : "3 min + 2 s"
+
+#endif
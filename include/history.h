@@ -0,0 +1,42 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include "chesscore.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Historique d'une partie : les coups sous forme compacte (3 octets) et, tous les
+// HISTORY_KEYFRAME_INTERVAL demi-coups, une copie complète de la position. N'importe quelle
+// position passée se reconstruit depuis la copie précédente en au plus INTERVAL - 1 coups
+// (ApplyMove : un coup réel ne se défait pas, UnmakeMove ne rend ni roques ni pièces mangées).
+#define HISTORY_MAX_PLIES 1024
+#define HISTORY_KEYFRAME_INTERVAL 16
+
+typedef struct
+{
+    uint8_t from;       // Case de départ (y * 8 + x)
+    uint8_t to;         // Case d'arrivée
+    uint8_t promotion;  // Pièce choisie (ID), 0 = Dame ou pas de promotion
+} HistoryMove;
+
+typedef struct
+{
+    HistoryMove moves[HISTORY_MAX_PLIES];
+    int count;      // Demi-coups enregistrés
+    bool full;      // Coups suivants perdus : la position réelle n'est plus reconstructible
+    Board keyframes[HISTORY_MAX_PLIES / HISTORY_KEYFRAME_INTERVAL + 1]; // [k] : après k * INTERVAL demi-coups
+} GameHistory;
+
+void History_Init(GameHistory *history, const Board *start);  // 'start' : position de départ, camp au trait compris
+
+// Coup réel qui vient d'être joué (promotionPieceID comme pour ApplyMove) ; false si l'historique est plein
+bool History_Push(GameHistory *history, Move move, int promotionPieceID);
+void History_Truncate(GameHistory *history, int ply);        // Oublie les coups à partir de 'ply'
+
+// Position après 'ply' demi-coups (0..count), camp au trait compris ; false hors limites
+bool History_Position(const GameHistory *history, int ply, Board *out);
+
+// Coup complet numéro 'ply' (pièce, prise, en passant), 'before' étant la position juste avant
+Move History_MoveAt(const GameHistory *history, int ply, const Board *before, int *promotionPieceID);
+
+#endif
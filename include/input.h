@@ -0,0 +1,45 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+// Entrées de l'interface : souris et clavier de raylib, ou rejoués depuis un script.
+// game.c ne lit plus raylib directement, ce qui permet de rejouer une partie sans fenêtre
+// (./build/game --replay, voir replay.c) et d'enregistrer une session réelle (--record).
+//
+// Format du script (texte, un évènement par ligne, '#' = commentaire) :
+//   size 800 600        taille d'écran utilisée pour les clics (avant le premier évènement)
+//   <image> click X Y   clic gauche en pixels
+//   <image> key CODE    touche pressée (code raylib, ex. 82 = KEY_R)
+//   <image> move e2e4   deux clics sur les cases (images N et N+1), promotion : e7e8 puis "key"
+// <image> est un numéro d'image absolu, ou "+N" pour N images après l'évènement précédent.
+
+#define INPUT_MAX_EVENTS 65536
+#define INPUT_MAX_KEYS_PER_FRAME 8
+
+// Passe en mode rejoué ; false si le fichier est illisible ou mal formé (message sur stderr)
+bool Input_LoadScript(const char *path);
+bool Input_IsScripted(void);
+bool Input_ScriptFinished(void);   // Tous les évènements ont été distribués
+long Input_ScriptLastFrame(void);  // Image du dernier évènement
+
+// Enregistre les entrées réelles au même format (mode direct seulement)
+bool Input_StartRecording(const char *path);
+void Input_StopRecording(void);
+
+// Une fois par image, avant GameUpdate
+void Input_BeginFrame(void);
+long Input_Frame(void);
+
+// Mode économe (main.c) : entrée réelle (clavier, souris, fenêtre) depuis le dernier
+// PollInputEvents ; ne vide pas la file des touches. Toujours true en mode rejoué.
+bool Input_HasActivity(void);
+
+bool Input_MouseLeftPressed(void);
+Vector2 Input_MousePosition(void);
+bool Input_KeyPressed(int key);
+int Input_ScreenWidth(void);
+int Input_ScreenHeight(void);
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef LEARN_H
+#define LEARN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Fichier d'apprentissage : les entrées profondes de la table de transposition et les
+// résultats des racines sont conservés d'une partie à l'autre dans un fichier projeté.
+// Taille fixe (en-tête + seaux de LEARN_BUCKET_SIZE entrées) : le fichier ne grossit jamais.
+#define LEARN_MAGIC "CHLF"
+#define LEARN_VERSION 2 // 2 : scores de promotion comptés depuis le noeud
+#define LEARN_BUCKET_SIZE 4
+#define LEARN_DEFAULT_MB 4
+#define LEARN_MIN_DEPTH 3 // Profondeur restante minimale pour mériter une place dans le fichier
+
+#define LEARN_FLAG_ROOT 1 // Résultat complet d'une recherche à la racine
+
+typedef struct
+{
+    char magic[4];
+    uint32_t version;
+    uint64_t slotCount;   // Nombre d'entrées (multiple de LEARN_BUCKET_SIZE, puissance de 2)
+    uint32_t generation;  // Incrémentée à chaque ouverture (une session = une génération)
+    uint32_t reserved[3];
+} LearnHeader;
+
+typedef struct
+{
+    uint64_t key;         // 0 = emplacement libre
+    int32_t score;        // Point de vue des Blancs
+    uint16_t move;        // Format TT_MOVE
+    int8_t depth;
+    uint8_t bound;        // TT_EXACT / TT_LOWER / TT_UPPER
+    uint16_t generation;  // Session de la dernière écriture
+    uint16_t flags;
+    uint32_t hits;        // Nombre de fois où l'entrée a servi
+} LearnEntry;
+
+bool Learn_Open(const char *path, int sizeMB);
+void Learn_Close(void);
+bool Learn_IsOpen(void);
+
+bool Learn_Probe(uint64_t key, LearnEntry *entry);
+void Learn_Store(uint64_t key, int depth, int score, int bound, uint16_t move, bool isRoot);
+
+// Recopie toutes les entrées du fichier dans la table de transposition, renvoie leur nombre
+long Learn_LoadIntoTT(void);
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef MAPFILE_H
+#define MAPFILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Fichier projeté en mémoire (mmap sous macOS/Linux, MapViewOfFile sous Windows)
+typedef struct
+{
+    void *data;         // Contenu du fichier (NULL si non ouvert), modifiable seulement en écriture
+    bool writable;      // Projection ouverte par MapFileOpenWritable
+    size_t size;        // Taille en octets
+    void *fileHandle;   // HANDLE Windows (inutilisé ailleurs)
+    void *mapHandle;    // HANDLE du mapping Windows (inutilisé ailleurs)
+} MappedFile;
+
+bool MapFileOpen(MappedFile *mf, const char *path); // Projection en lecture seule
+bool MapFileOpenWritable(MappedFile *mf, const char *path, size_t size); // Crée/agrandit le fichier à 'size' octets
+void MapFileFlush(MappedFile *mf); // Demande l'écriture sur disque (asynchrone)
+void MapFileClose(MappedFile *mf);
+
+#endif
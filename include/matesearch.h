@@ -0,0 +1,22 @@
+#ifndef MATESEARCH_H
+#define MATESEARCH_H
+
+#include "chesscore.h"
+
+#define MATE_MAX_DISTANCE 32 // Mat en 32 coups au plus
+#define MATE_MAX_LINE (2 * MATE_MAX_DISTANCE - 1)
+
+typedef struct
+{
+    bool found;                 // Mat forcé prouvé
+    int mateIn;                 // Nombre de coups de l'attaquant
+    int lineLength;             // Nombre de demi-coups dans 'line'
+    Move line[MATE_MAX_LINE];   // Variante forcée (défense la plus longue)
+    long nodes;                 // Nœuds créés dans l'arbre
+} MateResult;
+
+// Recherche par nombres de preuve (proof-number search) d'un mat par échecs successifs.
+// L'attaquant est le camp au trait ; maxNodes borne la mémoire utilisée.
+bool MateSearch(Board *board, int attackerColor, int maxMateDistance, long maxNodes, MateResult *result);
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef NNUE_H
+#define NNUE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Réseau "HalfKP" : (case du roi, pièce, case) pour les 10 pièces non-roi
+#define NNUE_KING_SQUARES 64
+#define NNUE_PIECE_TYPES 10
+#define NNUE_INPUTS (NNUE_KING_SQUARES * NNUE_PIECE_TYPES * 64)
+#define NNUE_HALF_DIMS 128 // Taille de l'accumulateur par perspective
+#define NNUE_L1 32
+#define NNUE_L2 32
+
+#define NNUE_MAGIC "NNUEPC01"
+#define NNUE_VERSION 1
+
+// Accumulateur : premières couches pré-calculées pour Blanc [0] et Noir [1]
+typedef struct
+{
+    int16_t values[2][NNUE_HALF_DIMS];
+    int kingSquare[2];  // Case du roi utilisée pour calculer chaque perspective
+    bool computed[2];   // false = à recalculer entièrement (roi déplacé, promotion...)
+} NNUEAccumulator;
+
+// Une pièce posée sur une case (square = y * 8 + x, pieceID = ID de texture)
+typedef struct
+{
+    int pieceID;
+    int square;
+} NNUEFeature;
+
+bool NNUE_Load(const char *path);  // Charge les poids (false si absent / invalide)
+void NNUE_Unload(void);
+bool NNUE_IsLoaded(void);
+
+// Recalcule les perspectives non valides à partir du plateau (pièce par case, 0 = vide)
+void NNUE_Refresh(NNUEAccumulator *acc, const int squares[64]);
+
+// Mise à jour incrémentale (appelée par MakeMove / UnmakeMove)
+void NNUE_ApplyChanges(NNUEAccumulator *acc,
+                       const NNUEFeature *removed, int removedCount,
+                       const NNUEFeature *added, int addedCount);
+
+// Score en centipions (positif = avantage Blanc), l'accumulateur doit être à jour
+int NNUE_Evaluate(const NNUEAccumulator *acc, int sideToMove);
+
+#endif
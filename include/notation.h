@@ -0,0 +1,13 @@
+#ifndef NOTATION_H
+#define NOTATION_H
+
+#include "chesscore.h"
+
+// Notation algébrique abrégée ("Nf3", "exd5", "O-O", "e8=Q+") -> coup légal du camp 'side'.
+// promotionPieceID reçoit l'ID de la pièce de promotion (0 si aucune).
+bool ParseSAN(Board *board, int side, const char *san, Move *move, int *promotionPieceID);
+
+// Coup légal -> notation algébrique abrégée, avec "+" ou "#" (promotionPieceID : 0 = Dame)
+void MoveToSAN(Board *board, Move move, int promotionPieceID, char out[16]);
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef PONDER_H
+#define PONDER_H
+
+#include "chesscore.h"
+#include <stdbool.h>
+
+// Réflexion pendant le temps de l'adversaire : après son coup, l'IA suppose la réponse prévue
+// par sa variante principale et cherche déjà la position qui en résulte, sur un thread à part.
+// - coup attendu : la recherche continue et son coup est joué dès qu'elle est finie
+// - autre coup : la recherche est arrêtée ; la table de transposition reste chaude
+// Toutes les fonctions s'appellent depuis le même thread (celui du jeu).
+#define PONDER_THREAD_STACK (8 * 1024 * 1024) // Comme les threads de SearchPosition
+
+// 'board' : position après le coup de l'IA, adversaire au trait. 'reply' : réponse attendue
+// (startX = -1 : celle de la table de transposition). 'limits' : ceux de la recherche normale,
+// sans leur SearchControl (le temps passé ici est celui de l'adversaire : aucune échéance).
+// false si la réponse n'est pas légale ou si la partie s'arrête là (aucune recherche lancée).
+bool Ponder_Start(const Board *board, Move reply, const SearchLimits *limits);
+bool Ponder_IsActive(void);
+
+// Position réelle (IA au trait) : est-ce celle qui est cherchée ?
+bool Ponder_Matches(const Board *board);
+
+// Recherche terminée : coup choisi et statistiques reprises par le thread appelant
+// (GetLastSearchStats). false tant qu'elle tourne encore.
+bool Ponder_Result(Move *bestMove);
+
+// Arrête la recherche en cours (au plus une itération de profondeur 1) ; sans effet sinon
+void Ponder_Stop(void);
+
+#endif
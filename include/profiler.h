@@ -0,0 +1,39 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Profileur d'images : zones chronométrées, temps d'image et export au format Chrome trace
+// (chrome://tracing, Perfetto). Compiler avec -DPROF_DISABLED retire toutes les zones.
+#define PROF_MAX_EVENTS 65536   // Zones gardées en mémoire (tampon circulaire)
+#define PROF_MAX_FRAMES 600     // Temps d'image gardés (10 s à 60 i/s)
+#define PROF_TRACE_SECONDS 10.0 // Durée exportée par Prof_WriteChromeTrace
+
+#ifndef PROF_DISABLED
+    #define PROF_BEGIN(zone) uint64_t profStart_##zone = Prof_Begin()
+    #define PROF_END(zone) Prof_End(#zone, profStart_##zone)
+#else
+    #define PROF_BEGIN(zone) ((void)0)
+    #define PROF_END(zone) ((void)0)
+#endif
+
+typedef struct
+{
+    const char *name;
+    int calls;
+    double totalMs;
+    double maxMs;
+} ProfZoneStat;
+
+uint64_t Prof_Begin(void);
+void Prof_End(const char *name, uint64_t startNs); // 'name' doit rester valide (chaîne littérale)
+void Prof_FrameMark(void); // À appeler une fois par image, après EndDrawing
+
+int Prof_FrameTimes(float *outMs, int max); // Les plus anciens d'abord
+bool Prof_FramePercentiles(float *p50, float *p95, float *p99, float *maxMs);
+int Prof_ZoneSummary(ProfZoneStat *out, int max, double windowSeconds); // Zones des dernières secondes
+
+bool Prof_WriteChromeTrace(const char *path, double lastSeconds);
+
+#endif
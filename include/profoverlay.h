@@ -0,0 +1,7 @@
+#ifndef PROFOVERLAY_H
+#define PROFOVERLAY_H
+
+// Panneau du profileur (F3) : graphe des temps d'image, percentiles et zones de la dernière seconde
+void ProfOverlay_Draw(void);
+
+#endif
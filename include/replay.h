@@ -0,0 +1,24 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdbool.h>
+
+// Rejeu d'un script d'entrées (input.h) à travers le vrai GameUpdate, sans fenêtre par défaut :
+// ./build/game --replay <script> [--draw] [--frames N] [--csv fichier] [--prof fichier.json]
+// Affiche le temps par image (moyenne, p50, p95, p99, max) de GameUpdate et, avec --draw, de GameDraw.
+#define REPLAY_DT (1.0f / 60.0f)   // Pas de temps fixe : le rejeu est déterministe
+#define REPLAY_TAIL_FRAMES 600     // Images jouées après le dernier évènement (réponse de l'IA)
+
+typedef struct
+{
+    const char *scriptPath;
+    const char *csvPath;   // Une ligne par image (facultatif)
+    const char *profPath;  // Zones du profileur au format Chrome trace (facultatif)
+    bool draw;             // Fenêtre cachée : chronomètre aussi GameDraw (nécessite un affichage)
+    long maxFrames;        // 0 = dernier évènement + REPLAY_TAIL_FRAMES
+} ReplayOptions;
+
+// Le moteur (TT, livre, bitbases...) doit déjà être initialisé. Renvoie le code de sortie du programme.
+int Replay_Run(const ReplayOptions *options);
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+
+#include "chesscore.h"
+#include <stdbool.h>
+
+// Statistiques de recherche de l'IA, remplies par SearchPosition à chaque itération
+#define SEARCH_MAX_DEPTH 32
+#define SEARCH_MAX_PV 32
+#define SEARCH_MAX_LINES 8 // Variantes gardées par SearchLimits.multiPV
+
+typedef enum
+{
+    SEARCH_SOURCE_NONE,
+    SEARCH_SOURCE_SEARCH,  // AlphaBeta (approfondissement itératif)
+    SEARCH_SOURCE_BOOK,    // Livre d'ouverture
+    SEARCH_SOURCE_MATE,    // Solveur de mat
+    SEARCH_SOURCE_LEARN    // Fichier d'apprentissage
+} SearchSource;
+
+typedef struct
+{
+    int depth;
+    long nodes;            // Noeuds visités par AlphaBeta (racine exclue)
+    long leafNodes;        // Noeuds évalués à profondeur 0
+    long betaCutoffs;      // Coupures alpha-beta
+    long firstMoveCutoffs; // ... obtenues dès le premier coup essayé (qualité du tri)
+    long ttProbes;
+    long ttHits;
+    long ttCutoffs;        // Noeuds résolus directement par la table de transposition
+    double timeMs;         // Durée de cette itération
+    double nps;            // Noeuds par seconde
+    double branchingFactor; // Facteur de branchement effectif (noeuds / noeuds de l'itération précédente)
+    int score;             // Point de vue des Blancs
+    Move bestMove;
+    int pvLength;
+    Move pv[SEARCH_MAX_PV]; // Variante principale
+} SearchIteration;
+
+// Une des meilleures variantes de la racine (multi-PV)
+typedef struct
+{
+    int score;             // Point de vue des Blancs
+    int pvLength;
+    Move pv[SEARCH_MAX_PV];
+} SearchLine;
+
+typedef struct
+{
+    SearchSource source;
+    int side;              // Camp de l'IA
+    int requestedDepth;
+    int iterationCount;
+    SearchIteration iterations[SEARCH_MAX_DEPTH];
+    long totalNodes;
+    double totalMs;
+    Move bestMove;
+    int score;
+    int lineCount;         // Multi-PV : meilleures variantes de la dernière itération, la meilleure d'abord
+    SearchLine lines[SEARCH_MAX_LINES];
+} SearchStats;
+
+// Dernière décision de l'IA prise sur le thread appelant (statistiques vides avant le premier coup)
+const SearchStats *GetLastSearchStats(void);
+void SetLastSearchStats(const SearchStats *stats); // Reprend les statistiques d'une recherche faite sur un autre thread
+
+// Journal facultatif : une ligne par itération (.csv) ou un objet JSON par recherche (.jsonl)
+bool SearchLog_Open(const char *path);
+void SearchLog_Write(const SearchStats *stats);
+void SearchLog_Close(void);
+
+const char *SearchSourceName(SearchSource source);
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef SEARCHTRACE_H
+#define SEARCHTRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Trace binaire de l'arbre AlphaBeta, pour l'analyse hors ligne (tools/tracestat.c).
+// N'existe que dans les versions compilées avec -DSEARCH_TRACE (make TRACE=1) :
+// sinon toutes les macros TRACE_* sont vides et la recherche ne paie rien.
+#define TRACE_MAGIC "CHST"
+#define TRACE_VERSION 1
+
+// Types d'enregistrement
+#define TRACE_SEARCH_BEGIN 1 // depth = profondeur demandée, info = camp
+#define TRACE_ITERATION 2    // depth = profondeur de l'itération
+#define TRACE_ENTER 3        // move = coup joué pour arriver ici, a/b = fenêtre, info = camp au trait
+#define TRACE_EXIT 4         // a = score, b = coups essayés, extra = indice de coupure, info = raison
+
+// Raison de sortie d'un noeud
+#define TRACE_EXIT_SEARCHED 0 // Tous les coups (ou jusqu'à la coupure) parcourus
+#define TRACE_EXIT_LEAF 1     // Profondeur 0 : évaluation
+#define TRACE_EXIT_TT 2       // Résolu par la table de transposition
+#define TRACE_EXIT_BITBASE 3  // Finale nulle, ou gagnée avec un pion promu, d'après les bitbases
+#define TRACE_EXIT_MATE 4     // Mat ou pat
+
+#define TRACE_NO_CUTOFF 0xFFFF
+
+typedef struct
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t reserved;
+} TraceHeader;
+
+typedef struct
+{
+    uint8_t type;
+    uint8_t ply;
+    int8_t depth;     // Profondeur restante
+    uint8_t info;
+    uint16_t move;    // Format TT_MOVE
+    uint16_t extra;
+    int32_t a;
+    int32_t b;
+    uint32_t timeUs;  // Depuis le début de la recherche
+} TraceRecord;
+
+#ifdef SEARCH_TRACE
+
+bool SearchTrace_Open(const char *path);
+void SearchTrace_Close(void);
+void SearchTrace_Begin(int depth, int side);
+void SearchTrace_Iteration(int depth);
+void SearchTrace_Enter(int ply, int depth, int alpha, int beta, int side);
+void SearchTrace_Exit(int ply, int depth, int score);
+
+// État du noeud courant, indexé par ply (lu puis remis à zéro par SearchTrace_Exit)
+void SearchTrace_SetMove(int ply, uint16_t move);
+void SearchTrace_SetNodeInfo(int ply, int reason, int cutoffIndex, int moveCount);
+
+    #define TRACE_BEGIN(depth, side) SearchTrace_Begin(depth, side)
+    #define TRACE_ITERATION_BEGIN(depth) SearchTrace_Iteration(depth)
+    #define TRACE_MOVE(ply, m) SearchTrace_SetMove(ply, TT_MOVE((m).startX, (m).startY, (m).endX, (m).endY))
+    #define TRACE_NODE(ply, reason, cutoffIndex, moveCount) SearchTrace_SetNodeInfo(ply, reason, cutoffIndex, moveCount)
+#else
+    #define TRACE_BEGIN(depth, side) ((void)0)
+    #define TRACE_ITERATION_BEGIN(depth) ((void)0)
+    #define TRACE_MOVE(ply, m) ((void)0)
+    #define TRACE_NODE(ply, reason, cutoffIndex, moveCount) ((void)0)
+#endif
+
+#endif
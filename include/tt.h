@@ -0,0 +1,53 @@
+#ifndef TT_H
+#define TT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Table de transposition : positions déjà évaluées, indexées par clé Zobrist
+#define TT_DEFAULT_MB 16
+#define TT_BUCKET_SIZE 4
+
+// Type de borne du score stocké (scores toujours du point de vue des Blancs)
+#define TT_EXACT 0
+#define TT_LOWER 1 // Score réel >= score stocké (coupure beta)
+#define TT_UPPER 2 // Score réel <= score stocké (aucun coup n'a dépassé alpha)
+
+// Coup compressé : case de départ (6 bits) puis case d'arrivée (6 bits), 0 = aucun
+#define TT_MOVE(sx, sy, ex, ey) (uint16_t)((((sy) * 8 + (sx)) << 6) | ((ey) * 8 + (ex)))
+#define TT_MOVE_NONE 0
+#define TT_MOVE_START_X(m) ((((m) >> 6) & 63) % 8)
+#define TT_MOVE_START_Y(m) ((((m) >> 6) & 63) / 8)
+#define TT_MOVE_END_X(m) (((m) & 63) % 8)
+#define TT_MOVE_END_Y(m) (((m) & 63) / 8)
+
+typedef struct
+{
+    uint64_t key;
+    int32_t score;
+    uint16_t move;
+    int8_t depth;
+    uint8_t boundAge; // Bits 0-1 : borne, bits 2-7 : âge de la recherche
+} TTEntry;
+
+bool TT_Init(int sizeMB);   // (Ré)alloue et vide la table globale
+void TT_Free(void);
+
+// Tables supplémentaires : une par thread de build/selfplay et build/analyze.
+// TT_Bind choisit la table du thread appelant (NULL = table globale) ; les fonctions
+// ci-dessous agissent toujours sur la table du thread.
+typedef struct TTable TTable;
+TTable *TT_Create(int sizeMB);
+void TT_Destroy(TTable *table);
+void TT_Bind(TTable *table);
+TTable *TT_Current(void);
+
+void TT_Clear(void);
+void TT_NewSearch(void);    // Vieillit les entrées existantes
+
+bool TT_Probe(uint64_t key, TTEntry *entry);
+void TT_Store(uint64_t key, int depth, int score, int bound, uint16_t move);
+
+static inline int TT_Bound(const TTEntry *e) { return e->boundAge & 3; }
+
+#endif
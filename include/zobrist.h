@@ -0,0 +1,14 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <stdint.h>
+
+// Clés aléatoires de hachage (Zobrist), identiques à chaque lancement (graine fixe)
+extern uint64_t gZobristPiece[14][64];  // [ID de pièce][case]
+extern uint64_t gZobristCastling[4];    // Roques Blanc côté roi/dame, Noir côté roi/dame
+extern uint64_t gZobristEnPassant[8];   // Colonne de la case en passant
+extern uint64_t gZobristSide;           // Noirs au trait
+
+void Zobrist_Init(void);
+
+#endif
@@ -0,0 +1,36 @@
+#include "ailevel.h"
+#include <stddef.h>
+
+static const AILevel AI_LEVELS[] = {
+    [DIFF_EASY]   = { 100.0, 300.0, 5, 4, 150 },
+    [DIFF_MEDIUM] = { 400.0, 1000.0, 6, 2, 30 },
+    [DIFF_HARD]   = { 1500.0, 3000.0, 8, 1, 0 },
+};
+
+const AILevel *AILevel_Get(AIDifficulty difficulty)
+{
+    return &AI_LEVELS[difficulty];
+}
+
+long AILevel_Nodes(AIDifficulty difficulty, double engineNps)
+{
+    long nodes = (long)(engineNps * AI_LEVELS[difficulty].targetMs / 1000.0);
+    return (nodes > AI_MIN_NODES) ? nodes : AI_MIN_NODES;
+}
+
+SearchLimits AILevel_Limits(AIDifficulty difficulty, long nodes, SearchControl *control)
+{
+    const AILevel *level = &AI_LEVELS[difficulty];
+    SearchLimits limits = { 0 };
+    limits.depth = level->depth;
+    limits.nodes = nodes;
+    limits.threads = 1;
+    limits.multiPV = level->lines;
+    if (control != NULL)
+    {
+        SearchControl_Reset(control);
+        SearchControl_SetTime(control, 0.0, level->capMs);
+        limits.control = control;
+    }
+    return limits;
+}
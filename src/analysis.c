@@ -0,0 +1,189 @@
+#include "analysis.h"
+#include "notation.h"
+#include "searchstats.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+// Tout l'état partagé est protégé par gLock ; la recherche elle-même tourne verrou relâché
+static pthread_mutex_t gLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t gWake = PTHREAD_COND_INITIALIZER;
+static pthread_t gThread;
+static bool gRunning = false;
+static bool gQuit = false;
+static bool gHasPosition = false;   // Position déposée, pas encore prise par le thread
+static Board gPending;
+static unsigned int gPendingId = 0;
+static unsigned int gCurrentId = 0; // Position dont les résultats sont publiés
+static AnalysisInfo gInfo;
+static SearchControl gControl;
+
+#ifndef SEARCH_TRACE // Pas de thread d'analyse avec la trace (voir Analysis_Start)
+static int gThreads = 1;
+static int gLineCount = ANALYSIS_MAX_LINES;
+
+// Position en cours d'analyse (thread d'analyse seulement)
+static Board gRoot;
+static unsigned int gRootId = 0;
+
+// Variante -> texte "Nf3 d5 c4 ..." rejoué sur une copie de la position
+static void LineText(const SearchLine *line, char out[ANALYSIS_LINE_TEXT])
+{
+    static Board played;
+    played = gRoot;
+    int length = 0;
+    out[0] = '\0';
+    for (int i = 0; i < line->pvLength && length < ANALYSIS_LINE_TEXT - 16; i++)
+    {
+        char san[16];
+        MoveToSAN(&played, line->pv[i], 0, san);
+        length += snprintf(out + length, (size_t)(ANALYSIS_LINE_TEXT - length), (i == 0) ? "%s" : " %s", san);
+        ApplyMove(&played, line->pv[i], 0);
+        played.sideToMove = 1 - played.sideToMove;
+    }
+}
+
+// Après chaque itération (thread d'analyse) : publie les variantes si la position n'a pas changé
+static void Publish(void *user)
+{
+    (void)user;
+    const SearchStats *stats = GetLastSearchStats();
+    if (stats->iterationCount == 0) return;
+    const SearchIteration *it = &stats->iterations[stats->iterationCount - 1];
+
+    AnalysisInfo info = { 0 };
+    info.positionId = gRootId;
+    info.depth = it->depth;
+    info.nodes = stats->totalNodes;
+    double ms = 0.0;
+    for (int i = 0; i < stats->iterationCount; i++) ms += stats->iterations[i].timeMs;
+    info.nps = (ms > 0.0) ? stats->totalNodes * 1000.0 / ms : 0.0;
+
+    // Une seule variante demandée (ou un seul coup légal) : celle de l'itération
+    SearchLine single;
+    const SearchLine *lines = stats->lines;
+    int count = stats->lineCount;
+    if (count == 0)
+    {
+        single.score = it->score;
+        single.pvLength = it->pvLength;
+        memcpy(single.pv, it->pv, sizeof(Move) * (size_t)it->pvLength);
+        lines = &single;
+        count = 1;
+    }
+    for (int i = 0; i < count && i < ANALYSIS_MAX_LINES; i++)
+    {
+        info.lines[i].score = lines[i].score;
+        info.lines[i].move = lines[i].pv[0];
+        LineText(&lines[i], info.lines[i].text);
+        info.lineCount++;
+    }
+
+    pthread_mutex_lock(&gLock);
+    if (gCurrentId == gRootId) gInfo = info;
+    pthread_mutex_unlock(&gLock);
+}
+
+static void *AnalysisMain(void *arg)
+{
+    (void)arg;
+    pthread_mutex_lock(&gLock);
+    for (;;)
+    {
+        while (!gQuit && !gHasPosition) pthread_cond_wait(&gWake, &gLock);
+        if (gQuit) break;
+
+        gRoot = gPending;
+        gRootId = gPendingId;
+        gHasPosition = false;
+        SearchControl_Reset(&gControl);
+        pthread_mutex_unlock(&gLock);
+
+        // Recherche sans limite de profondeur utile : elle s'arrête au prochain coup
+        Move moves[MAX_MOVES];
+        if (GenerateLegalMoves(&gRoot, moves, gRoot.sideToMove) > 0)
+        {
+            static Board board;
+            board = gRoot;
+            SearchLimits limits = { 0 };
+            limits.threads = gThreads;
+            limits.multiPV = gLineCount;
+            limits.control = &gControl;
+            limits.onIteration = Publish;
+            SearchPosition(&board, &limits);
+        }
+
+        pthread_mutex_lock(&gLock);
+    }
+    pthread_mutex_unlock(&gLock);
+    return NULL;
+}
+#endif
+
+bool Analysis_Start(int threads, int lineCount)
+{
+    if (gRunning) return true;
+#ifdef SEARCH_TRACE
+    // La trace de recherche n'enregistre qu'un seul thread
+    (void)threads;
+    (void)lineCount;
+    return false;
+#else
+    gThreads = (threads > 1) ? threads : 1;
+    gLineCount = (lineCount > 0 && lineCount <= ANALYSIS_MAX_LINES) ? lineCount : ANALYSIS_MAX_LINES;
+    gQuit = false;
+    gHasPosition = false;
+    memset(&gInfo, 0, sizeof(gInfo));
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, ANALYSIS_THREAD_STACK);
+    gRunning = (pthread_create(&gThread, &attr, AnalysisMain, NULL) == 0);
+    pthread_attr_destroy(&attr);
+    return gRunning;
+#endif
+}
+
+bool Analysis_IsRunning(void)
+{
+    return gRunning;
+}
+
+void Analysis_SetPosition(const Board *board, unsigned int positionId)
+{
+    if (!gRunning) return;
+
+    pthread_mutex_lock(&gLock);
+    gPending = *board;
+    gPendingId = positionId;
+    gCurrentId = positionId;
+    gHasPosition = true;
+    memset(&gInfo, 0, sizeof(gInfo));
+    gInfo.positionId = positionId;
+    SearchControl_Stop(&gControl);
+    pthread_cond_signal(&gWake);
+    pthread_mutex_unlock(&gLock);
+}
+
+bool Analysis_GetInfo(AnalysisInfo *info)
+{
+    if (!gRunning) return false;
+
+    pthread_mutex_lock(&gLock);
+    *info = gInfo;
+    pthread_mutex_unlock(&gLock);
+    return info->depth > 0;
+}
+
+void Analysis_Stop(void)
+{
+    if (!gRunning) return;
+
+    pthread_mutex_lock(&gLock);
+    gQuit = true;
+    SearchControl_Stop(&gControl);
+    pthread_cond_signal(&gWake);
+    pthread_mutex_unlock(&gLock);
+    pthread_join(gThread, NULL);
+    gRunning = false;
+}
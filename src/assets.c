@@ -0,0 +1,398 @@
+#include "assets.h"
+#include "mapfile.h"
+#include "profiler.h"
+#include "raylib.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+// Globales définies dans main.c
+extern Texture2D gSpriteAtlas;
+extern Rectangle gSpriteRects[];
+extern int gTileTextureCount;
+extern Texture2D gMenuBackground;
+extern Sound gPieceSound;
+extern Sound gCheckSound;
+extern Sound gEatingSound;
+
+#define ATLAS_CELL 130 // Sprites jusqu'à 128 x 128 + 1 pixel de marge de chaque côté
+#define ATLAS_COLUMNS 4
+#define SPRITE_COUNT 14
+#define ATLAS_WHITE_RECT SPRITE_COUNT // Rectangle du carré blanc, rangé après les sprites
+
+// Ordre = ID utilisés dans Tile.layers
+static const char *SPRITE_PATHS[SPRITE_COUNT] = {
+    "assets/carreau_blanc.png",
+    "assets/carreau_noir.png",
+    "assets/cavalier_blanc.png",
+    "assets/cavalier_noir.png",
+    "assets/fou_blanc.png",
+    "assets/fou_noir.png",
+    "assets/pion_blanc.png",
+    "assets/pion_noir.png",
+    "assets/reine_blanche.png",
+    "assets/reine_noir.png",
+    "assets/roi_blanc.png",
+    "assets/roi_noir.png",
+    "assets/tour_blanche.png",
+    "assets/tour_noir.png",
+};
+
+typedef enum
+{
+    ITEM_ATLAS,
+    ITEM_BACKGROUND,
+    ITEM_PIECE_SOUND,
+    ITEM_CHECK_SOUND,
+    ITEM_EATING_SOUND,
+    ITEM_COUNT
+} AssetItem;
+
+// Nom dans le paquet et fichier d'origine de chaque élément
+static const struct
+{
+    const char *name;
+    const char *path;
+    float volume;
+} ITEMS[ITEM_COUNT] = {
+    { "atlas", NULL, 0.0f },
+    { "fond_bois", "assets/fond_bois.jpg", 0.0f },
+    { "piece_sound", "assets/piece_sound.mp3", 2.0f },
+    { "echec_sound", "assets/echec_sound.mp3", 1.5f },
+    { "eating_sound", "assets/eating_sound.mp3", 1.5f },
+};
+
+typedef struct
+{
+    Image image;
+    Wave wave;
+    bool ownsData;      // false : les données pointent dans le paquet projeté
+    atomic_bool ready;  // Écrit par le thread de travail, lu par le thread principal
+    bool uploaded;
+} LoadedAsset;
+
+static LoadedAsset gItems[ITEM_COUNT];
+static Rectangle gAtlasRects[SPRITE_COUNT + 1];
+static MappedFile gBundle = { 0 };
+static pthread_t gWorker;
+static bool gWorkerRunning = false;
+static int gUploadedCount = 0;
+
+// DÉCODAGE (thread de travail ou outil --pack)
+
+// Assemble les sprites dans une seule image ; le dernier rectangle est un carré blanc
+// utilisé pour les formes (SetShapesTexture), pour dessiner tout le plateau sans changer de texture
+static Image ComposeSpriteAtlas(Rectangle rects[SPRITE_COUNT + 1])
+{
+    int rows = (SPRITE_COUNT + 1 + ATLAS_COLUMNS - 1) / ATLAS_COLUMNS;
+    Image atlas = GenImageColor(ATLAS_COLUMNS * ATLAS_CELL, rows * ATLAS_CELL, BLANK);
+
+    for (int i = 0; i < SPRITE_COUNT; i++)
+    {
+        int cellX = (i % ATLAS_COLUMNS) * ATLAS_CELL + 1;
+        int cellY = (i / ATLAS_COLUMNS) * ATLAS_CELL + 1;
+
+        Image sprite = LoadImage(SPRITE_PATHS[i]);
+        if (sprite.data == NULL)
+        {
+            rects[i] = (Rectangle){ 0, 0, 0, 0 };
+            continue;
+        }
+        // Les sprites trop grands sont réduits pour tenir dans leur cellule
+        if (sprite.width > ATLAS_CELL - 2 || sprite.height > ATLAS_CELL - 2)
+        {
+            ImageResize(&sprite, ATLAS_CELL - 2, ATLAS_CELL - 2);
+        }
+        ImageDraw(&atlas, sprite, (Rectangle){ 0, 0, (float)sprite.width, (float)sprite.height },
+            (Rectangle){ (float)cellX, (float)cellY, (float)sprite.width, (float)sprite.height }, WHITE);
+        rects[i] = (Rectangle){ (float)cellX, (float)cellY, (float)sprite.width, (float)sprite.height };
+        UnloadImage(sprite);
+    }
+
+    int whiteX = (SPRITE_COUNT % ATLAS_COLUMNS) * ATLAS_CELL;
+    int whiteY = (SPRITE_COUNT / ATLAS_COLUMNS) * ATLAS_CELL;
+    ImageDrawRectangle(&atlas, whiteX, whiteY, 8, 8, WHITE);
+    rects[ATLAS_WHITE_RECT] = (Rectangle){ (float)whiteX + 2, (float)whiteY + 2, 4, 4 }; // Centre du carré : pas de bords
+    return atlas;
+}
+
+// Décode un élément depuis les fichiers d'origine
+static void DecodeItem(int item, LoadedAsset *out)
+{
+    out->ownsData = true;
+    if (item == ITEM_ATLAS) out->image = ComposeSpriteAtlas(gAtlasRects);
+    else if (item == ITEM_BACKGROUND) out->image = LoadImage(ITEMS[item].path);
+    else out->wave = LoadWave(ITEMS[item].path);
+}
+
+static const BundleEntry *FindEntry(const char *name)
+{
+    const BundleHeader *header = gBundle.data;
+    const BundleEntry *entries = (const BundleEntry *)(header + 1);
+    for (uint32_t i = 0; i < header->entryCount; i++)
+    {
+        if (strncmp(entries[i].name, name, sizeof(entries[i].name)) == 0) return &entries[i];
+    }
+    return NULL;
+}
+
+// Lit un élément du paquet sans copie ; les pages sont touchées ici pour que
+// l'envoi au GPU sur le thread principal ne bloque pas sur le disque
+static bool MapItem(int item, LoadedAsset *out)
+{
+    const BundleEntry *e = FindEntry(ITEMS[item].name);
+    if (e == NULL || e->offset + e->size > gBundle.size) return false;
+
+    uint8_t *data = (uint8_t *)gBundle.data + e->offset;
+    volatile uint8_t sink = 0;
+    for (uint64_t i = 0; i < e->size; i += 4096) sink ^= data[i];
+    (void)sink;
+
+    out->ownsData = false;
+    if (e->kind == BUNDLE_KIND_IMAGE)
+    {
+        out->image = (Image){ data, e->a, e->b, e->d, e->c };
+    }
+    else if (e->kind == BUNDLE_KIND_WAVE)
+    {
+        out->wave = (Wave){ (unsigned int)e->a, (unsigned int)e->b, (unsigned int)e->c, (unsigned int)e->d, data };
+    }
+    else return false;
+
+    if (item == ITEM_ATLAS)
+    {
+        const BundleEntry *r = FindEntry("atlas_rects");
+        if (r == NULL || r->size != sizeof(gAtlasRects) || r->offset + r->size > gBundle.size) return false;
+        memcpy(gAtlasRects, (uint8_t *)gBundle.data + r->offset, sizeof(gAtlasRects));
+    }
+    return true;
+}
+
+static void *LoadWorker(void *arg)
+{
+    (void)arg;
+    for (int i = 0; i < ITEM_COUNT; i++)
+    {
+        PROF_BEGIN(LoadAsset);
+        if (gBundle.data == NULL || !MapItem(i, &gItems[i])) DecodeItem(i, &gItems[i]);
+        PROF_END(LoadAsset);
+        atomic_store_explicit(&gItems[i].ready, true, memory_order_release);
+    }
+    return NULL;
+}
+
+bool Assets_StartLoading(const char *bundlePath)
+{
+    for (int i = 0; i < ITEM_COUNT; i++)
+    {
+        gItems[i] = (LoadedAsset){ 0 };
+        atomic_init(&gItems[i].ready, false);
+    }
+    gUploadedCount = 0;
+
+    // Paquet facultatif : sans lui, on décode les fichiers d'origine (plus lent)
+    if (MapFileOpen(&gBundle, bundlePath))
+    {
+        const BundleHeader *header = gBundle.data;
+        if (gBundle.size < sizeof(BundleHeader) || memcmp(header->magic, BUNDLE_MAGIC, 4) != 0
+            || header->version != BUNDLE_VERSION
+            || sizeof(BundleHeader) + header->entryCount * sizeof(BundleEntry) > gBundle.size)
+        {
+            TraceLog(LOG_WARNING, "Paquet d'assets invalide (%s), chargement des fichiers d'origine", bundlePath);
+            MapFileClose(&gBundle);
+        }
+    }
+
+    gWorkerRunning = (pthread_create(&gWorker, NULL, LoadWorker, NULL) == 0);
+    if (!gWorkerRunning)
+    {
+        LoadWorker(NULL); // Pas de thread disponible : chargement bloquant
+    }
+    return gBundle.data != NULL;
+}
+
+// ENVOI (thread principal : OpenGL et audio)
+
+static void UploadItem(int item, LoadedAsset *asset)
+{
+    if (item == ITEM_ATLAS)
+    {
+        gSpriteAtlas = LoadTextureFromImage(asset->image);
+        memcpy(gSpriteRects, gAtlasRects, sizeof(Rectangle) * SPRITE_COUNT);
+        gTileTextureCount = SPRITE_COUNT;
+        SetShapesTexture(gSpriteAtlas, gAtlasRects[ATLAS_WHITE_RECT]);
+    }
+    else if (item == ITEM_BACKGROUND)
+    {
+        gMenuBackground = LoadTextureFromImage(asset->image);
+    }
+    else
+    {
+        Sound sound = LoadSoundFromWave(asset->wave);
+        SetSoundVolume(sound, ITEMS[item].volume);
+        if (item == ITEM_PIECE_SOUND) gPieceSound = sound;
+        else if (item == ITEM_CHECK_SOUND) gCheckSound = sound;
+        else gEatingSound = sound;
+    }
+
+    if (asset->ownsData)
+    {
+        if (item == ITEM_ATLAS || item == ITEM_BACKGROUND) UnloadImage(asset->image);
+        else UnloadWave(asset->wave);
+    }
+    asset->uploaded = true;
+    gUploadedCount++;
+}
+
+bool Assets_Update(void)
+{
+    if (gUploadedCount == ITEM_COUNT) return true;
+
+    for (int i = 0; i < ITEM_COUNT; i++)
+    {
+        if (!gItems[i].uploaded && atomic_load_explicit(&gItems[i].ready, memory_order_acquire))
+        {
+            PROF_BEGIN(UploadAsset);
+            UploadItem(i, &gItems[i]);
+            PROF_END(UploadAsset);
+        }
+    }
+
+    if (gUploadedCount < ITEM_COUNT) return false;
+
+    // Tout est sur le GPU / dans l'audio : le paquet n'est plus nécessaire
+    if (gWorkerRunning) pthread_join(gWorker, NULL);
+    gWorkerRunning = false;
+    MapFileClose(&gBundle);
+    return true;
+}
+
+float Assets_Progress(void)
+{
+    return (float)gUploadedCount / ITEM_COUNT;
+}
+
+void Assets_Unload(void)
+{
+    if (gWorkerRunning)
+    {
+        pthread_join(gWorker, NULL);
+        gWorkerRunning = false;
+    }
+
+    for (int i = 0; i < ITEM_COUNT; i++)
+    {
+        LoadedAsset *asset = &gItems[i];
+        if (asset->uploaded || !atomic_load(&asset->ready) || !asset->ownsData) continue;
+        if (i == ITEM_ATLAS || i == ITEM_BACKGROUND) UnloadImage(asset->image);
+        else UnloadWave(asset->wave);
+    }
+    MapFileClose(&gBundle);
+
+    if (gItems[ITEM_ATLAS].uploaded)
+    {
+        SetShapesTexture((Texture2D){ 0 }, (Rectangle){ 0 }); // Retour à la texture par défaut des formes
+        UnloadTexture(gSpriteAtlas);
+    }
+    if (gItems[ITEM_BACKGROUND].uploaded) UnloadTexture(gMenuBackground);
+    if (gItems[ITEM_PIECE_SOUND].uploaded) UnloadSound(gPieceSound);
+    if (gItems[ITEM_CHECK_SOUND].uploaded) UnloadSound(gCheckSound);
+    if (gItems[ITEM_EATING_SOUND].uploaded) UnloadSound(gEatingSound);
+    gUploadedCount = 0;
+}
+
+// OUTIL DE CONSTRUCTION DU PAQUET
+
+bool Assets_WriteBundle(const char *path)
+{
+    static LoadedAsset items[ITEM_COUNT];
+    BundleEntry entries[ITEM_COUNT + 1];
+    memset(entries, 0, sizeof(entries));
+
+    uint64_t offset = sizeof(BundleHeader) + sizeof(entries);
+    offset = (offset + BUNDLE_ALIGN - 1) / BUNDLE_ALIGN * BUNDLE_ALIGN;
+
+    for (int i = 0; i < ITEM_COUNT; i++)
+    {
+        DecodeItem(i, &items[i]);
+        BundleEntry *e = &entries[i];
+        snprintf(e->name, sizeof(e->name), "%s", ITEMS[i].name);
+
+        if (i == ITEM_ATLAS || i == ITEM_BACKGROUND)
+        {
+            Image img = items[i].image;
+            if (img.data == NULL)
+            {
+                fprintf(stderr, "Image introuvable : %s\n", ITEMS[i].name);
+                return false;
+            }
+            e->kind = BUNDLE_KIND_IMAGE;
+            e->a = img.width;
+            e->b = img.height;
+            e->c = img.format;
+            e->d = 1;
+            e->size = (uint64_t)GetPixelDataSize(img.width, img.height, img.format);
+        }
+        else
+        {
+            Wave wave = items[i].wave;
+            if (wave.data == NULL)
+            {
+                fprintf(stderr, "Son introuvable : %s\n", ITEMS[i].path);
+                return false;
+            }
+            e->kind = BUNDLE_KIND_WAVE;
+            e->a = (int32_t)wave.frameCount;
+            e->b = (int32_t)wave.sampleRate;
+            e->c = (int32_t)wave.sampleSize;
+            e->d = (int32_t)wave.channels;
+            e->size = (uint64_t)wave.frameCount * wave.channels * (wave.sampleSize / 8);
+        }
+        e->offset = offset;
+        offset = (offset + e->size + BUNDLE_ALIGN - 1) / BUNDLE_ALIGN * BUNDLE_ALIGN;
+    }
+
+    BundleEntry *rects = &entries[ITEM_COUNT];
+    snprintf(rects->name, sizeof(rects->name), "atlas_rects");
+    rects->kind = BUNDLE_KIND_RAW;
+    rects->offset = offset;
+    rects->size = sizeof(gAtlasRects);
+
+    BundleHeader header;
+    memcpy(header.magic, BUNDLE_MAGIC, 4);
+    header.version = BUNDLE_VERSION;
+    header.entryCount = ITEM_COUNT + 1;
+    header.reserved = 0;
+
+    FILE *f = fopen(path, "wb");
+    if (f == NULL)
+    {
+        fprintf(stderr, "Impossible d'écrire %s\n", path);
+        return false;
+    }
+
+    static const uint8_t zeros[BUNDLE_ALIGN] = { 0 };
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1 && fwrite(entries, sizeof(entries), 1, f) == 1;
+    for (int i = 0; ok && i <= ITEM_COUNT; i++)
+    {
+        long position = ftell(f);
+        if ((uint64_t)position < entries[i].offset)
+        {
+            ok = fwrite(zeros, (size_t)(entries[i].offset - (uint64_t)position), 1, f) == 1;
+        }
+        const void *data = (i == ITEM_COUNT) ? (const void *)gAtlasRects
+            : (i == ITEM_ATLAS || i == ITEM_BACKGROUND) ? items[i].image.data : items[i].wave.data;
+        ok = ok && fwrite(data, (size_t)entries[i].size, 1, f) == 1;
+    }
+    fclose(f);
+
+    for (int i = 0; i < ITEM_COUNT; i++)
+    {
+        if (i == ITEM_ATLAS || i == ITEM_BACKGROUND) UnloadImage(items[i].image);
+        else UnloadWave(items[i].wave);
+    }
+
+    printf("%s : %d éléments, %llu octets\n", path, ITEM_COUNT, (unsigned long long)offset + sizeof(gAtlasRects));
+    return ok;
+}
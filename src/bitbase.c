@@ -0,0 +1,118 @@
+#include "bitbase.h"
+#include "mapfile.h"
+#include <stdio.h>
+#include <string.h>
+
+// Une bitbase par pièce du camp fort (Pion, Tour, Reine)
+typedef struct
+{
+    const char *fileName;
+    int pieceID; // ID blanc
+    MappedFile file;
+    const uint8_t *bits;
+} Bitbase;
+
+static Bitbase gBitbases[] = {
+    { "kpk.bb", 6, { 0 }, NULL },
+    { "krk.bb", 12, { 0 }, NULL },
+    { "kqk.bb", 8, { 0 }, NULL },
+};
+#define BITBASE_COUNT (int)(sizeof(gBitbases) / sizeof(gBitbases[0]))
+
+int Bitbase_Load(const char *directory)
+{
+    int loaded = 0;
+
+    for (int i = 0; i < BITBASE_COUNT; i++)
+    {
+        Bitbase *bb = &gBitbases[i];
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", directory, bb->fileName);
+
+        MapFileClose(&bb->file);
+        bb->bits = NULL;
+        if (!MapFileOpen(&bb->file, path)) continue;
+
+        // Vérification de l'en-tête avant d'accepter le fichier
+        const BitbaseHeader *h = bb->file.data;
+        if (bb->file.size != sizeof(BitbaseHeader) + BITBASE_POSITIONS / 8
+            || memcmp(h->magic, BITBASE_MAGIC, 4) != 0
+            || h->version != BITBASE_VERSION
+            || h->pieceID != (uint32_t)bb->pieceID
+            || h->positions != BITBASE_POSITIONS)
+        {
+            MapFileClose(&bb->file);
+            continue;
+        }
+
+        bb->bits = (const uint8_t *)bb->file.data + sizeof(BitbaseHeader);
+        loaded++;
+    }
+    return loaded;
+}
+
+void Bitbase_Unload(void)
+{
+    for (int i = 0; i < BITBASE_COUNT; i++)
+    {
+        MapFileClose(&gBitbases[i].file);
+        gBitbases[i].bits = NULL;
+    }
+}
+
+BitbaseResult Bitbase_Probe(const int squares[64], int sideToMove)
+{
+    int whiteKing = -1;
+    int blackKing = -1;
+    int pieceSq = -1;
+    int pieceID = 0;
+
+    for (int sq = 0; sq < 64; sq++)
+    {
+        int id = squares[sq];
+        if (id < 2) continue;
+
+        if (id == 10) whiteKing = sq;
+        else if (id == 11) blackKing = sq;
+        else if (pieceSq == -1)
+        {
+            pieceSq = sq;
+            pieceID = id;
+        }
+        else return BITBASE_NONE; // Plus de trois pièces
+    }
+
+    if (whiteKing == -1 || blackKing == -1) return BITBASE_NONE;
+    if (pieceSq == -1) return BITBASE_DRAW; // Roi contre Roi
+
+    // Ramène le camp fort côté "Blanc" (symétrie verticale pour les Noirs)
+    int strongColor = pieceID % 2;
+    int whitePieceID = pieceID - strongColor;
+    int strongKing = whiteKing;
+    int weakKing = blackKing;
+    if (strongColor == 1)
+    {
+        strongKing = blackKing ^ 56;
+        weakKing = whiteKing ^ 56;
+        pieceSq ^= 56;
+    }
+
+    // Pion sur la dernière rangée : la recherche ne promeut pas (SimulateMove), c'est une Dame
+    // pour les bitbases (KPK le traite déjà ainsi pendant la génération, voir tools/bbgen.c)
+    if (whitePieceID == 6 && pieceSq / 8 == 0) whitePieceID = 8;
+
+    for (int i = 0; i < BITBASE_COUNT; i++)
+    {
+        const Bitbase *bb = &gBitbases[i];
+        if (bb->pieceID != whitePieceID) continue;
+        if (bb->bits == NULL) return BITBASE_NONE;
+
+        int stm = (sideToMove == strongColor) ? 0 : 1;
+        uint32_t index = BITBASE_INDEX(stm, strongKing, weakKing, pieceSq);
+        bool win = (bb->bits[index >> 3] >> (index & 7)) & 1;
+
+        if (!win) return BITBASE_DRAW;
+        return (strongColor == 0) ? BITBASE_WHITE_WINS : BITBASE_BLACK_WINS;
+    }
+    return BITBASE_NONE;
+}
@@ -0,0 +1,101 @@
+#include "book.h"
+#include "mapfile.h"
+#include <stdio.h>
+
+static MappedFile gBookFile = { 0 };
+static long gBookEntryCount = 0;
+
+static uint64_t ReadBE(const uint8_t *p, int bytes)
+{
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; i++) v = (v << 8) | p[i];
+    return v;
+}
+
+static void WriteBE(uint8_t *p, uint64_t v, int bytes)
+{
+    for (int i = bytes - 1; i >= 0; i--)
+    {
+        p[i] = (uint8_t)(v & 0xFF);
+        v >>= 8;
+    }
+}
+
+static BookEntry ReadEntry(long index)
+{
+    const uint8_t *p = (const uint8_t *)gBookFile.data + index * BOOK_ENTRY_SIZE;
+    BookEntry e;
+    e.key = ReadBE(p, 8);
+    e.move = (uint16_t)ReadBE(p + 8, 2);
+    e.weight = (uint16_t)ReadBE(p + 10, 2);
+    e.learn = (uint32_t)ReadBE(p + 12, 4);
+    return e;
+}
+
+bool Book_Open(const char *path)
+{
+    Book_Close();
+    if (!MapFileOpen(&gBookFile, path)) return false;
+
+    if (gBookFile.size % BOOK_ENTRY_SIZE != 0)
+    {
+        MapFileClose(&gBookFile);
+        return false;
+    }
+    gBookEntryCount = (long)(gBookFile.size / BOOK_ENTRY_SIZE);
+    return true;
+}
+
+void Book_Close(void)
+{
+    MapFileClose(&gBookFile);
+    gBookEntryCount = 0;
+}
+
+bool Book_IsOpen(void)
+{
+    return gBookEntryCount > 0;
+}
+
+int Book_Probe(uint64_t key, BookEntry *entries, int maxEntries)
+{
+    if (gBookEntryCount == 0) return 0;
+
+    // Recherche dichotomique de la première entrée >= key, directement dans le fichier projeté
+    long low = 0;
+    long high = gBookEntryCount;
+    while (low < high)
+    {
+        long mid = (low + high) / 2;
+        if (ReadBE((const uint8_t *)gBookFile.data + mid * BOOK_ENTRY_SIZE, 8) < key) low = mid + 1;
+        else high = mid;
+    }
+
+    int count = 0;
+    for (long i = low; i < gBookEntryCount && count < maxEntries; i++)
+    {
+        BookEntry e = ReadEntry(i);
+        if (e.key != key) break;
+        entries[count++] = e;
+    }
+    return count;
+}
+
+bool Book_Write(const char *path, const BookEntry *entries, long count)
+{
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) return false;
+
+    bool ok = true;
+    for (long i = 0; i < count && ok; i++)
+    {
+        uint8_t raw[BOOK_ENTRY_SIZE];
+        WriteBE(raw, entries[i].key, 8);
+        WriteBE(raw + 8, entries[i].move, 2);
+        WriteBE(raw + 10, entries[i].weight, 2);
+        WriteBE(raw + 12, entries[i].learn, 4);
+        ok = fwrite(raw, BOOK_ENTRY_SIZE, 1, f) == 1;
+    }
+    fclose(f);
+    return ok;
+}
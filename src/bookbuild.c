@@ -0,0 +1,277 @@
+#include "bookbuild.h"
+#include "book.h"
+#include "notation.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PGN_MAX_PLIES 512
+#define PGN_TOKEN_SIZE 64
+
+// Entrée en cours de construction (poids sur 32 bits avant fusion)
+typedef struct
+{
+    uint64_t key;
+    uint16_t move;
+    uint32_t weight;
+} RawEntry;
+
+typedef struct
+{
+    RawEntry *entries;
+    long count;
+    long capacity;
+} RawEntryList;
+
+// Partie en cours de lecture
+typedef struct
+{
+    char moves[PGN_MAX_PLIES][PGN_TOKEN_SIZE];
+    int moveCount;
+    char fen[128];    // Tag [FEN] éventuel
+    int result;       // 0 = Blancs gagnent, 1 = Noirs gagnent, -1 = nul, -2 = inconnu
+} PgnGame;
+
+static bool AddEntry(RawEntryList *list, uint64_t key, uint16_t move, uint32_t weight)
+{
+    if (list->count == list->capacity)
+    {
+        long capacity = (list->capacity == 0) ? 4096 : list->capacity * 2;
+        RawEntry *entries = realloc(list->entries, sizeof(RawEntry) * (size_t)capacity);
+        if (entries == NULL) return false;
+        list->entries = entries;
+        list->capacity = capacity;
+    }
+    list->entries[list->count++] = (RawEntry){ key, move, weight };
+    return true;
+}
+
+static int CompareEntries(const void *a, const void *b)
+{
+    const RawEntry *x = a;
+    const RawEntry *y = b;
+    if (x->key != y->key) return (x->key < y->key) ? -1 : 1;
+    return (int)x->move - (int)y->move;
+}
+
+static int ParseResult(const char *text)
+{
+    if (strcmp(text, "1-0") == 0) return 0;
+    if (strcmp(text, "0-1") == 0) return 1;
+    if (strcmp(text, "1/2-1/2") == 0) return -1;
+    return -2;
+}
+
+// Rejoue la partie et ajoute un coup par position (jusqu'à maxPlies)
+static bool AddGame(RawEntryList *list, const PgnGame *game, const BookBuildOptions *options)
+{
+    static Board board; // Trop gros pour la pile sous Windows
+    int side = 0;
+    const char *fen = (game->fen[0] != '\0') ? game->fen : START_FEN;
+    if (!BoardFromFEN(&board, fen, &side)) return true; // Partie ignorée
+
+    int plies = (game->moveCount < options->maxPlies) ? game->moveCount : options->maxPlies;
+    for (int ply = 0; ply < plies; ply++)
+    {
+        Move move;
+        int promotion = 0;
+        if (!ParseSAN(&board, side, game->moves[ply], &move, &promotion)) break; // Coup illisible : fin de la partie
+
+        uint32_t weight = 1;
+        if (!options->uniform)
+        {
+            // Nul ou résultat inconnu : 1 ; sinon 2 pour le vainqueur, 0 pour le perdant
+            if (game->result < 0) weight = 1;
+            else weight = (game->result == side) ? 2 : 0;
+        }
+
+        if (weight > 0)
+        {
+            uint16_t bookMove = BOOK_MOVE(move.startX, move.startY, move.endX, move.endY);
+            if (!AddEntry(list, PositionKey(&board, side), bookMove, weight)) return false;
+        }
+
+        ApplyMove(&board, move, promotion);
+        side = 1 - side;
+    }
+    return true;
+}
+
+// Lit un jeton PGN en sautant commentaires, variantes et annotations ; gère aussi les tags
+static bool ReadPgnFile(FILE *f, RawEntryList *list, const BookBuildOptions *options, long *gameCount)
+{
+    static PgnGame game;
+    memset(&game, 0, sizeof(game));
+    game.result = -2;
+
+    int c;
+    while ((c = fgetc(f)) != EOF)
+    {
+        if (isspace(c)) continue;
+
+        if (c == '[')
+        {
+            // Tag : [Nom "Valeur"]
+            char name[32] = { 0 };
+            char value[128] = { 0 };
+            int n = 0;
+            while ((c = fgetc(f)) != EOF && c != ']' && !isspace(c) && n < 31) name[n++] = (char)c;
+            while (c != EOF && c != ']' && c != '"') c = fgetc(f);
+            n = 0;
+            if (c == '"')
+            {
+                while ((c = fgetc(f)) != EOF && c != '"' && n < 127) value[n++] = (char)c;
+            }
+            while (c != EOF && c != ']') c = fgetc(f);
+
+            if (strcmp(name, "Result") == 0) game.result = ParseResult(value);
+            else if (strcmp(name, "FEN") == 0) snprintf(game.fen, sizeof(game.fen), "%s", value);
+            continue;
+        }
+        if (c == '{')
+        {
+            while ((c = fgetc(f)) != EOF && c != '}') { }
+            continue;
+        }
+        if (c == ';')
+        {
+            while ((c = fgetc(f)) != EOF && c != '\n') { }
+            continue;
+        }
+        if (c == '(')
+        {
+            int depth = 1;
+            while (depth > 0 && (c = fgetc(f)) != EOF)
+            {
+                if (c == '(') depth++;
+                else if (c == ')') depth--;
+                else if (c == '{') while ((c = fgetc(f)) != EOF && c != '}') { }
+            }
+            continue;
+        }
+
+        // Jeton : coup, numéro de coup, NAG ou résultat
+        char token[PGN_TOKEN_SIZE];
+        int n = 0;
+        token[n++] = (char)c;
+        while ((c = fgetc(f)) != EOF && !isspace(c) && strchr("{}()[];", c) == NULL)
+        {
+            if (n < PGN_TOKEN_SIZE - 1) token[n++] = (char)c;
+        }
+        token[n] = '\0';
+        if (c != EOF && !isspace(c)) ungetc(c, f);
+
+        if (token[0] == '$') continue; // NAG
+
+        int result = ParseResult(token);
+        if (result != -2 || strcmp(token, "*") == 0)
+        {
+            // Fin de partie
+            if (game.result == -2) game.result = result;
+            if (!AddGame(list, &game, options)) return false;
+            (*gameCount)++;
+            memset(&game, 0, sizeof(game));
+            game.result = -2;
+            continue;
+        }
+
+        // "12." / "12..." / "12.e4" : on retire le numéro
+        char *san = token;
+        while (isdigit((unsigned char)*san)) san++;
+        if (san != token) while (*san == '.') san++;
+        if (*san == '\0') continue;
+
+        if (game.moveCount < PGN_MAX_PLIES)
+        {
+            snprintf(game.moves[game.moveCount++], PGN_TOKEN_SIZE, "%s", san);
+        }
+    }
+
+    // Dernière partie sans résultat final
+    if (game.moveCount > 0)
+    {
+        if (!AddGame(list, &game, options)) return false;
+        (*gameCount)++;
+    }
+    return true;
+}
+
+long BuildBookFromPGN(const char *outPath, const char *const *pgnFiles, int fileCount, const BookBuildOptions *options)
+{
+    RawEntryList list = { NULL, 0, 0 };
+    long gameCount = 0;
+
+    for (int i = 0; i < fileCount; i++)
+    {
+        FILE *f = fopen(pgnFiles[i], "r");
+        if (f == NULL)
+        {
+            fprintf(stderr, "Impossible d'ouvrir %s\n", pgnFiles[i]);
+            continue;
+        }
+        bool ok = ReadPgnFile(f, &list, options, &gameCount);
+        fclose(f);
+        if (!ok)
+        {
+            free(list.entries);
+            return -1;
+        }
+    }
+
+    // Tri puis fusion des coups identiques d'une même position
+    qsort(list.entries, (size_t)list.count, sizeof(RawEntry), CompareEntries);
+    long merged = 0;
+    for (long i = 0; i < list.count; i++)
+    {
+        if (merged > 0 && list.entries[merged - 1].key == list.entries[i].key
+            && list.entries[merged - 1].move == list.entries[i].move)
+        {
+            list.entries[merged - 1].weight += list.entries[i].weight;
+        }
+        else
+        {
+            list.entries[merged++] = list.entries[i];
+        }
+    }
+
+    // Filtrage puis mise à l'échelle des poids sur 16 bits, position par position
+    BookEntry *book = malloc(sizeof(BookEntry) * (size_t)(merged > 0 ? merged : 1));
+    if (book == NULL)
+    {
+        free(list.entries);
+        return -1;
+    }
+
+    long written = 0;
+    for (long i = 0; i < merged; )
+    {
+        long j = i;
+        uint32_t maxWeight = 0;
+        while (j < merged && list.entries[j].key == list.entries[i].key)
+        {
+            if (list.entries[j].weight > maxWeight) maxWeight = list.entries[j].weight;
+            j++;
+        }
+
+        for (long k = i; k < j; k++)
+        {
+            uint32_t w = list.entries[k].weight;
+            if (w < (uint32_t)options->minWeight) continue;
+            if (maxWeight > 0xFFFF)
+            {
+                w = (uint32_t)(((uint64_t)w * 0xFFFF) / maxWeight);
+                if (w == 0) w = 1;
+            }
+            book[written++] = (BookEntry){ list.entries[k].key, list.entries[k].move, (uint16_t)w, 0 };
+        }
+        i = j;
+    }
+
+    bool ok = Book_Write(outPath, book, written);
+    printf("%ld parties lues, %ld positions/coups écrits dans %s\n", gameCount, written, outPath);
+
+    free(book);
+    free(list.entries);
+    return ok ? written : -1;
+}
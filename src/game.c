@@ -1,21 +1,20 @@
 #include "game.h"
+#include "analysis.h"
+#include "clock.h"
+#include "input.h"
+#include "notation.h"
+#include "ponder.h"
+#include "profiler.h"
+#include "searchstats.h"
+#include <math.h>
 #include <stdio.h> 
 #include <stdlib.h> 
+#include <string.h>
 #include <stdbool.h> // Ajout pour bool et les fonctions
 
-// PROTOTYPES (OBLIGATOIRES)
-static bool IsKingInCheck(const Board *board, int kingColor);
-static bool IsSquareAttacked(const Board *board, int x, int y, int color);
-static bool IsMoveValid(const Board *board, int startX, int startY, int endX, int endY);
-static bool IsPathClear(const Board *board, int startX, int startY, int endX, int endY);
-static bool isSimulation = false;
-
-// Ajout des fonctions min et max pour l'AlphaBeta
-#define min(a, b) ((a) < (b) ? (a) : (b))
-#define max(a, b) ((a) > (b) ? (a) : (b))
-
 // IMPORTATIONS EXTERNES
-extern Texture2D gTileTextures[]; 
+extern Texture2D gSpriteAtlas; // Toutes les cases et pièces dans une seule texture
+extern Rectangle gSpriteRects[]; // Rectangle source de chaque ID dans l'atlas
 extern int gTileTextureCount; 
 
 extern Sound gPieceSound;
@@ -25,7 +24,6 @@ extern Sound gEatingSound;
 // VARIABLES GLOBALES
 int selectedX = -1; 
 int selectedY = -1; 
-int currentTurn = 0; // 0 = Blancs, 1 = Noirs
 
 // Gestion de la Promotion (Pion -> Reine/Tour/Etc)
 int promotionPending = 0; // 1 si le jeu est en pause pour choisir une pièce
@@ -37,1023 +35,481 @@ int promotionColor = -1;
 static int possibleMoves[MAX_MOVES][2]; 
 static int possibleMoveCount = 0; 
 
-// ROQUE : suivi des déplacements (0 = jamais bougé)
-static bool kingMoved[2] = { false, false }; // [0]=Blanc, [1]=Noir
+// Cache de la position réelle : coups légaux, destinations par pièce et échec,
+// recalculés une seule fois par position (Board.version change à chaque vrai coup)
+static unsigned int cachedVersion = 0;
+static int cachedSide = -1;
+static Move cachedMoves[MAX_MOVES];
+static int cachedMoveCount = 0;
+static uint64_t cachedTargets[BOARD_ROWS * BOARD_COLS]; // Bit (y * 8 + x) : destination légale depuis la case
+static bool cachedInCheck = false;
 
-// Tours : [couleur][0=gauche, 1=droite]
-static bool rookMoved[2][2] = {
-    { false, false }, // Blanc
-    { false, false }  // Noir
-};
+// LOGIQUE DE L'IA (la décision elle-même est dans le moteur : ChooseMove, les niveaux dans ailevel.c)
 
-// FONCTIONS UTILITAIRES
+static double engineNps = AI_REFERENCE_NPS;
 
-// Vide complètement une case (enlève toutes les pièces)
-static void TileClear(Tile *t) 
+void GameSetEngineSpeed(double nodesPerSecond)
 {
-    t->layerCount = 0;
-    for(int i = 0; i < MAX_LAYERS; i++) 
-    {
-        t->layers[i] = 0;
-    }
+    if (nodesPerSecond > 0.0) engineNps = nodesPerSecond;
 }
 
-// Ajoute une texture (ID de pièce) sur une case
-static void TilePush(Tile *t, int textureIndex) 
+static long AILevelNodes(AIDifficulty difficulty)
 {
-    if (t->layerCount < MAX_LAYERS) 
-    {
-        t->layers[t->layerCount] = textureIndex;
-        t->layerCount++;
-    }
+    return AILevel_Nodes(difficulty, engineNps);
 }
 
-// Retire la dernière texture posée (la pièce du dessus) et renvoie son ID
-static int TilePop(Tile *t) 
+// Limites de la recherche de l'IA pour le niveau choisi (control : plafond de temps, ou NULL)
+static SearchLimits AISearchLimits(const Game *game, SearchControl *control)
 {
-    if (t->layerCount <= 1) return 0; // Ne retire pas le sol
-    
-    int objectIndex = t->layers[t->layerCount - 1];
-    t->layerCount--;
-    
-    return objectIndex;
+    // Budget calculé au moment de chercher : la vitesse est mesurée après l'ouverture du menu
+    return AILevel_Limits(game->difficulty, AILevelNodes(game->difficulty), control);
 }
 
-// Renvoie la couleur d'une pièce : 0 = Blanc, 1 = Noir, -1 = Pas une pièce
-static int GetPieceColor(int textureID)
+// Niveaux faibles : tirage parmi les variantes à moins de marginCp de la meilleure
+// (jamais quand un mat est en jeu, ni pour un coup du livre ou un mat forcé)
+static Move AISampleMove(const Game *game, Move bestMove)
 {
-    if (textureID < 2) return -1; // Les ID 0 et 1 sont les sols
-    
-    // Astuce : Les ID pairs sont blancs, les impairs sont noirs
-    if (textureID % 2 == 0)
-    {
-        return 0; // Blanc
-    }
-    else 
+    const AILevel *level = AILevel_Get(game->difficulty);
+    const SearchStats *stats = GetLastSearchStats();
+    if (level->lines <= 1 || stats->source != SEARCH_SOURCE_SEARCH || stats->lineCount < 2) return bestMove;
+
+    int sign = (stats->side == 0) ? 1 : -1;
+    int best = sign * stats->lines[0].score;
+    if (best >= INFINITY || best <= -INFINITY) return bestMove;
+
+    int candidates = 1;
+    while (candidates < stats->lineCount && best - sign * stats->lines[candidates].score <= level->marginCp) candidates++;
+    int pick = rand() % candidates;
+    if (pick > 0)
     {
-        return 1; // Noir
+        TraceLog(LOG_INFO, "IA : variante n°%d jouée (%d centipions de moins)", pick + 1, best - sign * stats->lines[pick].score);
     }
+    return stats->lines[pick].pv[0];
 }
 
-// LOGIQUE DE DÉPLACEMENT
+// Réflexion pendant le tour du joueur (voir ponder.h), désactivable avec --no-ponder
+static bool ponderEnabled = true;
 
-// Vérifie si le chemin est libre entre A et B (pour Tour, Fou, Reine)
-static bool IsPathClear(const Board *board, int startX, int startY, int endX, int endY)
+void GameSetPondering(bool enabled)
 {
-    // Cas 1 : Déplacement Horizontal
-    if (startY == endY) 
-    {
-        int step = (endX > startX) ? 1 : -1;
+    ponderEnabled = enabled;
+    if (!enabled) Ponder_Stop();
+}
 
-        // On parcourt les cases ENTRE le départ et l'arrivée
-        for (int x = startX + step; x != endX; x += step)
-        {
-            if (board->tiles[startY][x].layerCount > 1) 
-            {
-                return false; // Obstacle trouvé
-            }
-        }
-    }
-    // Cas 2 : Déplacement Vertical
-    else if (startX == endX)
-    {
-        int step = (endY > startY) ? 1 : -1;
+// Recherche par tranches (--slice-ms) : l'IA cherche quelques millisecondes par image dans
+// GameUpdate au lieu de bloquer la fenêtre, sans aucun thread (pas de réflexion non plus)
+static double searchSliceMs = 0.0;
+static SearchControl sliceControl; // Doit survivre d'une image à l'autre
 
-        for (int y = startY + step; y != endY; y += step)
-        {
-            if (board->tiles[y][startX].layerCount > 1) 
-            {
-                return false; // Obstacle trouvé
-            }
-        }
-    }
-    // Cas 3 : Déplacement Diagonal
-    else if (abs(endX - startX) == abs(endY - startY)) 
-    {
-        int stepX = (endX > startX) ? 1 : -1;
-        int stepY = (endY > startY) ? 1 : -1;
+void GameSetSearchSlice(double sliceMs)
+{
+    searchSliceMs = (sliceMs > 0.0) ? sliceMs : 0.0;
+    if (searchSliceMs > 0.0) GameSetPondering(false);
+}
 
-        int x = startX + stepX; 
-        int y = startY + stepY; 
+// Pendules : instants monotones pris au moment même des coups, ou temps des images (rejeux)
+static bool frameClock = false;
+static uint64_t frameClockNs = 0;
+static GameClock aiTimeControl = { GAMECLOCK_FISCHER, 600000, 0, { 600000 * GAMECLOCK_NS_PER_MS, 600000 * GAMECLOCK_NS_PER_MS }, -1, 0 };
 
-        // On avance en diagonale jusqu'à la case juste avant l'arrivée
-        while (x != endX) 
-        {
-            if (board->tiles[y][x].layerCount > 1) 
-            {
-                return false; // Obstacle trouvé
-            }
-            x += stepX; 
-            y += stepY; 
-        }
-    }
-    return true; // Chemin libre
+void GameSetTimeControl(const GameClock *clock)
+{
+    aiTimeControl = *clock;
+    aiTimeControl.running = -1;
 }
 
-// Vérifie si une pièce a le droit de bouger de A vers B (Règles des échecs de base)
-static bool IsMoveValid(const Board *board, int startX, int startY, int endX, int endY)
+void GameSetFrameClock(bool enabled)
 {
-    // Règle 0 : On ne peut pas faire du surplace
-    if (startX == endX && startY == endY) return false;
-    
-    const Tile *oldTile = &board->tiles[startY][startX];
-    const Tile *targetTile = &board->tiles[endY][endX];
-    
-    // Sécurité : Si la case de départ est vide
-    if (oldTile->layerCount <= 1) return false;
+    frameClock = enabled;
+}
 
-    int pieceID = oldTile->layers[oldTile->layerCount - 1]; 
-    int currentTurnColor = GetPieceColor(pieceID); 
-    
-    int dx = endX - startX; 
-    int dy = endY - startY; 
-    bool ruleMatch = false;
+static uint64_t GameNowNs(void)
+{
+    return frameClock ? frameClockNs : Clock_NowNs();
+}
 
-    // ANALYSE SELON LA PIÈCE
+// Fin de coup (le trait vient de changer) : la pendule du camp qui a joué s'arrête, l'autre part
+static void ClockPress(Game *game)
+{
+    GameClock_Press(&game->timer, GameNowNs());
+}
 
-    // TOUR (ID 12 Blanc, 13 Noir)
-    if (pieceID == 12 || pieceID == 13) 
+// Coup réel terminé (pièce de promotion choisie) : ajouté à l'historique de la partie
+static void HistoryRecord(Game *game, Move move, int promotionPieceID)
+{
+    bool wasFull = game->history.full;
+    if (!History_Push(&game->history, move, promotionPieceID) && !wasFull)
     {
-        // Doit bouger en ligne droite (soit dx est 0, soit dy est 0)
-        if ((dx != 0 && dy == 0) || (dx == 0 && dy != 0)) 
-        {
-            if (IsPathClear(board, startX, startY, endX, endY)) 
-            {
-                ruleMatch = true;
-            }
-        }
+        TraceLog(LOG_WARNING, "Historique plein (%d demi-coups) : coups suivants non enregistrés", HISTORY_MAX_PLIES);
     }
-    // FOU (ID 4 Blanc, 5 Noir)
-    else if (pieceID == 4 || pieceID == 5) 
+}
+
+static void AILogDecision(const SearchStats *stats)
+{
+    if (stats->source == SEARCH_SOURCE_BOOK)
     {
-        // Doit bouger en diagonale parfaite (dx égal à dy en valeur absolue)
-        if (abs(dx) == abs(dy) && dx != 0) 
-        {
-            if (IsPathClear(board, startX, startY, endX, endY)) 
-            {
-                ruleMatch = true;
-            }
-        }
+        TraceLog(LOG_INFO, "Coup joué depuis le livre d'ouverture");
     }
-    // REINE (ID 8 Blanc, 9 Noir)
-    else if (pieceID == 8 || pieceID == 9) 
+    else if (stats->source == SEARCH_SOURCE_MATE)
     {
-        // Combine Tour et Fou
-        if ((dx != 0 && dy == 0) || (dx == 0 && dy != 0) || (abs(dx) == abs(dy))) 
-        {
-            if (IsPathClear(board, startX, startY, endX, endY)) 
-            {
-                ruleMatch = true;
-            }
-        }
+        TraceLog(LOG_INFO, "Mat trouvé par l'IA (%ld noeuds)", stats->totalNodes);
     }
-    // ROI (ID 10 Blanc, 11 Noir)
-    else if (pieceID == 10 || pieceID == 11) 
+    else if (stats->source == SEARCH_SOURCE_LEARN)
     {
-        // Déplacement 1 case dans toutes les directions
-        if (abs(dx) <= 1 && abs(dy) <= 1) 
-        {
-            ruleMatch = true;
-        }
-        // ROQUE
-        else if (dy == 0 && (dx == 2 || dx == -2))
-        {
-            // Roi déjà déplacé
-            if (kingMoved[currentTurnColor])
-                return false;
-
-            // Tour déjà déplacée
-            int rookSide = (dx == 2) ? 1 : 0; // 0=gauche, 1=droite
-            if (rookMoved[currentTurnColor][rookSide])
-                return false;
-
-            if (IsKingInCheck(board, currentTurnColor))
-                return false;
-
-            int rookX = (dx == 2) ? startX + 3 : startX - 4;
-
-            const Tile *rookTile = &board->tiles[startY][rookX];
-            if (rookTile->layerCount <= 1) return false;
-
-            int rookID = rookTile->layers[rookTile->layerCount - 1];
-            bool correctRook =
-                (currentTurnColor == 0 && rookID == 12) ||
-                (currentTurnColor == 1 && rookID == 13);
-
-            if (!correctRook) return false;
-
-            int step = (dx > 0) ? 1 : -1;
-
-            // Cases VIDES entre roi et tour
-            for (int x = startX + step; x != rookX; x += step)
-            {
-                if (board->tiles[startY][x].layerCount > 1)
-                    return false;
-            }
-
-            //  Cases NON ATTAQUÉES (roi → intermédiaire → arrivée)
-            for (int x = startX; x != endX + step; x += step)
-            {
-                if (IsSquareAttacked(board, x, startY, currentTurnColor))
-                    return false;
-            }
-
-            ruleMatch = true;
-        }
+        TraceLog(LOG_INFO, "Position connue : réponse immédiate");
     }
-    
-
-    // CAVALIER (ID 2 Blanc, 3 Noir)
-    else if (pieceID == 2 || pieceID == 3) 
+    else if (stats->iterationCount > 0)
     {
-        // Mouvement en "L" (2 cases d'un côté, 1 case de l'autre)
-        if ((abs(dx) == 1 && abs(dy) == 2) || (abs(dx) == 2 && abs(dy) == 1)) 
-        {
-            ruleMatch = true;
-        }
+        const SearchIteration *last = &stats->iterations[stats->iterationCount - 1];
+        TraceLog(LOG_INFO, "IA : profondeur %d, %ld noeuds, %.0f ms, %.0f noeuds/s, score %d",
+            last->depth, stats->totalNodes, stats->totalMs,
+            (stats->totalMs > 0.0) ? stats->totalNodes * 1000.0 / stats->totalMs : 0.0, stats->score);
     }
-    // PION (ID 6 Blanc, 7 Noir)
-    else if (pieceID == 6 || pieceID == 7) 
+    SearchLog_Write(stats);
+}
+
+// Joue le coup choisi (ou constate mat / pat), puis réfléchit à la suite pendant le tour du joueur
+static void AIPlayMove(Game *game, Move bestMove)
+{
+    Board *board = &game->board;
+    if (bestMove.startX != -1)
     {
-        int direction;
-        int initialRow;
-
-        if (currentTurnColor == 0) { // Blanc
-            direction = -1; // Monte
-            initialRow = 6;
-        } else { // Noir
-            direction = 1; // Descend
-            initialRow = 1;
-        }
-        
-        // Capture en diagonale
-        if (abs(dx) == 1 && dy == direction) 
+        // Coup réel ; l'IA choisit la Reine en cas de promotion
+        ApplyMove(board, bestMove, 0);
+        HistoryRecord(game, bestMove, 0);
+        PlaySound(gPieceSound);
+        if ((board->lastMove.capturedPieceID != -1 && board->lastMove.capturedPieceID != 0) || bestMove.isEnPassant) 
         {
-            // Il faut qu'il y ait une pièce ennemie sur la cible
-            if (targetTile->layerCount > 1) 
-            { 
-                int targetColor = GetPieceColor(targetTile->layers[targetTile->layerCount - 1]);
-                if (targetColor != -1 && targetColor != currentTurnColor) 
-                {
-                    ruleMatch = true; 
-                }
-            }
-            // --- MODIFICATION : PRISE EN PASSANT ---
-            // Si la case cible est vide MAIS qu'elle correspond aux coordonnées de prise en passant
-            else if (targetTile->layerCount <= 1 && endX == board->enPassantX && endY == board->enPassantY)
-            {
-                ruleMatch = true;
-            }
-        }
-        // Avance simple (1 case)
-        else if (dx == 0 && dy == direction) 
-        {
-            // La case cible doit être vide
-            if (targetTile->layerCount == 1) 
-            {
-                ruleMatch = true;
-            }
+            PlaySound(gEatingSound);
         }
-        // Double avance (Premier tour)
-        else if (dx == 0 && dy == 2 * direction && startY == initialRow) 
-        {
-            // La case cible ET la case intermédiaire doivent être vides
-            const Tile *midTile = &board->tiles[startY + direction][startX];
-            if (targetTile->layerCount == 1 && midTile->layerCount == 1) 
-            {
-                ruleMatch = true;
-            }
-        }
-    }
-
-    // Si la règle physique n'est pas respectée, c'est invalide
-    if (!ruleMatch) return false;
 
-    // VÉRIFICATION COLLISION ALLIÉE
-    // On ne peut pas manger ses propres pièces
-    if (targetTile->layerCount > 1) 
-    {
-        int targetID = targetTile->layers[targetTile->layerCount - 1];
-        int targetColor = GetPieceColor(targetID);
-        
-        if (targetColor != -1 && targetColor == currentTurnColor) 
+        // Vérification de victoire (le roi capturé est géré dans MakeMove/UnmakeMove,
+        // mais l'état de la partie doit être mis à jour ici pour le jeu réel)
+        if (bestMove.capturedPieceID == 10) // Capture le Roi Blanc
         {
-            // Exception : Pour le roque, l'arrivée est vide.
-            if (!((pieceID == 10 || pieceID == 11) && abs(dx) == 2))
-            {
-                return false; // Bloqué par un ami
-            }
+            game->winner = ID_IA;
+            game->state = STATE_GAMEOVER;
+            TraceLog(LOG_INFO, "ROI BLANC CAPTURE PAR L'IA ! PARTIE TERMINEE");
         }
+        
+        // Changement de tour : la pendule de l'IA s'arrête à la fin réelle de sa recherche
+        board->sideToMove = 1 - board->sideToMove;
+        ClockPress(game);
     }
-
-    return true; 
-}
-
-// LOGIQUE DE SÉCURITÉ (ECHEC / MAT)
-
-// Détecte si le Roi d'une couleur donnée est menacé ACTUELLEMENT
-static bool IsKingInCheck(const Board *board, int kingColor)
-{
-    int kingX = -1;
-    int kingY = -1;
-    int targetKingID = (kingColor == 0) ? 10 : 11; // 10=Blanc, 11=Noir
-
-    // On cherche où est le Roi
-    for (int y = 0; y < BOARD_ROWS; y++) 
+    else
     {
-        for (int x = 0; x < BOARD_COLS; x++) 
-        {
-            const Tile *t = &board->tiles[y][x];
-            if (t->layerCount > 1) 
-            {
-                if (t->layers[t->layerCount - 1] == targetKingID) 
-                {
-                    kingX = x; 
-                    kingY = y;
-                }
-            }
-        }
+         // Si l'IA n'a pas trouvé de coup légal, c'est mat ou pat
+         if (IsKingInCheck(board, ID_IA))
+         {
+             game->state = STATE_GAMEOVER;
+             game->winner = 0; // Mat: Blanc gagne
+             TraceLog(LOG_INFO, "ECHEC ET MAT ! L'IA NE PEUT PLUS BOUGER");
+         }
+         else
+         {
+             game->state = STATE_GAMEOVER;
+             game->winner = -1; // Pat: Nul
+             TraceLog(LOG_INFO, "PAT ! L'IA NE PEUT PLUS BOUGER");
+         }
     }
-    
-    if (kingX == -1 || kingY == -1) return false;
 
-    // On regarde si un ennemi peut attaquer cette case (kingX, kingY)
-    for (int y = 0; y < BOARD_ROWS; y++) 
+    // Réponse attendue du joueur : deuxième coup de la variante principale, ou à défaut
+    // celui de la table de transposition (livre, mat forcé, variante coupée)
+    if (ponderEnabled && game->state == STATE_PLAYING)
     {
-        for (int x = 0; x < BOARD_COLS; x++) 
-        {
-            const Tile *t = &board->tiles[y][x];
-            
-            if (t->layerCount <= 1) continue;
-
-            int attackerID = t->layers[t->layerCount - 1];
-            int attackerColor = GetPieceColor(attackerID);
-
-            if (attackerColor == -1 || attackerColor == kingColor) continue;
-            
-            // On fait une copie du board pour l'appel à IsMoveValid
-            Board tempBoard = *board; 
-            int originalTurn = currentTurn;
-            
-            // On simule que c'est le tour de l'attaquant pour IsMoveValid
-            currentTurn = attackerColor;
-            
-            // Si cet ennemi peut légalement aller sur la case du Roi
-            if (IsMoveValid(&tempBoard, x, y, kingX, kingY)) 
-            {
-                currentTurn = originalTurn; // Restaure le tour
-                return true; // Le Roi est en échec !
-            }
-            currentTurn = originalTurn; // Restaure le tour (si l'appel a échoué)
-        }
+        const SearchStats *stats = GetLastSearchStats();
+        const SearchIteration *last = (stats->iterationCount > 0) ? &stats->iterations[stats->iterationCount - 1] : NULL;
+        Move reply = { .startX = -1 };
+        // (seulement si le coup joué est bien le premier de la variante : tirage des niveaux faibles)
+        if (last != NULL && last->pvLength >= 2 && last->pv[0].startX == bestMove.startX && last->pv[0].startY == bestMove.startY
+            && last->pv[0].endX == bestMove.endX && last->pv[0].endY == bestMove.endY) reply = last->pv[1];
+        SearchLimits limits = AISearchLimits(game, NULL);
+        Ponder_Start(board, reply, &limits);
     }
-    return false;
 }
 
-static bool IsSquareAttacked(const Board *board, int x, int y, int color)
+static void AIMakeMove(Game *game, float dt)
 {
-    for (int sy = 0; sy < BOARD_ROWS; sy++)
+    Board *board = &game->board;
+    if (game->mode == MODE_PLAYER_VS_IA && board->sideToMove == ID_IA)
     {
-        for (int sx = 0; sx < BOARD_COLS; sx++)
+        if (Ponder_IsActive())
         {
-            const Tile *t = &board->tiles[sy][sx];
-            if (t->layerCount <= 1) continue;
-
-            int pieceID = t->layers[t->layerCount - 1];
-            int pieceColor = GetPieceColor(pieceID);
-
-            if (pieceColor != 1 - color) continue;
-
-            int dx = x - sx;
-            int dy = y - sy;
-
-            // PIONS
-            if (pieceID == 6 || pieceID == 7)
+            if (Ponder_Matches(board))
             {
-                int dir = (pieceColor == 0) ? -1 : 1;
-                if (abs(dx) == 1 && dy == dir)
-                    return true;
-            }
-
-            // CAVALIERS
-            else if (pieceID == 2 || pieceID == 3)
-            {
-                if ((abs(dx) == 1 && abs(dy) == 2) || (abs(dx) == 2 && abs(dy) == 1))
-                    return true;
-            }
-
-            // ROI (attaque 1 case SEULEMENT, PAS DE ROQUE)
-            else if (pieceID == 10 || pieceID == 11)
-            {
-                if (abs(dx) <= 1 && abs(dy) <= 1)
-                    return true;
-            }
-
-            // FOU
-            else if (pieceID == 4 || pieceID == 5)
-            {
-                if (abs(dx) == abs(dy) && IsPathClear(board, sx, sy, x, y))
-                    return true;
-            }
-
-            // TOUR
-            else if (pieceID == 12 || pieceID == 13)
-            {
-                if ((dx == 0 || dy == 0) && IsPathClear(board, sx, sy, x, y))
-                    return true;
-            }
-
-            // REINE
-            else if (pieceID == 8 || pieceID == 9)
-            {
-                if (((dx == 0 || dy == 0) || abs(dx) == abs(dy)) &&
-                    IsPathClear(board, sx, sy, x, y))
-                    return true;
+                // Coup attendu : le temps de réflexion a été pris sur celui du joueur.
+                // Recherche pas encore finie : on attend sans bloquer l'affichage.
+                Move ponderMove;
+                if (!Ponder_Result(&ponderMove)) return;
+                TraceLog(LOG_INFO, "Réflexion : coup attendu, réponse immédiate");
+                AILogDecision(GetLastSearchStats());
+                AIPlayMove(game, AISampleMove(game, ponderMove));
+                return;
             }
+            // Coup inattendu : la table de transposition reste remplie pour la vraie recherche
+            Ponder_Stop();
+            TraceLog(LOG_INFO, "Réflexion : coup inattendu, nouvelle recherche");
         }
-    }
-    return false;
-}
 
-// LOGIQUE DE L'IA
-
-// Effectue le coup (déplace la pièce, gère la capture, le roque)
-static void MakeMove(Board *board, Move move)
-{
-    Tile *startTile = &board->tiles[move.startY][move.startX]; 
-    Tile *endTile = &board->tiles[move.endY][move.endX]; 
-    
-    // Sauvegarder la pièce capturée (si elle n'est pas déjà dans 'move.capturedPieceID')
-    // Pour l'IA, on suppose que 'capturedPieceID' est déjà pré-rempli par GenerateLegalMoves.
-    if (!move.isEnPassant && move.capturedPieceID == 0 && endTile->layerCount > 1) 
-    {
-        move.capturedPieceID = TilePop(endTile); // Retire la pièce mangée et stocke son ID
-    } 
-    else if (move.capturedPieceID != 0 && !move.isEnPassant)
-    {
-         TilePop(endTile); // Retire la pièce mangée (elle est déjà stockée)
-    }
-
-    // --- LOGIQUE PRISE EN PASSANT (EXECUTION) ---
-    if (move.isEnPassant)
-    {
-        // La pièce mangée n'est pas sur endY, mais sur startY (à côté du départ)
-        Tile *capturedPawnTile = &board->tiles[move.startY][move.endX];
-        TilePop(capturedPawnTile); // On supprime le pion adverse
-    }
-    // --------------------------------------------
-
-    // --- NOUVEAU : ENREGISTREMENT DES PIÈCES MANGÉES ---
-    // On ne le fait que si ce n'est PAS une simulation (donc un vrai coup de joueur ou de l'IA validé)
-    if (!isSimulation && move.capturedPieceID != 0)
-    {
-        // Qui a mangé ? C'est celui qui bouge.
-        int capturerColor = GetPieceColor(move.movingPieceID);
-        
-        if (capturerColor == 0) // C'est Blanc qui a mangé
+        if (game->IADelay > 0.0f)
         {
-            if (board->capturedByWhiteCount < 16)
-            {
-                board->capturedByWhite[board->capturedByWhiteCount] = move.capturedPieceID;
-                board->capturedByWhiteCount++;
-            }
+            game->IADelay -= dt;
+            return;
         }
-        else // C'est Noir qui a mangé
+
+        // Livre, mat forcé ou AlphaBeta (moteur), budget du niveau choisi :
+        // d'un bloc, ou par tranches réparties sur les images suivantes
+        Move bestMove;
+        if (searchSliceMs > 0.0)
         {
-            if (board->capturedByBlackCount < 16)
+            if (!SliceSearch_IsActive())
             {
-                board->capturedByBlack[board->capturedByBlackCount] = move.capturedPieceID;
-                board->capturedByBlackCount++;
+                SearchLimits limits = AISearchLimits(game, &sliceControl);
+                SliceSearch_Start(board, &limits);
             }
+            if (!SliceSearch_Step(searchSliceMs, &bestMove)) return; // Suite à la prochaine image
         }
-    }
-    // ----------------------------------------------------
-    
-    // Le sol reste (sauf s'il y a un bug). TilePop gère cela.
-    int pieceID = TilePop(startTile); // Retire la pièce de départ
-    TilePush (endTile, pieceID); // Place la pièce sur la nouvelle case
-
-    // Marquer le déplacement du roi
-    if (!isSimulation)
-    {
-        if (pieceID == 10 || pieceID == 11)
-        {
-            kingMoved[GetPieceColor(pieceID)] = true;
-        }
-
-        if (pieceID == 12 || pieceID == 13)
+        else
         {
-            int color = GetPieceColor(pieceID);
-            if (move.startX == 0) rookMoved[color][0] = true;
-            if (move.startX == 7) rookMoved[color][1] = true;
+            SearchControl control;
+            SearchLimits limits = AISearchLimits(game, &control);
+            bestMove = ChooseMoveWithLimits(board, &limits);
         }
+        bestMove = AISampleMove(game, bestMove);
+        AILogDecision(GetLastSearchStats());
+        AIPlayMove(game, bestMove);
     }
+}
 
-    // Logique du roque si c'est un coup de roque
-    if ((pieceID == 10 || pieceID == 11) && abs(move.endX - move.startX) == 2)
-    {
-        int rookX_start = (move.endX > move.startX) ? move.startX + 3 : move.startX - 4;
-        int rookX_end = (move.endX > move.startX) ? move.startX + 1 : move.startX - 1;
+// HISTORIQUE : revue de la partie (flèches, Début, Fin) et retour arrière (touche Retour arrière)
 
-        Tile *rookStartTile = &board->tiles[move.startY][rookX_start];
-        Tile *rookEndTile = &board->tiles[move.endY][rookX_end];
-        
-        int rookID = TilePop(rookStartTile);
-        TilePush(rookEndTile, rookID);
-    }
+static Board viewBoard; // Position reconstruite pour game->viewPly
+static char viewMoveText[16] = ""; // Coup qui y mène, en notation abrégée
+static unsigned int viewSerial = 0; // Change à chaque position revue (caches du dessin et de l'analyse)
 
-    // --- MISE A JOUR ETAT EN PASSANT (POUR LE PROCHAIN TOUR) ---
-    // 1. On efface l'ancienne possibilité (elle ne dure qu'un tour)
-    board->enPassantX = -1;
-    board->enPassantY = -1;
-
-    // 2. Si c'est un PION qui avance de 2 CASES, on crée une nouvelle cible
-    if ((pieceID == 6 || pieceID == 7) && abs(move.endY - move.startY) == 2)
-    {
-        board->enPassantX = move.startX;
-        // La cible est la case sautée (moyenne des Y)
-        board->enPassantY = (move.startY + move.endY) / 2;
-    }
-    // -----------------------------------------------------------
+// Position à dessiner et à analyser : celle revue, sinon la position en cours
+static const Board *DisplayedBoard(const Game *game)
+{
+    return (game->viewPly >= 0) ? &viewBoard : &game->board;
 }
 
-// Annule le coup (replace la pièce, replace la pièce capturée, annule le roque)
-static void UnmakeMove(Board *board, Move move)
+// Affiche la position après 'ply' demi-coups (au-delà du dernier : retour à la position en cours)
+static void HistoryView(Game *game, int ply)
 {
-    Tile *startTile = &board->tiles[move.startY][move.startX]; // Case départ originale
-    Tile *endTile = &board->tiles[move.endY][move.endX]; // Case arrivée origniale
-
-    // Déplacer la pièce qui a bougé
-    int pieceID = TilePop(endTile); // Supprime la pièce tout en la stockant
-    TilePush(startTile, pieceID); // Replace la pièce à son ancienne position
-
-    // --- RESTAURATION PRISE EN PASSANT ---
-    if (move.isEnPassant)
-    {
-        // On remet le pion mangé sur sa case d'origine (à côté de start)
-        Tile *capturedPawnTile = &board->tiles[move.startY][move.endX];
-        TilePush(capturedPawnTile, move.capturedPieceID);
-    }
-    else if (move.capturedPieceID != 0)
+    selectedX = -1;
+    selectedY = -1;
+    possibleMoveCount = 0;
+    viewSerial++;
+    if (ply >= game->history.count)
     {
-        // Capture classique
-        TilePush(endTile, move.capturedPieceID); 
+        game->viewPly = -1;
+        return;
     }
-    
-    // Restauration des variables globales du board
-    board->enPassantX = move.prevEnPassantX;
-    board->enPassantY = move.prevEnPassantY;
-    // --------------------------------------
-    
-    // Annuler le roque si c'était un coup de roque
-    if ((pieceID == 10 || pieceID == 11) && abs(move.endX - move.startX) == 2)
-    {
-        int rookX_start = (move.endX > move.startX) ? move.startX + 3 : move.startX - 4;
-        int rookX_end = (move.endX > move.startX) ? move.startX + 1 : move.startX - 1;
 
-        Tile *rookStartTile = &board->tiles[move.startY][rookX_start];
-        Tile *rookEndTile = &board->tiles[move.endY][rookX_end];
-        
-        int rookID = TilePop(rookEndTile);
-        TilePush(rookStartTile, rookID);
+    // Position d'avant le coup (notation), puis le coup lui-même : au plus un intervalle rejoué
+    PROF_BEGIN(HistoryView);
+    viewMoveText[0] = '\0';
+    History_Position(&game->history, (ply > 0) ? ply - 1 : 0, &viewBoard);
+    if (ply > 0)
+    {
+        int promotion;
+        Move move = History_MoveAt(&game->history, ply - 1, &viewBoard, &promotion);
+        MoveToSAN(&viewBoard, move, promotion, viewMoveText);
+        ApplyMove(&viewBoard, move, promotion);
+        viewBoard.sideToMove = 1 - viewBoard.sideToMove;
     }
+    PROF_END(HistoryView);
+    game->viewPly = ply;
 }
 
-// Génère tous les coups LÉGAUX (qui ne mettent pas le roi en échec) pour le joueur donné
-static int GenerateLegalMoves(Board *board, Move movelist[], int playerColor)
+static void HistoryNavigate(Game *game)
 {
-    int count = 0;
-    int originalTurn = currentTurn; // Sauvegarde du tour
-
-    for (int startY = 0; startY < BOARD_ROWS; startY++)
-    {
-        for (int startX = 0; startX < BOARD_COLS; startX++)
-        {
-            Tile *startTile = &board->tiles[startY][startX];
-            
-            // Vérifier que c'est une pièce du joueur actuel
-            if (startTile->layerCount <= 1) continue; 
-            int pieceID = startTile->layers[startTile->layerCount - 1];
-            if (GetPieceColor(pieceID) != playerColor) continue;
-            
-            // NOTE : On doit temporairement mettre le tour pour que IsMoveValid sache quelle couleur vérifier
-            currentTurn = playerColor;
-
-            // Générer tous les mouvements possibles selon les règles physiques
-            for (int endY = 0; endY < BOARD_ROWS; endY++)
-            {
-                for (int endX = 0; endX < BOARD_COLS; endX++)
-                {
-                    if (IsMoveValid(board, startX, startY, endX, endY))
-                    {
-                        // Créer le coup de base
-                        Move m = {startX, startY, endX, endY, pieceID, 0, false, 0, 0}; 
-
-                        // Sauvegarde de l'état actuel du En Passant
-                        m.prevEnPassantX = board->enPassantX;
-                        m.prevEnPassantY = board->enPassantY;
-
-                        // Vérification si c'est une Prise en Passant
-                        Tile *endTile = &board->tiles[endY][endX];
-                        
-                        // Si c'est un pion, qui va en diagonale, sur une case vide
-                        if ((pieceID == 6 || pieceID == 7) && abs(endX - startX) == 1 && endTile->layerCount <= 1)
-                        {
-                            // C'est un En Passant valide (validé par IsMoveValid)
-                            m.isEnPassant = true;
-                            // La pièce mangée est sur la case [startY][endX]
-                            Tile *capturedTile = &board->tiles[startY][endX];
-                            if (capturedTile->layerCount > 1)
-                            {
-                                m.capturedPieceID = capturedTile->layers[capturedTile->layerCount - 1];
-                            }
-                        }
-                        else
-                        {
-                            // Capture classique ou déplacement normal
-                            if (endTile->layerCount > 1)
-                            {
-                                m.capturedPieceID = endTile->layers[endTile->layerCount - 1];
-                            }
-                        }
-                        
-                        // On simule le coup
-                        isSimulation = true;
-                        MakeMove(board, m); 
-                        
-                        // Si le roi n'est PAS en échec après le coup, c'est un coup légal
-                        if (!IsKingInCheck(board, playerColor))
-                        {
-                            if (count < MAX_MOVES)
-                            {
-                                movelist[count++] = m;
-                            }
-                        }
-                        
-                        // Annuler le coup pour revenir à la position de départ
-                        UnmakeMove(board, m); 
-                        isSimulation = false;
-                    }
-                }
-            }
-            currentTurn = originalTurn; // Restaure le tour
-        }
-    }
-    currentTurn = originalTurn; // Restaure le tour
-    return count;
+    int current = (game->viewPly >= 0) ? game->viewPly : game->history.count;
+    int target = current;
+    if (Input_KeyPressed(KEY_LEFT)) target = current - 1;
+    if (Input_KeyPressed(KEY_RIGHT)) target = current + 1;
+    if (Input_KeyPressed(KEY_HOME)) target = 0;
+    if (Input_KeyPressed(KEY_END)) target = game->history.count;
+    if (target != current && target >= 0) HistoryView(game, target);
 }
 
-
-// Fonction d'évaluation simple
-static int EvalutatePosition(const Board *board)
+// La partie reprend à la position revue ou, sinon, avant le dernier coup ; contre l'IA,
+// toujours au trait du joueur. Le temps déjà écoulé reste débité des pendules.
+static void HistoryTakeback(Game *game)
 {
-    int PAWN_VAL = 100;
-    int KNIGHT_VAL = 320;
-    int BISHOP_VAL = 330;
-    int ROOK_VAL = 500;
-    int QUEEN_VAL = 900;
-    int score = 0;
-
-    // Calcul de la valeur matérielle
-    for (int y = 0; y < BOARD_ROWS; y++)
+    if (game->history.full)
     {
-        for (int x = 0; x < BOARD_COLS; x++)
-        {
-            const Tile *t = &board->tiles[y][x];
-            
-            if (t->layerCount > 1)
-            {
-                int pieceID = t->layers[t->layerCount - 1]; 
-                int pieceColor = GetPieceColor(pieceID); 
+        TraceLog(LOG_WARNING, "Historique plein : retour arrière impossible");
+        return;
+    }
+    int ply = (game->viewPly >= 0) ? game->viewPly : game->history.count - 1;
+    if (ply < 0) return;
 
-                int value = 0;
+    Board board;
+    History_Position(&game->history, ply, &board);
+    if (game->mode == MODE_PLAYER_VS_IA && board.sideToMove == ID_IA && ply > 0)
+    {
+        History_Position(&game->history, --ply, &board);
+    }
 
-                // Identification de la pièce et assignation de la valeur
-                if (pieceID == 6 || pieceID == 7) value = PAWN_VAL;       
-                else if (pieceID == 2 || pieceID == 3) value = KNIGHT_VAL; 
-                else if (pieceID == 4 || pieceID == 5) value = BISHOP_VAL;  
-                else if (pieceID == 12 || pieceID == 13) value = ROOK_VAL;  
-                else if (pieceID == 8 || pieceID == 9) value = QUEEN_VAL;   
+    // Une recherche de l'IA sur l'ancienne suite ne doit pas aboutir
+    Ponder_Stop();
+    SliceSearch_Abort();
 
-                // Ajout ou soustraction au score total
-                if (pieceColor == 0) // Blanc (maximise)
-                {
-                    score += value;
-                }
-                else // Noir (minimise)
-                {
-                    score -= value;
-                }
+    unsigned int version = game->board.version;
+    game->board = board;
+    game->board.version = version + 1; // Caches (coups légaux, plateau dessiné) : nouvelle position
+    History_Truncate(&game->history, ply);
+    HistoryView(game, ply); // Sélection effacée, retour à la position en cours
 
-                // Facteurs positionnels simples
-                if ((pieceID == 6 || pieceID == 7) && (x >= 3 && x <= 4)) // Pions centraux
-                {
-                    if (pieceColor == 0) score += 5; 
-                    else score -= 5;                 
-                }
-            }
-        }
-    }
-    return score;
+    // Temps du coup en cours débité sans incrément (ce n'est pas un coup joué), puis le camp rétabli au trait
+    GameClock_Restart(&game->timer, game->board.sideToMove, GameNowNs());
+    if (game->mode == MODE_PLAYER_VS_IA && game->board.sideToMove == ID_IA) game->IADelay = game->AIDefaultDelay;
+    TraceLog(LOG_INFO, "Retour arrière : reprise après %d demi-coups", ply);
 }
 
-static int AlphaBeta(Board *b, int profondeur, int a, int beta, bool isMax, int playerTurn)
+// ANALYSE EN PARTIE À DEUX (touche A : analyse, touche H : flèches des meilleurs coups)
+// et en revue d'une partie terminée : toujours sur la position affichée
+
+static bool analysisEnabled = false;
+static bool analysisArrows = false;
+static unsigned int analysisPositionId = 0;
+static unsigned int analysisVersion = 0;
+static int analysisSide = -1;
+static unsigned int analysisView = 0;
+
+static void AnalysisUpdate(Game *game)
 {
-    if (profondeur == 0) return EvalutatePosition(b); 
-    
-    Move LocalMoveList[MAX_MOVES];
-    int count = GenerateLegalMoves(b, LocalMoveList, playerTurn); 
-    if (count == 0)
+    const Board *board = DisplayedBoard(game);
+    if (Input_KeyPressed(KEY_A))
     {
-        // Gérer échec et mat / pat
-        if (IsKingInCheck(b, playerTurn))
-        {
-             return isMax ? -INFINITY : INFINITY; // Mat
-        }
-        else
+        analysisEnabled = !analysisEnabled;
+        if (analysisEnabled)
         {
-            return 0; // Pat
+            // Coeurs libres : le thread du jeu garde le sien
+            int threads = Clock_CoreCount() - 1;
+            analysisEnabled = Analysis_Start(threads, ANALYSIS_MAX_LINES);
+            analysisSide = -1;
         }
+        else Analysis_Stop();
+        TraceLog(LOG_INFO, "Analyse %s", analysisEnabled ? "activée" : "désactivée");
     }
+    if (Input_KeyPressed(KEY_H)) analysisArrows = !analysisArrows;
 
-    if (isMax) // Cherche le meilleur coup pour Blanc (maximise)
-    {
-        int maxEval = -INFINITY_SCORE;
-        for (int i = 0; i < count; i++) 
-        {
-            Move m = LocalMoveList[i];
-            isSimulation = true;
-            MakeMove(b, m); 
-            int eval = AlphaBeta(b, profondeur - 1, a, beta, false, 1 - playerTurn); 
-            UnmakeMove(b, m); 
-            isSimulation = false;
-            maxEval = max(maxEval, eval);
-            a = max(a, eval); 
-            if (beta <= a) break; 
-        }
-        return maxEval;
-    }
-    else // Cherche le meilleur coup pour Noir (minimise)
+    // Nouvelle position (pas pendant le choix d'une promotion) : la recherche repart de là
+    if (analysisEnabled && promotionPending == 0
+        && (analysisVersion != board->version || analysisSide != board->sideToMove || analysisView != viewSerial))
     {
-        int minEval = INFINITY_SCORE;
-        for (int i = 0; i < count; i++)
-        {
-            Move m = LocalMoveList[i];
-            isSimulation = true;
-            MakeMove(b , m);
-            int eval = AlphaBeta(b, profondeur - 1, a, beta, true, 1 - playerTurn);
-            UnmakeMove(b, m);
-            isSimulation = false;
-            minEval = min(minEval, eval);
-            beta = min(beta, eval);
-            if (beta <= a) break;
-        }
-        return minEval;
+        analysisVersion = board->version;
+        analysisSide = board->sideToMove;
+        analysisView = viewSerial;
+        Analysis_SetPosition(board, ++analysisPositionId);
     }
 }
 
-static Move FindBestMove(Board *board, int depth)
-{
-    Move legalMoves[MAX_MOVES];
-    int playerTurn = currentTurn;
-    int count = GenerateLegalMoves(board, legalMoves, playerTurn);
-    
-    int bestScore = (playerTurn == 0) ? -INFINITY_SCORE : INFINITY_SCORE;
-    Move bestMove = legalMoves[0];
+// MODE ÉCONOME (--idle) : combien de temps l'image affichée reste juste sans nouvelle entrée
 
-    if (count == 0) 
-    {
-        TraceLog(LOG_WARNING, "Aucun coup légal trouvé pour l'IA !");
-        if (count > 0) return legalMoves[0];
-        // Correction de l'avertissement : on initialise tous les champs
-        return (Move){-1, -1, -1, -1, 0, 0, false, -1, -1}; 
-    }
+#define IDLE_FOREVER_SECONDS 60.0
+#define IDLE_ANALYSIS_SECONDS 0.25 // Variantes publiées par le thread d'analyse
 
-    for (int i = 0; i < count; i++)
-    {
-        Move move = legalMoves[i];
-        isSimulation = true;
-        MakeMove(board, move);
-        // L'IA joue (Min) si elle est Noir (1), et Max si elle est Blanc (0)
-        // L'appel AlphaBeta va évaluer la position du point de vue de l'adversaire (1 - playerTurn)
-        int eval = AlphaBeta(board, depth - 1, -INFINITY_SCORE, INFINITY_SCORE, (playerTurn == 0) ? false : true, 1 - playerTurn);
-        UnmakeMove(board, move);
-        isSimulation = false;
-        
-        // Mise à jour du meilleur coup trouvé
-        if (playerTurn == 0) // Blanc (Maximise)
-        {
-            if (eval > bestScore)
-            {
-                bestScore = eval;
-                bestMove = move;
-            }
-        }
-        else // Noir (Minimise)
-        {
-            if (eval < bestScore)
-            {
-                bestScore = eval;
-                bestMove = move;
-            }
-        }
-    }
-    return bestMove;
-}
-
-static void AIMakeMove(Board *board, float dt)
+double GameIdleSeconds(const Game *game)
 {
-    if (board->mode == MODE_PLAYER_VS_IA && currentTurn == ID_IA)
-    {
-        if (board->IADelay > 0.0f)
-        {
-            board->IADelay -= dt;
-            return;
-        }
-        
-        // Enregistrement du temps avant le calcul bloquant
-        double startTime = GetTime();
-
-        int depth = board->AIDepth; // Défini en fonction de la difficulté
-        Move bestMove = FindBestMove(board, depth);
-
-        // Calcul du temps écoulé pendant le calcul
-        double endTime = GetTime();
-        float calculationTime = (float)(endTime - startTime);
-
-        if (board->timer.blackTime > 0.0f)
-        {
-            board->timer.blackTime -= calculationTime;
-            TraceLog(LOG_INFO, "Temps de Calcul de l'IA déduit du temps des Noirs");
-        }
+    if (game->state != STATE_PLAYING) return analysisEnabled ? IDLE_ANALYSIS_SECONDS : IDLE_FOREVER_SECONDS;
+    // Tour de l'IA : délai, réflexion ou recherche par tranches à faire avancer à chaque image
+    if (game->mode == MODE_PLAYER_VS_IA && game->board.sideToMove == ID_IA) return 0.0;
 
-        if (bestMove.startX != -1)
-        {
-            // Effectuer le coup (utilise MakeMove pour ne pas dupliquer la logique)
-            MakeMove(board, bestMove);
-            board->lastMove = bestMove;
-            PlaySound(gPieceSound);
-            if ((board->lastMove.capturedPieceID != -1 && board->lastMove.capturedPieceID != 0) || bestMove.isEnPassant) 
-            {
-                PlaySound(gEatingSound);
-            }
-            // Gérer la promotion de l'IA (Pion arrive en ligne 7)
-            Tile *endTile = &board->tiles[bestMove.endY][bestMove.endX];
-            int pieceID = endTile->layers[endTile->layerCount - 1];
-
-            if (pieceID == 7 && bestMove.endY == 7) // Pion noir en ligne 7
-            {
-                // L'IA choisit la Reine par défaut (ID 9)
-                TilePop(endTile); // Enlève le pion
-                TilePush(endTile, 9); // Met la Reine
-                TraceLog(LOG_INFO, "Promotion de l'IA (Noir) en Reine.");
-            }
-
-            // Vérification de victoire (le roi capturé est géré dans MakeMove/UnmakeMove,
-            // mais l'état de la partie doit être mis à jour ici pour le jeu réel)
-            if (bestMove.capturedPieceID == 10) // Capture le Roi Blanc
-            {
-                board->winner = ID_IA;
-                board->state = STATE_GAMEOVER;
-                TraceLog(LOG_INFO, "ROI BLANC CAPTURE PAR L'IA ! PARTIE TERMINEE");
-            }
-            
-            // Changement de tour
-            currentTurn = 1 - currentTurn;
-        }
-        else
-        {
-             // Si l'IA n'a pas trouvé de coup légal, c'est mat ou pat
-             if (IsKingInCheck(board, ID_IA))
-             {
-                 board->state = STATE_GAMEOVER;
-                 board->winner = 0; // Mat: Blanc gagne
-                 TraceLog(LOG_INFO, "ECHEC ET MAT ! L'IA NE PEUT PLUS BOUGER");
-             }
-             else
-             {
-                 board->state = STATE_GAMEOVER;
-                 board->winner = -1; // Pat: Nul
-                 TraceLog(LOG_INFO, "PAT ! L'IA NE PEUT PLUS BOUGER");
-             }
-        }
+    // Prochain changement de la pendule affichée (secondes, dixièmes sous 20 s) ou chute
+    double wait = IDLE_FOREVER_SECONDS;
+    if (GameClock_IsRunning(&game->timer))
+    {
+        int64_t ms = GameClock_RemainingMs(&game->timer, game->timer.running, GameNowNs());
+        int64_t step = (ms < 20000) ? 100 : 1000;
+        wait = (double)(ms % step + 1) / 1000.0;
     }
+    if (analysisEnabled && wait > IDLE_ANALYSIS_SECONDS) wait = IDLE_ANALYSIS_SECONDS;
+    return wait;
 }
 
 // INITIALISATION & RESET
 
-void GameInit(Board *board) 
+void GameInit(Game *game) 
 {
-    // On parcourt tout le plateau pour placer les pièces
-    for (int y = 0; y < BOARD_ROWS; y++) 
-    {
-        for (int x = 0; x < BOARD_COLS; x++) 
-        {
-            Tile *t = &board->tiles[y][x];
-            TileClear(t); // On nettoie la case
-            
-            // Ajout du sol (Carreaux)
-            int groundIndex = (x + y) % 2;
-            TilePush(t, groundIndex);
-
-            // PLACEMENT DES PIECES 
-            
-            // Pions Noirs (Ligne 1)
-            if (y == 1) TilePush(t, 7); 
-            
-            // Pions Blancs (Ligne 6)
-            if (y == 6) TilePush(t, 6); 
-
-            // Pièces Nobles Noires (Ligne 0)
-            if (y == 0) 
-            { 
-                if (x == 0 || x == 7) TilePush(t, 13); // Tour (13)
-                if (x == 1 || x == 6) TilePush(t, 3);  // Cavalier (3)
-                if (x == 2 || x == 5) TilePush(t, 5);  // Fou (5)
-                if (x == 3) TilePush(t, 9);            // Reine (9)
-                if (x == 4) TilePush(t, 11);           // Roi (11)
-            }
-            
-            // Pièces Nobles Blanches (Ligne 7)
-            if (y == 7) 
-            { 
-                if (x == 0 || x == 7) TilePush(t, 12); // Tour (12)
-                if (x == 1 || x == 6) TilePush(t, 2);  // Cavalier (2)
-                if (x == 2 || x == 5) TilePush(t, 4);  // Fou (4)
-                if (x == 3) TilePush(t, 8);            // Reine (8)
-                if (x == 4) TilePush(t, 10);           // Roi (10)
-            }
-        }
-    }
+    // Une recherche de la partie précédente ne doit pas survivre
+    Ponder_Stop();
+    SliceSearch_Abort();
+    Analysis_Stop();
+    analysisEnabled = false;
+
+    // Position de départ (moteur)
+    BoardReset(&game->board);
+    History_Init(&game->history, &game->board);
+    game->viewPly = -1;
     
     // Initialisation des variables de jeu
-    board->timer.whiteTime = 600.0f; 
-    board->timer.blackTime = 600.0f;
-    board->state = STATE_MAIN_MENU;
-    board->mode = MODE_NONE;
-    board->winner = -1;
-    board->difficulty = DIFF_MEDIUM;
-    board->AIDepth = 3;
-    board->AIDefaultDelay = 2.0f;
-    board->IADelay = 0.0f; // Ajout de la variable d'IA
-    currentTurn = 0; 
+    game->timer = aiTimeControl; // Les parties à deux choisissent la leur dans le menu du temps
+    game->state = STATE_MAIN_MENU;
+    game->mode = MODE_NONE;
+    game->winner = -1;
+    game->difficulty = DIFF_MEDIUM;
+    game->AIDefaultDelay = 2.0f;
+    game->IADelay = 0.0f; // Ajout de la variable d'IA
     selectedX = -1; 
     selectedY = -1;
     possibleMoveCount = 0;
     promotionPending = 0;
-    board->lastMove.startX = -1;
-    board->lastMove.startY = -1;
-    board->lastMove.endX = -1;
-    board->lastMove.endY = -1;
-    board->lastMove.movingPieceID = -1;
-    board->lastMove.capturedPieceID = 0;
-    
-    // --- NOUVEAU : RESET CAPTURES ---
-    board->capturedByWhiteCount = 0;
-    board->capturedByBlackCount = 0;
-    // --------------------------------
-
-    // --- NOUVEAU : RESET EN PASSANT ---
-    board->enPassantX = -1;
-    board->enPassantY = -1;
-
-    kingMoved[0] = kingMoved[1] = false;
-    rookMoved[0][0] = rookMoved[0][1] = false;
-    rookMoved[1][0] = rookMoved[1][1] = false;
-
 }
 
 // Raccourci pour redémarrer
-void GameReset(Board *board) 
+void GameReset(Game *game) 
 { 
-    GameInit(board); 
+    GameInit(game); 
 }
 
 // 7. GESTION DES ÉVÉNEMENTS (INPUTS)
 
-static void GameLogicUpdate(Board *board, float dt)
+// Recalcule le cache de la position réelle seulement si elle a changé depuis le dernier appel
+static void RefreshPositionCache(Board *board)
+{
+    if (cachedVersion == board->version && cachedSide == board->sideToMove) return;
+
+    PROF_BEGIN(RefreshPositionCache);
+    cachedMoveCount = GenerateLegalMoves(board, cachedMoves, board->sideToMove);
+    memset(cachedTargets, 0, sizeof(cachedTargets));
+    for (int i = 0; i < cachedMoveCount; i++)
+    {
+        const Move *m = &cachedMoves[i];
+        cachedTargets[m->startY * BOARD_COLS + m->startX] |= 1ULL << (m->endY * BOARD_COLS + m->endX);
+    }
+    cachedInCheck = IsKingInCheck(board, board->sideToMove);
+    cachedVersion = board->version;
+    cachedSide = board->sideToMove;
+    PROF_END(RefreshPositionCache);
+}
+
+static void GameLogicUpdate(Game *game, float dt)
 {
+    Board *board = &game->board;
+
     // GESTION DE LA PROMOTION (Si un pion atteint le bout)
     if (promotionPending == 1) 
     {
-        Tile *promTile = &board->tiles[promotionY][promotionX];
         bool selected = false;
         int newPieceIdx = -1;
 
         // Choix (1:Reine, 2:Cavalier, 3:Tour, 4:Fou)
-        if (IsKeyPressed(KEY_ONE) || IsKeyPressed(KEY_KP_1)) {
+        if (Input_KeyPressed(KEY_ONE) || Input_KeyPressed(KEY_KP_1)) {
             newPieceIdx = (promotionColor == 1) ? 9 : 8; // Reine (Noir/Blanc)
             selected = true; 
         } 
-        else if (IsKeyPressed(KEY_TWO) || IsKeyPressed(KEY_KP_2)) {
+        else if (Input_KeyPressed(KEY_TWO) || Input_KeyPressed(KEY_KP_2)) {
             newPieceIdx = (promotionColor == 1) ? 3 : 2; // Cavalier
             selected = true; 
         } 
-        else if (IsKeyPressed(KEY_THREE) || IsKeyPressed(KEY_KP_3)) {
+        else if (Input_KeyPressed(KEY_THREE) || Input_KeyPressed(KEY_KP_3)) {
             newPieceIdx = (promotionColor == 1) ? 13 : 12; // Tour
             selected = true; 
         } 
-        else if (IsKeyPressed(KEY_FOUR) || IsKeyPressed(KEY_KP_4)) {
+        else if (Input_KeyPressed(KEY_FOUR) || Input_KeyPressed(KEY_KP_4)) {
             newPieceIdx = (promotionColor == 1) ? 5 : 4; // Fou
             selected = true; 
         }
@@ -1061,27 +517,28 @@ static void GameLogicUpdate(Board *board, float dt)
         // Application du choix
         if (selected) 
         {
-            TilePop(promTile); // Enlève le pion
-            TilePush(promTile, newPieceIdx); // Met la nouvelle pièce
+            PromotePawn(board, promotionX, promotionY, newPieceIdx);
+            HistoryRecord(game, board->lastMove, newPieceIdx);
             
             // Réinitialisation après promotion
             promotionPending = 0;
             selectedX = -1; 
             selectedY = -1;
             possibleMoveCount = 0;
-            currentTurn = 1 - currentTurn; // Le tour change enfin
+            board->sideToMove = 1 - board->sideToMove; // Le tour change enfin
+            ClockPress(game);
         }
         return; // IMPORTANT : On bloque le jeu tant que la promotion n'est pas choisie
     }
 
     // GESTION DE LA SOURIS (Jeu normal)
-    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
+    if (Input_MouseLeftPressed())
     {
-        Vector2 m = GetMousePosition(); 
+        Vector2 m = Input_MousePosition(); 
         
         // Calculs pour savoir sur quelle case on clique (Assure des cases carrées)
-        int screenW = GetScreenWidth(); 
-        int screenH = GetScreenHeight(); 
+        int screenW = Input_ScreenWidth(); 
+        int screenH = Input_ScreenHeight(); 
         int tileSizeW = screenW / BOARD_COLS;
         int tileSizeH = screenH / BOARD_ROWS;
         int tileSize = (tileSizeW < tileSizeH) ? tileSizeW : tileSizeH;
@@ -1103,57 +560,25 @@ static void GameLogicUpdate(Board *board, float dt)
                 {
                     int pieceID = clickedTile->layers[clickedTile->layerCount - 1]; 
                     
-                    if (GetPieceColor(pieceID) == currentTurn) 
+                    if (GetPieceColor(pieceID) == board->sideToMove) 
                     {
                         selectedX = x; 
                         selectedY = y;
                         TraceLog(LOG_INFO, "Selection de la piece en %d, %d", x, y); 
                         
-                        // On doit simuler la sélection en déplaçant la pièce sur le board temporaire
-                        int originalTurn = currentTurn;
-                        currentTurn = GetPieceColor(pieceID); 
-                        
-                        // Pour la vérification des coups légaux, on parcourt toutes les cases possibles
+                        // Destinations légales déjà connues pour cette position
+                        RefreshPositionCache(board);
+                        uint64_t targets = cachedTargets[y * BOARD_COLS + x];
                         possibleMoveCount = 0;
-                        for (int py = 0; py < BOARD_ROWS; py++) 
+                        for (int sq = 0; sq < BOARD_ROWS * BOARD_COLS; sq++)
                         {
-                            for (int px = 0; px < BOARD_COLS; px++) 
+                            if (targets & (1ULL << sq))
                             {
-                                if (IsMoveValid(board, selectedX, selectedY, px, py))
-                                {
-                                    // SIMULATION DE SÉCURITÉ (Copie du plateau pour la simulation)
-                                    Board temp = *board;
-                                    Move m = {selectedX, selectedY, px, py, pieceID, 0, false, board->enPassantX, board->enPassantY};
-                                    Tile *sNew = &temp.tiles[py][px];
-                                    
-                                    // Détection En Passant
-                                    if ((pieceID == 6 || pieceID == 7) && abs(px - selectedX) == 1 && sNew->layerCount <= 1)
-                                    {
-                                        m.isEnPassant = true;
-                                        Tile *epTile = &temp.tiles[selectedY][px];
-                                        m.capturedPieceID = epTile->layers[epTile->layerCount - 1];
-                                    }
-                                    else if(sNew->layerCount > 1) 
-                                    {
-                                         m.capturedPieceID = sNew->layers[sNew->layerCount-1];
-                                    }
-
-                                    // Faire le coup simulé
-                                    isSimulation = true;
-                                    MakeMove(&temp, m);
-                                    
-                                    // Si ce coup ne met pas mon Roi en échec, je l'ajoute à la liste affichée
-                                    if (!IsKingInCheck(&temp, currentTurn)) 
-                                    {
-                                        possibleMoves[possibleMoveCount][0] = px;
-                                        possibleMoves[possibleMoveCount][1] = py;
-                                        possibleMoveCount++;
-                                    }
-                                    isSimulation = false;
-                                }
+                                possibleMoves[possibleMoveCount][0] = sq % BOARD_COLS;
+                                possibleMoves[possibleMoveCount][1] = sq / BOARD_COLS;
+                                possibleMoveCount++;
                             }
                         }
-                        currentTurn = originalTurn; // Restaure le tour
                     }
                 }
             }
@@ -1213,11 +638,9 @@ static void GameLogicUpdate(Board *board, float dt)
 
                     PlaySound(gPieceSound);
 
-                    // On effectue le déplacement
-                    MakeMove(board, actualMove);
-
-                    // ✅ Maintenant seulement, on enregistre le coup final pour l'affichage
-                    board->lastMove = actualMove;
+                    // On effectue le déplacement (la pièce de promotion est choisie ensuite)
+                    // et on enregistre le coup final pour l'affichage
+                    ApplyMove(board, actualMove, PROMOTION_DEFERRED);
 
                     
                     // GESTION SPÉCIALE : PROMOTION
@@ -1233,14 +656,21 @@ static void GameLogicUpdate(Board *board, float dt)
                     }
                     else 
                     {
+                        HistoryRecord(game, actualMove, 0);
+
                         // Changement de tour (si la partie continue)
-                        if (board->state != STATE_GAMEOVER) 
+                        if (game->state != STATE_GAMEOVER) 
                         {
-                            currentTurn = 1 - currentTurn;
+                            board->sideToMove = 1 - board->sideToMove;
+                            ClockPress(game);
                         }
                     }
 
-                    if (board->state != STATE_GAMEOVER && promotionPending == 0 && IsKingInCheck(board, currentTurn))
+                    if (game->state != STATE_GAMEOVER && promotionPending == 0)
+                    {
+                        RefreshPositionCache(board);
+                    }
+                    if (game->state != STATE_GAMEOVER && promotionPending == 0 && cachedInCheck)
                     {
                         PlaySound(gCheckSound);
                         TraceLog(LOG_INFO, "ROI EN ECHEC !");
@@ -1248,8 +678,8 @@ static void GameLogicUpdate(Board *board, float dt)
                     // Vérification de victoire par capture de Roi
                     if (actualMove.capturedPieceID == 10 || actualMove.capturedPieceID == 11)
                     {
-                         board->winner = 1 - currentTurn; // L'adversaire du joueur qui vient de jouer
-                         board->state = STATE_GAMEOVER;
+                         game->winner = 1 - board->sideToMove; // L'adversaire du joueur qui vient de jouer
+                         game->state = STATE_GAMEOVER;
                          TraceLog(LOG_INFO, "ROI CAPTURE ! PARTIE TERMINEE");
                     }
 
@@ -1259,21 +689,21 @@ static void GameLogicUpdate(Board *board, float dt)
                     possibleMoveCount = 0; 
                     
                     // Lancement de l'IA si nécessaire
-                    if (currentTurn == ID_IA && board->mode == MODE_PLAYER_VS_IA && promotionPending == 0)
+                    if (board->sideToMove == ID_IA && game->mode == MODE_PLAYER_VS_IA && promotionPending == 0)
                     {
-                         board->IADelay = board->AIDefaultDelay; // Délai pour l'IA
+                         game->IADelay = game->AIDefaultDelay; // Délai pour l'IA
                     }
                 }
                 else 
                 {
                     // Si le coup est invalide, mais qu'on a cliqué sur une autre pièce à nous
                     // On change simplement la sélection
-                    if (clickedTile->layerCount > 1 && GetPieceColor(clickedTile->layers[clickedTile->layerCount-1]) == currentTurn) 
+                    if (clickedTile->layerCount > 1 && GetPieceColor(clickedTile->layers[clickedTile->layerCount-1]) == board->sideToMove) 
                     {
                         selectedX = -1; 
                         possibleMoveCount = 0;
                         // On force la re-sélection en appelant à nouveau la fonction
-                        GameLogicUpdate(board, dt); 
+                        GameLogicUpdate(game, dt); 
                         return;
                     }
                     // Si le coup est invalide et qu'on a cliqué sur une case vide ou un ennemi
@@ -1295,199 +725,229 @@ static void GameLogicUpdate(Board *board, float dt)
 
 // 8. MISE À JOUR PRINCIPALE (UPDATE)
 
-// Vérifie si le joueur a au moins UN coup légal qui sauve son Roi
-static bool HasLegalMoves(Board *board, int color)
-{
-    Move movelist[MAX_MOVES];
-    int count = GenerateLegalMoves(board, movelist, color);
-    return count > 0;
-}
 
-void GameUpdate(Board *board, float dt)
+void GameUpdate(Game *game, float dt)
 {
-    if (board->state == STATE_MAIN_MENU)
+    Board *board = &game->board;
+    frameClockNs += (uint64_t)((double)dt * 1e9);
+
+    if (game->state == STATE_MAIN_MENU)
     {
         // Gestion du clic pour choisir le mode de jeu
-        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
+        if (Input_MouseLeftPressed())
         {
-            Vector2 m = GetMousePosition();
-            int centerW = GetScreenWidth() / 2;
-            int centerH = GetScreenHeight() / 2;
+            Vector2 m = Input_MousePosition();
+            int centerW = Input_ScreenWidth() / 2;
+            int centerH = Input_ScreenHeight() / 2;
             
             // Bouton 1v1
             if (m.x > centerW - 150 && m.x < centerW + 150 && m.y > centerH - 60 && m.y < centerH - 60 + 50) 
             {
-                board->mode = MODE_PLAYER_VS_PLAYER;
-                board->state = STATE_TIME_MENU;
+                game->mode = MODE_PLAYER_VS_PLAYER;
+                game->state = STATE_TIME_MENU;
                 TraceLog(LOG_INFO, "Mode 1v1 sélectionné. Passage au menu du temps.");
             }
             // Bouton VS IA
             else if (m.x > centerW - 150 && m.x < centerW + 150 && m.y > centerH + 10 && m.y < centerH + 10 + 50) 
             {
-                board->state = STATE_DIFFICULTY_MENU;
+                game->state = STATE_DIFFICULTY_MENU;
                 TraceLog(LOG_INFO, "Transition vers le menu de difficulté IA.");
             }
         }
     }
-    else if (board->state == STATE_TIME_MENU)
+    else if (game->state == STATE_TIME_MENU)
     {
-        if (IsKeyPressed(KEY_ESCAPE))
+        if (Input_KeyPressed(KEY_ESCAPE))
         {
-            board->state = STATE_MAIN_MENU;
+            game->state = STATE_MAIN_MENU;
             return;
         }
-        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
+        if (Input_MouseLeftPressed())
         {
-            Vector2 m = GetMousePosition();
-            int centerW = GetScreenWidth() / 2;
-            int centerH = GetScreenHeight() / 2;
+            Vector2 m = Input_MousePosition();
+            int centerW = Input_ScreenWidth() / 2;
+            int centerH = Input_ScreenHeight() / 2;
 
             // 10 minutes
 
             if (m.x > centerW - 150 && m.x < centerW + 150 && m.y > centerH - 80 && m.y < centerH - 80 + 50)
             {
-                board->timer.blackTime = 600.0f;
-                board->timer.whiteTime = 600.0f;
-                board->mode = MODE_PLAYER_VS_PLAYER;
-                board->state = STATE_PLAYING;
+                GameClock_Init(&game->timer, GAMECLOCK_FISCHER, 600000, 0);
+                game->mode = MODE_PLAYER_VS_PLAYER;
+                game->state = STATE_PLAYING;
                 TraceLog(LOG_INFO, "10 minutes sélectionné");
             }
             // 3 minutes
 
             else if (m.x > centerW - 150 && m.x < centerW + 150 && m.y > centerH - 10 && m.y < centerH - 10 + 50)
             {
-                board->timer.blackTime = 180.0f;
-                board->timer.whiteTime = 180.0f;
-                board->mode = MODE_PLAYER_VS_PLAYER;
-                board->state = STATE_PLAYING;
+                GameClock_Init(&game->timer, GAMECLOCK_FISCHER, 180000, 0);
+                game->mode = MODE_PLAYER_VS_PLAYER;
+                game->state = STATE_PLAYING;
                 TraceLog(LOG_INFO, "3 minutes sélectionné");
             }
             // 1 minute
             else if (m.x > centerW - 150 && m.x < centerW + 150 && m.y > centerH + 60 && m.y < centerH + 60 + 50)
             {
-                board->timer.blackTime = 60.0f;
-                board->timer.whiteTime = 60.0f;
-                board->mode = MODE_PLAYER_VS_PLAYER;
-                board->state = STATE_PLAYING;
+                GameClock_Init(&game->timer, GAMECLOCK_FISCHER, 60000, 0);
+                game->mode = MODE_PLAYER_VS_PLAYER;
+                game->state = STATE_PLAYING;
                 TraceLog(LOG_INFO, "1 minute sélectionné");
             }
+            // 3 minutes + 2 secondes par coup
+            else if (m.x > centerW - 150 && m.x < centerW + 150 && m.y > centerH + 130 && m.y < centerH + 130 + 50)
+            {
+                GameClock_Init(&game->timer, GAMECLOCK_FISCHER, 180000, 2000);
+                game->mode = MODE_PLAYER_VS_PLAYER;
+                game->state = STATE_PLAYING;
+                TraceLog(LOG_INFO, "3 minutes + 2 secondes sélectionné");
+            }
+            // 5 minutes, délai de 3 secondes par coup
+            else if (m.x > centerW - 150 && m.x < centerW + 150 && m.y > centerH + 200 && m.y < centerH + 200 + 50)
+            {
+                GameClock_Init(&game->timer, GAMECLOCK_DELAY, 300000, 3000);
+                game->mode = MODE_PLAYER_VS_PLAYER;
+                game->state = STATE_PLAYING;
+                TraceLog(LOG_INFO, "5 minutes, délai de 3 secondes sélectionné");
+            }
         }
     }
-    else if(board->state == STATE_DIFFICULTY_MENU)
+    else if(game->state == STATE_DIFFICULTY_MENU)
     {
-        if (IsKeyPressed(KEY_ESCAPE))
+        if (Input_KeyPressed(KEY_ESCAPE))
         {
-            board->state = STATE_MAIN_MENU;
+            game->state = STATE_MAIN_MENU;
             return;
         }
-        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
+        if (Input_MouseLeftPressed())
         {
-            Vector2 m = GetMousePosition();
-            int centerW = GetScreenWidth() / 2;
-            int centerH = GetScreenHeight() / 2;
+            Vector2 m = Input_MousePosition();
+            int centerW = Input_ScreenWidth() / 2;
+            int centerH = Input_ScreenHeight() / 2;
 
             // Facile
             if (m.x > centerW - 150 && m.x < centerW + 150 && m.y > centerH - 80 && m.y < centerH - 80 + 50)
             {
-                board->difficulty = DIFF_EASY;
-                board->AIDepth = 1;
-                board->AIDefaultDelay = 3.0f;
-                board->mode = MODE_PLAYER_VS_IA;
-                board->state = STATE_PLAYING;
+                game->difficulty = DIFF_EASY;
+                game->AIDefaultDelay = 3.0f;
+                game->mode = MODE_PLAYER_VS_IA;
+                game->state = STATE_PLAYING;
                 TraceLog(LOG_INFO, "Difficulté : Facile");
             }
             // Intermédiaire
             else if (m.x > centerW - 150 && m.x < centerW + 150 && m.y >centerH - 10 && m.y < centerH - 10 + 50)
             {
-                board->difficulty = DIFF_MEDIUM;
-                board->AIDepth = 3;
-                board->AIDefaultDelay = 2.0f;
-                board->mode = MODE_PLAYER_VS_IA;
-                board->state = STATE_PLAYING;
+                game->difficulty = DIFF_MEDIUM;
+                game->AIDefaultDelay = 2.0f;
+                game->mode = MODE_PLAYER_VS_IA;
+                game->state = STATE_PLAYING;
                 TraceLog(LOG_INFO, "Difficulté : Intermédiaire");
             }
             // Difficile
             else if (m.x > centerW - 150 && m.x < centerW + 150 && m.y > centerH + 60 && m.y < centerH + 60 + 50)
             {
-                board->difficulty = DIFF_HARD;
-                board->AIDepth = 5;
-                board->AIDefaultDelay = 1.0f;
-                board->mode = MODE_PLAYER_VS_IA;
-                board->state = STATE_PLAYING;
+                game->difficulty = DIFF_HARD;
+                game->AIDefaultDelay = 1.0f;
+                game->mode = MODE_PLAYER_VS_IA;
+                game->state = STATE_PLAYING;
                 TraceLog(LOG_INFO, "Difficulté : Difficile");
             }
         }
     }
-    else if (board->state == STATE_PLAYING)
+    else if (game->state == STATE_PLAYING)
     {
-        // GESTION DU TEMPS
-        if (currentTurn == 0) {
-            if (board->timer.whiteTime > 0.0f) board->timer.whiteTime -= dt; 
-        } else {
-            if (board->timer.blackTime > 0.0f) board->timer.blackTime -= dt; 
-        }
+        // GESTION DU TEMPS : la pendule du camp au trait part à la première image de la partie,
+        // ensuite seuls les coups la font basculer (ClockPress)
+        uint64_t now = GameNowNs();
+        if (!GameClock_IsRunning(&game->timer)) GameClock_Start(&game->timer, board->sideToMove, now);
 
         // VÉRIFICATION DÉFAITE PAR TEMPS 
-        if (board->timer.whiteTime <= 0.0f) {
-            board->state = STATE_GAMEOVER; 
-            board->winner = 1; // Noirs gagnent
+        if (GameClock_Flagged(&game->timer, 0, now)) {
+            game->state = STATE_GAMEOVER; 
+            game->winner = 1; // Noirs gagnent
             TraceLog(LOG_WARNING, "GAME OVER - Temps BLANC écoulé !");
             return;
         }
-        if (board->timer.blackTime <= 0.0f) {
-            board->state = STATE_GAMEOVER; 
-            board->winner = 0; // Blancs gagnent
+        if (GameClock_Flagged(&game->timer, 1, now)) {
+            game->state = STATE_GAMEOVER; 
+            game->winner = 0; // Blancs gagnent
             TraceLog(LOG_WARNING, "GAME OVER - Temps NOIR écoulé !");
             return;
         }
         
+        // HISTORIQUE : revue et retour arrière, aussi pendant le tour de l'IA
+        if (promotionPending == 0)
+        {
+            HistoryNavigate(game);
+            if (Input_KeyPressed(KEY_BACKSPACE)) HistoryTakeback(game);
+        }
+
         // LOGIQUE IA 
-        if (board->mode == MODE_PLAYER_VS_IA && currentTurn == ID_IA)
+        if (game->mode == MODE_PLAYER_VS_IA && board->sideToMove == ID_IA)
         {
-             AIMakeMove(board, dt);
+             PROF_BEGIN(AIMakeMove);
+             AIMakeMove(game, dt);
+             PROF_END(AIMakeMove);
              return; // L'IA prend le contrôle total du tour
         }
         
         
+        // ANALYSE (partie à deux)
+        if (game->mode == MODE_PLAYER_VS_PLAYER) AnalysisUpdate(game);
+
         // GESTION ABANDON (FORFAIT) 
-        if (IsKeyPressed(KEY_F))
+        if (Input_KeyPressed(KEY_F))
         {
-            board->state = STATE_GAMEOVER;
-            board->winner = 1 - currentTurn; // Le gagnant est l'adversaire
-            TraceLog(LOG_WARNING, "Le joueur %s a déclaré forfait (F).", (currentTurn == 0) ? "BLANC" : "NOIR");
+            game->state = STATE_GAMEOVER;
+            game->winner = 1 - board->sideToMove; // Le gagnant est l'adversaire
+            TraceLog(LOG_WARNING, "Le joueur %s a déclaré forfait (F).", (board->sideToMove == 0) ? "BLANC" : "NOIR");
             return;
         }
 
         // DETECTION DE FIN DE PARTIE (MAT / PAT) 
-        if (promotionPending == 0 && !HasLegalMoves(board, currentTurn))
+        if (promotionPending == 0)
+        {
+            RefreshPositionCache(board);
+        }
+        if (promotionPending == 0 && cachedMoveCount == 0)
         {
-            bool check = IsKingInCheck(board, currentTurn);
+            bool check = cachedInCheck;
             
-            board->state = STATE_GAMEOVER;
+            game->state = STATE_GAMEOVER;
             
             if (check) 
             {
-                board->winner = 1 - currentTurn; // Mat: L'adversaire gagne
+                game->winner = 1 - board->sideToMove; // Mat: L'adversaire gagne
                 TraceLog(LOG_INFO, "ECHEC ET MAT !");
             } 
             else 
             {
-                board->winner = -1; // Pat: Nul
+                game->winner = -1; // Pat: Nul
                 TraceLog(LOG_INFO, "PAT (Match Nul) !");
             }
             return;
         }
 
-        // Mise à jour de la logique de jeu (Souris, etc.)
-        GameLogicUpdate(board, dt);
+        // Mise à jour de la logique de jeu (Souris, etc.), sauf en revue d'une position passée
+        if (game->viewPly >= 0) return;
+        PROF_BEGIN(GameLogicUpdate);
+        GameLogicUpdate(game, dt);
+        PROF_END(GameLogicUpdate);
     }
     // Si la partie est terminée
-    else if (board->state == STATE_GAMEOVER)
+    else if (game->state == STATE_GAMEOVER)
     {
+        Ponder_Stop(); // Forfait ou temps écoulé pendant le tour du joueur (ou de l'IA, par tranches)
+        SliceSearch_Abort();
+        if (GameClock_IsRunning(&game->timer)) GameClock_Stop(&game->timer, GameNowNs());
+
+        // Revue de la partie terminée : l'analyse (A) est possible dans tous les modes
+        HistoryNavigate(game);
+        AnalysisUpdate(game);
         // Touche R pour recommencer ou clic sur le bouton "Rejouer"
-        if (IsKeyPressed(KEY_R)) 
+        if (Input_KeyPressed(KEY_R)) 
         {
-            GameInit(board);
+            GameInit(game);
             TraceLog(LOG_INFO, "Nouvelle partie lancée.");
         }
     }
@@ -1495,101 +955,337 @@ void GameUpdate(Board *board, float dt)
 
 // 9. DESSIN
 
-void GameDraw(Board *board)
+// Pendule affichée : mm:ss, puis secondes et dixièmes sous 20 secondes
+static const char *ClockText(const char *name, int64_t ms)
 {
-    int screenW = GetScreenWidth(); 
-    int screenH = GetScreenHeight();
-    const int FONT_SIZE = 30; 
-    const int TEXT_PADDING = 20;
+    if (ms < 20000) return TextFormat("%s\n%02d.%d", name, (int)(ms / 1000), (int)(ms / 100 % 10));
+    return TextFormat("%s\n%02d:%02d", name, (int)(ms / 60000), (int)(ms / 1000 % 60));
+}
 
-    // Calcul taille dynamique
-    int tileSizeW = screenW / BOARD_COLS;
-    int tileSizeH = screenH / BOARD_ROWS;
-    int tileSize = (tileSizeW < tileSizeH) ? tileSizeW : tileSizeH;
-    
+// Panneau d'infos moteur : source du coup, profondeur, noeuds, vitesse, coupures et variante principale
+static void DrawEnginePanel(int screenH)
+{
+    const SearchStats *st = GetLastSearchStats();
+    if (st->source == SEARCH_SOURCE_NONE) return;
+
+    const int x = 10;
+    const int lineH = 16;
+    int y = screenH - 7 * lineH - 10;
+    DrawRectangle(x - 4, y - 4, 300, 7 * lineH + 8, Fade(BLACK, 0.6f));
+
+    DrawText(TextFormat("IA : %s   %.0f ms", SearchSourceName(st->source), st->totalMs), x, y, 14, RAYWHITE);
+    y += lineH;
+    if (st->iterationCount == 0)
+    {
+        if (st->totalNodes > 0) DrawText(TextFormat("%ld noeuds", st->totalNodes), x, y, 14, LIGHTGRAY);
+        return;
+    }
+
+    const SearchIteration *it = &st->iterations[st->iterationCount - 1];
+    double nps = (st->totalMs > 0.0) ? st->totalNodes * 1000.0 / st->totalMs : 0.0;
+    DrawText(TextFormat("Profondeur %d   score %+d", it->depth, st->score), x, y, 14, LIGHTGRAY);
+    y += lineH;
+    DrawText(TextFormat("%ld noeuds   %.0f k/s", st->totalNodes, nps / 1000.0), x, y, 14, LIGHTGRAY);
+    y += lineH;
+    DrawText(TextFormat("Branchement %.1f   TT %.0f%%", it->branchingFactor,
+        (it->ttProbes > 0) ? 100.0 * it->ttHits / it->ttProbes : 0.0), x, y, 14, LIGHTGRAY);
+    y += lineH;
+    DrawText(TextFormat("Coupures %ld   1er coup %.0f%%", it->betaCutoffs,
+        (it->betaCutoffs > 0) ? 100.0 * it->firstMoveCutoffs / it->betaCutoffs : 0.0), x, y, 14, LIGHTGRAY);
+    y += lineH;
+
+    char line[SEARCH_MAX_PV * 5 + 8] = "PV :";
+    int length = 4;
+    for (int i = 0; i < it->pvLength && i < 8; i++)
+    {
+        char text[6];
+        MoveToString(it->pv[i], text);
+        length += snprintf(line + length, sizeof(line) - (size_t)length, " %s", text);
+    }
+    DrawText(line, x, y, 14, LIGHTGRAY);
+}
+
+// Score lisible : "+0.35" en pions, "M3" pour un mat (distance estimée par la variante)
+static const char *ScoreText(int score, const char *line)
+{
+    if (score >= INFINITY || score <= -INFINITY)
+    {
+        int plies = 1;
+        for (const char *c = line; *c != '\0'; c++) if (*c == ' ') plies++;
+        return TextFormat("%sM%d", (score > 0) ? "+" : "-", (plies + 1) / 2);
+    }
+    return TextFormat("%+.2f", score / 100.0);
+}
+
+// Barre d'évaluation le long du plateau : part des Blancs en bas (±10 pions = barre pleine)
+static void DrawEvalBar(const AnalysisInfo *info, int offsetX, int offsetY, int boardH)
+{
+    const int width = 8;
+    int x = (offsetX >= width + 2) ? offsetX - width - 2 : 0;
+    int score = info->lines[0].score;
+    float white = 0.5f + score / 2000.0f;
+    if (score >= INFINITY) white = 1.0f;
+    if (score <= -INFINITY) white = 0.0f;
+    if (white < 0.02f) white = 0.02f;
+    if (white > 0.98f) white = 0.98f;
+
+    int whiteH = (int)(boardH * white);
+    DrawRectangle(x, offsetY, width, boardH - whiteH, DARKGRAY);
+    DrawRectangle(x, offsetY + boardH - whiteH, width, whiteH, RAYWHITE);
+    DrawRectangleLines(x, offsetY, width, boardH, GRAY);
+}
+
+// Flèche d'un coup, de la case de départ à la case d'arrivée
+static void DrawMoveArrow(Move move, int tileSize, int offsetX, int offsetY, Color color)
+{
+    Vector2 from = { offsetX + (move.startX + 0.5f) * tileSize, offsetY + (move.startY + 0.5f) * tileSize };
+    Vector2 to = { offsetX + (move.endX + 0.5f) * tileSize, offsetY + (move.endY + 0.5f) * tileSize };
+    float dx = to.x - from.x;
+    float dy = to.y - from.y;
+    float length = sqrtf(dx * dx + dy * dy);
+    if (length < 1.0f) return;
+    dx /= length;
+    dy /= length;
+
+    float head = tileSize * 0.35f;
+    Vector2 base = { to.x - dx * head, to.y - dy * head };
+    DrawLineEx(from, base, tileSize * 0.12f, color);
+    // Pointe : sommets dans le sens inverse des aiguilles d'une montre (raylib)
+    Vector2 left = { base.x + dy * head * 0.6f, base.y - dx * head * 0.6f };
+    Vector2 right = { base.x - dy * head * 0.6f, base.y + dx * head * 0.6f };
+    DrawTriangle(to, left, right, color);
+}
+
+// Panneau d'analyse : profondeur, vitesse et meilleures variantes (partie à deux)
+static void DrawAnalysisPanel(const AnalysisInfo *info, int screenH)
+{
+    const int x = 10;
+    const int lineH = 16;
+    int rows = 1 + info->lineCount;
+    int y = screenH - rows * lineH - 10;
+    DrawRectangle(x - 4, y - 4, 420, rows * lineH + 8, Fade(BLACK, 0.6f));
+
+    DrawText(TextFormat("Analyse : profondeur %d   %.0f k/s   (A : arrêter, H : flèches)", info->depth, info->nps / 1000.0),
+        x, y, 14, RAYWHITE);
+    for (int i = 0; i < info->lineCount; i++)
+    {
+        y += lineH;
+        const AnalysisLine *line = &info->lines[i];
+        DrawText(TextFormat("%-6s %s", ScoreText(line->score, line->text), line->text), x, y, 14, (i == 0) ? RAYWHITE : LIGHTGRAY);
+    }
+}
+
+// Dessine une case ou une pièce depuis l'atlas (même texture pour tout le plateau : un seul lot)
+static void DrawSprite(int id, Rectangle dest)
+{
+    DrawTexturePro(gSpriteAtlas, gSpriteRects[id], dest, (Vector2){ 0, 0 }, 0, WHITE);
+}
+
+// Couche statique du plateau, rendue dans une texture et réutilisée d'une image à l'autre.
+// Elle n'est redessinée qu'après un coup, un changement de taille de fenêtre ou d'état.
+static RenderTexture2D boardLayer = { 0 };
+static bool boardLayerValid = false;
+static unsigned int boardLayerVersion = 0;
+static int boardLayerTurn = -1;
+static GameState boardLayerState = STATE_MAIN_MENU;
+static unsigned int boardLayerView = 0;
+
+static void DrawBoardLayer(Game *game, int screenW, int screenH, int tileSize, int offsetX, int offsetY)
+{
+    const Board *board = DisplayedBoard(game);
     int boardW = tileSize * BOARD_COLS;
     int boardH = tileSize * BOARD_ROWS;
-    int offsetX = (screenW - boardW) / 2; 
-    int offsetY = (screenH - boardH) / 2; 
 
-    // ÉCRAN PRINCIPAL (Plateau, Timers)
-    if (board->state == STATE_PLAYING || board->state == STATE_GAMEOVER)
+    Rectangle sourceRec = { 0.0f, 0.0f, (float)gMenuBackground.width, (float)gMenuBackground.height };
+    Rectangle destRec = { 0.0f, 0.0f, (float)screenW, (float)screenH };
+    Vector2 origin = { 0.0f, 0.0f };
+    DrawTexturePro(gMenuBackground, sourceRec, destRec, origin, 0.0f, WHITE);
+    
+    // DESSIN DU PLATEAU ET DES PIÈCES
+    for (int y = 0; y < BOARD_ROWS; y++) 
     {
-        Rectangle sourceRec = { 0.0f, 0.0f, (float)gMenuBackground.width, (float)gMenuBackground.height };
-        Rectangle destRec = { 0.0f, 0.0f, (float)screenW, (float)screenH };
-        Vector2 origin = { 0.0f, 0.0f };
-        DrawTexturePro(gMenuBackground, sourceRec, destRec, origin, 0.0f, WHITE);
-        
-        // DESSIN DU PLATEAU ET DES PIÈCES
-        for (int y = 0; y < BOARD_ROWS; y++) 
+        for (int x = 0; x < BOARD_COLS; x++) 
         {
-            for (int x = 0; x < BOARD_COLS; x++) 
-            {
-                const Tile *t = &board->tiles[y][x];
-                int dX = offsetX + x * tileSize; 
-                int dY = offsetY + y * tileSize;
+            const Tile *t = &board->tiles[y][x];
+            int dX = offsetX + x * tileSize; 
+            int dY = offsetY + y * tileSize;
 
-                if (t->layerCount > 0)
-                {
-                     DrawTexturePro(
-                        gTileTextures[t->layers[0]], // On prend toujours le sol
-                        (Rectangle){0, 0, gTileTextures[t->layers[0]].width, gTileTextures[t->layers[0]].height},
-                        (Rectangle){(float)dX, (float)dY, (float)tileSize, (float)tileSize},
-                        (Vector2){0,0}, 0, WHITE
-                    ); 
-                }
-                
-                // Vérifie si un coup valide a été enregistré (movingPieceID != -1)
-                if (board->lastMove.movingPieceID != -1)
+            if (t->layerCount > 0)
+            {
+                DrawSprite(t->layers[0], (Rectangle){(float)dX, (float)dY, (float)tileSize, (float)tileSize}); // On prend toujours le sol
+            }
+            
+            // Vérifie si un coup valide a été enregistré (movingPieceID != -1)
+            if (board->lastMove.movingPieceID != -1)
+            {
+                // Surlignage de la case de DÉPART du dernier coup
+                if (x == board->lastMove.startX && y == board->lastMove.startY)
                 {
-                    // Surlignage de la case de DÉPART du dernier coup
-                    if (x == board->lastMove.startX && y == board->lastMove.startY)
-                    {
-                        DrawRectangle(dX, dY, tileSize, tileSize, Fade(YELLOW, 0.3f)); 
-                    }
-
-                    // Surlignage de la case d'ARRIVÉE du dernier coup
-                    if (x == board->lastMove.endX && y == board->lastMove.endY)
-                    {
-                        DrawRectangle(dX, dY, tileSize, tileSize, Fade(YELLOW, 0.3f)); 
-                    }
+                    DrawRectangle(dX, dY, tileSize, tileSize, Fade(YELLOW, 0.3f)); 
                 }
 
-                // 3. Dessin des PIÈCES (Couche 1, 2, 3...)
-                // Nous ne commençons qu'à l'index 1 (après le sol) s'il y a d'autres couches
-                for (int i = 1; i < t->layerCount; i++) 
+                // Surlignage de la case d'ARRIVÉE du dernier coup
+                if (x == board->lastMove.endX && y == board->lastMove.endY)
                 {
-                    int idx = t->layers[i];
-                    
-                    DrawTexturePro(
-                        gTileTextures[idx],
-                        (Rectangle){0, 0, gTileTextures[idx].width, gTileTextures[idx].height},
-                        (Rectangle){(float)dX, (float)dY, (float)tileSize, (float)tileSize},
-                        (Vector2){0,0}, 0, WHITE
-                    ); 
+                    DrawRectangle(dX, dY, tileSize, tileSize, Fade(YELLOW, 0.3f)); 
                 }
-                // 4. Bordure grise discrète
-                DrawRectangleLines(dX, dY, tileSize, tileSize, Fade(DARKGRAY, 0.3f));
             }
+
+            // 3. Dessin des PIÈCES (Couche 1, 2, 3...)
+            // Nous ne commençons qu'à l'index 1 (après le sol) s'il y a d'autres couches
+            for (int i = 1; i < t->layerCount; i++) 
+            {
+                int idx = t->layers[i];
+                
+                DrawSprite(idx, (Rectangle){(float)dX, (float)dY, (float)tileSize, (float)tileSize}); 
+            }
+            // 4. Bordure grise discrète
+            DrawRectangleLines(dX, dY, tileSize, tileSize, Fade(DARKGRAY, 0.3f));
         }
+    }
 
-        // INDICATEUR VISUEL D'ECHEC (Carré Rouge sous le Roi)
-        if (board->state == STATE_PLAYING && IsKingInCheck(board, currentTurn)) 
+    // INDICATEUR VISUEL D'ECHEC (Carré Rouge sous le Roi) : position en cours ou position revue
+    bool inCheck = false;
+    if (game->viewPly >= 0)
+    {
+        inCheck = IsKingInCheck(board, board->sideToMove);
+    }
+    else if (game->state == STATE_PLAYING)
+    {
+        RefreshPositionCache(&game->board);
+        inCheck = cachedInCheck;
+    }
+    if (inCheck) 
+    {
+        int kingID = (board->sideToMove == 0) ? 10 : 11;
+        
+        for(int y = 0; y < BOARD_ROWS; y++) 
         {
-            int kingID = (currentTurn == 0) ? 10 : 11;
-            
-            for(int y = 0; y < BOARD_ROWS; y++) 
+            for(int x = 0; x < BOARD_COLS; x++) 
             {
-                for(int x = 0; x < BOARD_COLS; x++) 
+                const Tile *t = &board->tiles[y][x];
+                if(t->layerCount > 1 && t->layers[t->layerCount-1] == kingID) 
                 {
-                    const Tile *t = &board->tiles[y][x];
-                    if(t->layerCount > 1 && t->layers[t->layerCount-1] == kingID) 
-                    {
-                        DrawRectangle(offsetX + x * tileSize, offsetY + y * tileSize, tileSize, tileSize, Fade(RED, 0.6f));
-                    }
+                    DrawRectangle(offsetX + x * tileSize, offsetY + y * tileSize, tileSize, tileSize, Fade(RED, 0.6f));
                 }
             }
         }
+    }
+
+    // --- NOUVEAU : DESSIN DES PIÈCES CAPTURÉES ---
+    float capturedScale = 0.6f; // Taille réduite (60%)
+    int capturedSize = (int)(tileSize * capturedScale);
+    int capturedMargin = 10;
+    
+    // 1. CAPTURES DES BLANCS (A gauche, empilées de bas en haut)
+    // Position X : A gauche du plateau
+    int whiteCaptX = offsetX - capturedSize - capturedMargin;
+    // Position Y de départ : Bas du plateau
+    int whiteCaptYStart = offsetY + boardH - capturedSize;
+
+    for (int i = 0; i < board->capturedByWhiteCount; i++)
+    {
+        int pieceID = board->capturedByWhite[i];
+        // On empile vers le haut (soustraction en Y)
+        int dY = whiteCaptYStart - (int)(i * (capturedSize * 0.7f)); // Chevauchement léger
+        
+        DrawSprite(pieceID, (Rectangle){(float)whiteCaptX, (float)dY, (float)capturedSize, (float)capturedSize});
+    }
+
+    // 2. CAPTURES DES NOIRS (A droite, empilées de haut en bas)
+    // Position X : A droite du plateau
+    int blackCaptX = offsetX + boardW + capturedMargin;
+    // Position Y de départ : Haut du plateau
+    int blackCaptYStart = offsetY;
+
+    for (int i = 0; i < board->capturedByBlackCount; i++)
+    {
+        int pieceID = board->capturedByBlack[i];
+        // On empile vers le bas (addition en Y)
+        int dY = blackCaptYStart + (int)(i * (capturedSize * 0.7f)); 
+        
+        DrawSprite(pieceID, (Rectangle){(float)blackCaptX, (float)dY, (float)capturedSize, (float)capturedSize});
+    }
+    // ---------------------------------------------
+}
+
+static void UpdateBoardLayer(Game *game, int screenW, int screenH, int tileSize, int offsetX, int offsetY)
+{
+    const Board *board = DisplayedBoard(game);
+    if (boardLayer.id == 0 || boardLayer.texture.width != screenW || boardLayer.texture.height != screenH)
+    {
+        if (boardLayer.id != 0) UnloadRenderTexture(boardLayer);
+        boardLayer = LoadRenderTexture(screenW, screenH);
+        boardLayerValid = false;
+    }
+
+    if (boardLayerValid && boardLayerVersion == board->version && boardLayerTurn == board->sideToMove
+        && boardLayerState == game->state && boardLayerView == viewSerial)
+    {
+        return;
+    }
+
+    PROF_BEGIN(DrawBoardLayer);
+    BeginTextureMode(boardLayer);
+    ClearBackground(BLACK);
+    DrawBoardLayer(game, screenW, screenH, tileSize, offsetX, offsetY);
+    EndTextureMode();
+    PROF_END(DrawBoardLayer);
+
+    boardLayerValid = true;
+    boardLayerVersion = board->version;
+    boardLayerTurn = board->sideToMove;
+    boardLayerState = game->state;
+    boardLayerView = viewSerial;
+}
+
+void GameUnload(void)
+{
+    if (boardLayer.id != 0) UnloadRenderTexture(boardLayer);
+    boardLayer = (RenderTexture2D){ 0 };
+    boardLayerValid = false;
+}
+
+// Bandeau de revue : coup affiché et touches utiles
+static void DrawHistoryBanner(const Game *game, int screenW)
+{
+    int ply = game->viewPly;
+    const char *moveText = (ply == 0) ? "Position de départ"
+        : TextFormat("%d.%s %s", (ply + 1) / 2, (ply % 2 == 1) ? "" : "..", viewMoveText);
+    const char *title = TextFormat("Revue : %s   (%d / %d)", moveText, ply, game->history.count);
+    const char *keys = (game->state == STATE_PLAYING) ? "Flèches, Début, Fin : naviguer   Retour arrière : reprendre d'ici"
+                                                      : "Flèches, Début, Fin : naviguer   A : analyse";
+    DrawRectangle(0, 0, screenW, 48, Fade(BLACK, 0.6f));
+    DrawText(title, screenW / 2 - MeasureText(title, 20) / 2, 4, 20, RAYWHITE);
+    DrawText(keys, screenW / 2 - MeasureText(keys, 14) / 2, 28, 14, LIGHTGRAY);
+}
+
+void GameDraw(Game *game)
+{
+    Board *board = &game->board;
+    int screenW = GetScreenWidth(); 
+    int screenH = GetScreenHeight();
+    const int FONT_SIZE = 30; 
+    const int TEXT_PADDING = 20;
+
+    // Calcul taille dynamique
+    int tileSizeW = screenW / BOARD_COLS;
+    int tileSizeH = screenH / BOARD_ROWS;
+    int tileSize = (tileSizeW < tileSizeH) ? tileSizeW : tileSizeH;
+    
+    int boardW = tileSize * BOARD_COLS;
+    int boardH = tileSize * BOARD_ROWS;
+    int offsetX = (screenW - boardW) / 2; 
+    int offsetY = (screenH - boardH) / 2; 
+
+    // ÉCRAN PRINCIPAL (Plateau, Timers)
+    if (game->state == STATE_PLAYING || game->state == STATE_GAMEOVER)
+    {
+        // Fond, plateau, pièces et pièces capturées : image en cache, redessinée seulement si besoin
+        UpdateBoardLayer(game, screenW, screenH, tileSize, offsetX, offsetY);
+        DrawTextureRec(boardLayer.texture,
+            (Rectangle){ 0.0f, 0.0f, (float)boardLayer.texture.width, -(float)boardLayer.texture.height }, // Image retournée (OpenGL)
+            (Vector2){ 0.0f, 0.0f }, WHITE);
 
         // DESSIN DES COUPS POSSIBLES (Aide visuelle)
         // --- NOUVEAU : Identification si la pièce sélectionnée est un Pion ---
@@ -1612,7 +1308,7 @@ void GameDraw(Board *board)
             const Tile *t = &board->tiles[y][x];
             
             // Si c'est un ennemi -> Carré rouge
-            if (t->layerCount > 1 && GetPieceColor(t->layers[t->layerCount - 1]) != currentTurn) 
+            if (t->layerCount > 1 && GetPieceColor(t->layers[t->layerCount - 1]) != board->sideToMove) 
             {
                 DrawRectangleLinesEx((Rectangle){(float)dX, (float)dY, (float)tileSize, (float)tileSize}, 5, Fade(RED, 0.6f));
             }
@@ -1639,64 +1335,35 @@ void GameDraw(Board *board)
             ); 
         }
         
-        // --- NOUVEAU : DESSIN DES PIÈCES CAPTURÉES ---
-        float capturedScale = 0.6f; // Taille réduite (60%)
-        int capturedSize = (int)(tileSize * capturedScale);
-        int capturedMargin = 10;
+        // DESSIN DES TIMERS
+        int centerTextY = offsetY + boardH / 2 - FONT_SIZE / 2;
         
-        // 1. CAPTURES DES BLANCS (A gauche, empilées de bas en haut)
-        // Position X : A gauche du plateau
-        int whiteCaptX = offsetX - capturedSize - capturedMargin;
-        // Position Y de départ : Bas du plateau
-        int whiteCaptYStart = offsetY + boardH - capturedSize;
+        uint64_t now = GameNowNs();
+        Color whiteColor = (board->sideToMove == 0 && game->state == STATE_PLAYING) ? RAYWHITE : DARKGRAY;
+        DrawText(ClockText("BLANCS", GameClock_RemainingMs(&game->timer, 0, now)), offsetX - MeasureText("BLANCS", FONT_SIZE) - TEXT_PADDING, centerTextY, FONT_SIZE, whiteColor); 
 
-        for (int i = 0; i < board->capturedByWhiteCount; i++)
-        {
-            int pieceID = board->capturedByWhite[i];
-            // On empile vers le haut (soustraction en Y)
-            int dY = whiteCaptYStart - (int)(i * (capturedSize * 0.7f)); // Chevauchement léger
-            
-            DrawTexturePro(
-                gTileTextures[pieceID],
-                (Rectangle){0, 0, gTileTextures[pieceID].width, gTileTextures[pieceID].height},
-                (Rectangle){(float)whiteCaptX, (float)dY, (float)capturedSize, (float)capturedSize},
-                (Vector2){0,0}, 0, WHITE
-            );
-        }
+        Color blackColor = (board->sideToMove == 1 && game->state == STATE_PLAYING) ? RAYWHITE : DARKGRAY;
+        DrawText(ClockText("NOIRS", GameClock_RemainingMs(&game->timer, 1, now)), offsetX + boardW + TEXT_PADDING, centerTextY, FONT_SIZE, blackColor); 
 
-        // 2. CAPTURES DES NOIRS (A droite, empilées de haut en bas)
-        // Position X : A droite du plateau
-        int blackCaptX = offsetX + boardW + capturedMargin;
-        // Position Y de départ : Haut du plateau
-        int blackCaptYStart = offsetY;
+        // Infos moteur (contre l'IA) : dernière décision de l'IA
+        if (game->mode == MODE_PLAYER_VS_IA) DrawEnginePanel(screenH);
 
-        for (int i = 0; i < board->capturedByBlackCount; i++)
+        // Analyse (partie à deux) : dernier résultat publié, jamais d'attente sur la recherche
+        AnalysisInfo info;
+        if (analysisEnabled && Analysis_GetInfo(&info) && info.positionId == analysisPositionId)
         {
-            int pieceID = board->capturedByBlack[i];
-            // On empile vers le bas (addition en Y)
-            int dY = blackCaptYStart + (int)(i * (capturedSize * 0.7f)); 
-            
-            DrawTexturePro(
-                gTileTextures[pieceID],
-                (Rectangle){0, 0, gTileTextures[pieceID].width, gTileTextures[pieceID].height},
-                (Rectangle){(float)blackCaptX, (float)dY, (float)capturedSize, (float)capturedSize},
-                (Vector2){0,0}, 0, WHITE
-            );
+            DrawEvalBar(&info, offsetX, offsetY, boardH);
+            if (analysisArrows)
+            {
+                for (int i = info.lineCount - 1; i >= 0; i--)
+                {
+                    DrawMoveArrow(info.lines[i].move, tileSize, offsetX, offsetY, Fade((i == 0) ? GREEN : SKYBLUE, (i == 0) ? 0.8f : 0.45f));
+                }
+            }
+            DrawAnalysisPanel(&info, screenH);
         }
-        // ---------------------------------------------
 
-        // DESSIN DES TIMERS
-        int centerTextY = offsetY + boardH / 2 - FONT_SIZE / 2;
-        
-        Color whiteColor = (currentTurn == 0 && board->state == STATE_PLAYING) ? RAYWHITE : DARKGRAY;
-        int whiteM = (int)board->timer.whiteTime / 60;
-        int whiteS = (int)board->timer.whiteTime % 60;
-        DrawText(TextFormat("BLANCS\n%02d:%02d", whiteM, whiteS), offsetX - MeasureText("BLANCS", FONT_SIZE) - TEXT_PADDING, centerTextY, FONT_SIZE, whiteColor); 
-
-        Color blackColor = (currentTurn == 1 && board->state == STATE_PLAYING) ? RAYWHITE : DARKGRAY;
-        int blackM = (int)board->timer.blackTime / 60;
-        int blackS = (int)board->timer.blackTime % 60;
-        DrawText(TextFormat("NOIRS\n%02d:%02d", blackM, blackS), offsetX + boardW + TEXT_PADDING, centerTextY, FONT_SIZE, blackColor); 
+        if (game->viewPly >= 0) DrawHistoryBanner(game, screenW);
     }
 
     // MENU DE PROMOTION (Superposé)
@@ -1711,22 +1378,22 @@ void GameDraw(Board *board)
         DrawText(opts, screenW/2 - MeasureText(opts, 20)/2, screenH/2, 20, WHITE);
     }
 
-    // ECRAN DE FIN DE PARTIE (Game Over)
-    if (board->state == STATE_GAMEOVER)
+    // ECRAN DE FIN DE PARTIE (Game Over), masqué pendant la revue de la partie
+    if (game->state == STATE_GAMEOVER && game->viewPly < 0)
     {
         DrawRectangle(0, 0, screenW, screenH, Fade(BLACK, 0.85f)); 
         
         const char *txt; 
         Color c;
         
-        if (board->winner == -1) 
+        if (game->winner == -1) 
         { 
             txt = "MATCH NUL (PAT)"; 
             c = BLUE; 
         }
         else 
         { 
-            txt = (board->winner == 0) ? "VICTOIRE BLANCS !" : "VICTOIRE NOIRS !"; 
+            txt = (game->winner == 0) ? "VICTOIRE BLANCS !" : "VICTOIRE NOIRS !"; 
             c = GREEN; 
         }
         
@@ -1749,17 +1416,19 @@ void GameDraw(Board *board)
         DrawRectangleRoundedLines(replayButton, 0.25f, 8, RAYWHITE);
 
         DrawText( replayText, replayButton.x + padding, replayButton.y + padding, fontSize, RAYWHITE );
-        if (CheckCollisionPointRec(GetMousePosition(), replayButton) && IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
+        if (Input_MouseLeftPressed() && CheckCollisionPointRec(Input_MousePosition(), replayButton))
         {
-            GameInit(board);
+            GameInit(game);
         }
 
 
         DrawText("Appuyer sur ECHAP pour quitter", screenW/2 - MeasureText("Appuyer sur ECHAP pour quitter", 20)/2, screenH/2 + 100, 20, RAYWHITE);
+        const char *reviewText = "Flèches : revoir la partie";
+        DrawText(reviewText, screenW/2 - MeasureText(reviewText, 20)/2, screenH/2 + 130, 20, LIGHTGRAY);
     }
     
     // ÉCRAN MENU PRINCIPAL
-    else if (board->state == STATE_MAIN_MENU)
+    else if (game->state == STATE_MAIN_MENU)
     {
         int centerW = screenW / 2;
         int centerH = screenH / 2;
@@ -1790,7 +1459,7 @@ void GameDraw(Board *board)
     }
 
     // Menu de difficulté IA
-    else if (board->state == STATE_DIFFICULTY_MENU)
+    else if (game->state == STATE_DIFFICULTY_MENU)
     {
         int centerW = screenW / 2;
         int centerH = screenH / 2;
@@ -1822,7 +1491,7 @@ void GameDraw(Board *board)
         DrawText(backText, centerW - MeasureText(backText, 20)/2, screenH - 50, 20, DARKGRAY);
     }
     // Menu de choix temps
-    else if (board->state == STATE_TIME_MENU)
+    else if (game->state == STATE_TIME_MENU)
     {
         int centerW = screenW / 2;
         int centerH = screenH / 2;
@@ -1850,7 +1519,15 @@ void GameDraw(Board *board)
         DrawRectangleLines(centerW - 150, centerH + 60, 300, 50, YELLOW);
         DrawText(uneminText, centerW - MeasureText(uneminText, 25)/2, centerH + 70,25, RAYWHITE);
 
+        const char *fischerText = "3 min + 2 s";
+        DrawRectangleLines(centerW - 150, centerH + 130, 300, 50, YELLOW);
+        DrawText(fischerText, centerW - MeasureText(fischerText, 25)/2, centerH + 140,25, RAYWHITE);
+
+        const char *delayText = "5 min, délai 3 s";
+        DrawRectangleLines(centerW - 150, centerH + 200, 300, 50, YELLOW);
+        DrawText(delayText, centerW - MeasureText(delayText, 25)/2, centerH + 210,25, RAYWHITE);
+
         const char *backText = "Appuyer sur ECHAP pour revenir au menu principal";
         DrawText(backText, centerW - MeasureText(backText, 20)/2, screenH - 50, 20, DARKGRAY);
     }
-}
\ No newline at end of file
+}
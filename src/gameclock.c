@@ -0,0 +1,129 @@
+#include "gameclock.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+void GameClock_Init(GameClock *clock, GameClockMode mode, int64_t baseMs, int64_t incrementMs)
+{
+    clock->mode = mode;
+    clock->baseMs = baseMs;
+    clock->incrementMs = (incrementMs > 0) ? incrementMs : 0;
+    clock->remainingNs[0] = baseMs * GAMECLOCK_NS_PER_MS;
+    clock->remainingNs[1] = baseMs * GAMECLOCK_NS_PER_MS;
+    clock->running = -1;
+    clock->turnStartNs = 0;
+}
+
+void GameClock_Start(GameClock *clock, int side, uint64_t nowNs)
+{
+    clock->running = side;
+    clock->turnStartNs = nowNs;
+}
+
+bool GameClock_IsRunning(const GameClock *clock)
+{
+    return clock->running >= 0;
+}
+
+// Temps débité pour un coup de elapsedNs (le délai simple n'est jamais débité)
+static int64_t ChargedNs(const GameClock *clock, int64_t elapsedNs)
+{
+    if (clock->mode == GAMECLOCK_DELAY)
+    {
+        int64_t delayNs = clock->incrementMs * GAMECLOCK_NS_PER_MS;
+        return (elapsedNs > delayNs) ? elapsedNs - delayNs : 0;
+    }
+    return elapsedNs;
+}
+
+static int64_t ElapsedNs(const GameClock *clock, uint64_t nowNs)
+{
+    return (nowNs > clock->turnStartNs) ? (int64_t)(nowNs - clock->turnStartNs) : 0;
+}
+
+// Temps restant à l'instant nowNs, négatif si le camp est tombé
+static int64_t RemainingNs(const GameClock *clock, int side, uint64_t nowNs)
+{
+    int64_t remaining = clock->remainingNs[side];
+    if (side == clock->running) remaining -= ChargedNs(clock, ElapsedNs(clock, nowNs));
+    return remaining;
+}
+
+// Fin du coup en cours : débit, puis ce que le mode rend au camp s'il n'est pas tombé
+static void ChargeTurn(GameClock *clock, uint64_t nowNs, bool moved)
+{
+    int side = clock->running;
+    int64_t elapsed = ElapsedNs(clock, nowNs);
+    int64_t incrementNs = clock->incrementMs * GAMECLOCK_NS_PER_MS;
+    clock->remainingNs[side] -= ChargedNs(clock, elapsed);
+    if (clock->remainingNs[side] <= 0)
+    {
+        clock->remainingNs[side] = 0;
+        return;
+    }
+    if (!moved) return;
+    if (clock->mode == GAMECLOCK_FISCHER) clock->remainingNs[side] += incrementNs;
+    else if (clock->mode == GAMECLOCK_BRONSTEIN) clock->remainingNs[side] += (elapsed < incrementNs) ? elapsed : incrementNs;
+}
+
+void GameClock_Stop(GameClock *clock, uint64_t nowNs)
+{
+    if (clock->running < 0) return;
+    ChargeTurn(clock, nowNs, false); // Fin de partie : le camp au trait n'a pas joué, pas d'incrément
+    clock->running = -1;
+}
+
+void GameClock_Restart(GameClock *clock, int side, uint64_t nowNs)
+{
+    if (clock->running >= 0) ChargeTurn(clock, nowNs, false);
+    GameClock_Start(clock, side, nowNs);
+}
+
+void GameClock_Press(GameClock *clock, uint64_t nowNs)
+{
+    if (clock->running < 0) return;
+    int next = 1 - clock->running;
+    ChargeTurn(clock, nowNs, true);
+    GameClock_Start(clock, next, nowNs);
+}
+
+int64_t GameClock_RemainingMs(const GameClock *clock, int side, uint64_t nowNs)
+{
+    int64_t remaining = RemainingNs(clock, side, nowNs);
+    return (remaining > 0) ? remaining / GAMECLOCK_NS_PER_MS : 0;
+}
+
+bool GameClock_Flagged(const GameClock *clock, int side, uint64_t nowNs)
+{
+    return RemainingNs(clock, side, nowNs) <= 0;
+}
+
+bool GameClock_Parse(GameClock *clock, const char *text)
+{
+    char *end;
+    double minutes = strtod(text, &end);
+    if (end == text || minutes <= 0.0) return false;
+
+    GameClockMode mode = GAMECLOCK_FISCHER;
+    double seconds = 0.0;
+    if (*end == '+' || *end == 'd' || *end == 'b')
+    {
+        mode = (*end == 'd') ? GAMECLOCK_DELAY : (*end == 'b') ? GAMECLOCK_BRONSTEIN : GAMECLOCK_FISCHER;
+        const char *start = end + 1;
+        seconds = strtod(start, &end);
+        if (end == start || seconds < 0.0) return false;
+    }
+    if (*end != '\0') return false;
+
+    GameClock_Init(clock, mode, (int64_t)(minutes * 60000.0 + 0.5), (int64_t)(seconds * 1000.0 + 0.5));
+    return true;
+}
+
+void GameClock_Describe(const GameClock *clock, char *out, int size)
+{
+    double minutes = clock->baseMs / 60000.0;
+    double seconds = clock->incrementMs / 1000.0;
+    if (clock->incrementMs == 0) snprintf(out, (size_t)size, "%g min", minutes);
+    else if (clock->mode == GAMECLOCK_DELAY) snprintf(out, (size_t)size, "%g min, délai %g s", minutes, seconds);
+    else if (clock->mode == GAMECLOCK_BRONSTEIN) snprintf(out, (size_t)size, "%g min, Bronstein %g s", minutes, seconds);
+    else snprintf(out, (size_t)size, "%g min + %g s", minutes, seconds);
+}
@@ -0,0 +1,84 @@
+#include "history.h"
+#include <stddef.h>
+
+void History_Init(GameHistory *history, const Board *start)
+{
+    history->count = 0;
+    history->full = false;
+    history->keyframes[0] = *start;
+}
+
+Move History_MoveAt(const GameHistory *history, int ply, const Board *before, int *promotionPieceID)
+{
+    const HistoryMove *h = &history->moves[ply];
+    Move move = { h->from % BOARD_COLS, h->from / BOARD_COLS, h->to % BOARD_COLS, h->to / BOARD_COLS,
+                  -1, 0, false, before->enPassantX, before->enPassantY };
+
+    // Pièce et prise relues sur la position, comme pour un clic (game.c)
+    const Tile *startTile = &before->tiles[move.startY][move.startX];
+    const Tile *endTile = &before->tiles[move.endY][move.endX];
+    if (startTile->layerCount > 1) move.movingPieceID = startTile->layers[startTile->layerCount - 1];
+    if (endTile->layerCount > 1)
+    {
+        move.capturedPieceID = endTile->layers[endTile->layerCount - 1];
+    }
+    else if ((move.movingPieceID == 6 || move.movingPieceID == 7) && move.startX != move.endX)
+    {
+        // Pion en diagonale sur une case vide : prise en passant
+        const Tile *epTile = &before->tiles[move.startY][move.endX];
+        move.isEnPassant = true;
+        move.capturedPieceID = epTile->layers[epTile->layerCount - 1];
+    }
+
+    if (promotionPieceID != NULL) *promotionPieceID = h->promotion;
+    return move;
+}
+
+// Rejoue les coups [keyframe * INTERVAL, ply) depuis la copie 'keyframe'
+static void ReplayFrom(const GameHistory *history, int keyframe, int ply, Board *out)
+{
+    *out = history->keyframes[keyframe];
+    for (int i = keyframe * HISTORY_KEYFRAME_INTERVAL; i < ply; i++)
+    {
+        int promotion;
+        Move move = History_MoveAt(history, i, out, &promotion);
+        ApplyMove(out, move, promotion);
+        out->sideToMove = 1 - out->sideToMove;
+    }
+}
+
+bool History_Push(GameHistory *history, Move move, int promotionPieceID)
+{
+    if (history->count >= HISTORY_MAX_PLIES)
+    {
+        history->full = true;
+        return false;
+    }
+
+    HistoryMove *h = &history->moves[history->count++];
+    h->from = (uint8_t)(move.startY * BOARD_COLS + move.startX);
+    h->to = (uint8_t)(move.endY * BOARD_COLS + move.endX);
+    h->promotion = (uint8_t)((promotionPieceID > 0) ? promotionPieceID : 0);
+
+    // Nouvelle copie complète : rejouée depuis la précédente, indépendante de l'état de l'interface
+    if (history->count % HISTORY_KEYFRAME_INTERVAL == 0)
+    {
+        int keyframe = history->count / HISTORY_KEYFRAME_INTERVAL;
+        ReplayFrom(history, keyframe - 1, history->count, &history->keyframes[keyframe]);
+    }
+    return true;
+}
+
+void History_Truncate(GameHistory *history, int ply)
+{
+    if (ply < 0 || ply >= history->count) return;
+    history->count = ply;
+    history->full = false;
+}
+
+bool History_Position(const GameHistory *history, int ply, Board *out)
+{
+    if (ply < 0 || ply > history->count) return false;
+    ReplayFrom(history, ply / HISTORY_KEYFRAME_INTERVAL, ply, out);
+    return true;
+}
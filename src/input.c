@@ -0,0 +1,290 @@
+#include "input.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum
+{
+    INPUT_EVENT_CLICK, // a = x, b = y
+    INPUT_EVENT_KEY,   // a = code raylib
+    INPUT_EVENT_SIZE   // a = largeur, b = hauteur
+} InputEventType;
+
+typedef struct
+{
+    long frame;
+    int type;
+    int a, b;
+} InputEvent;
+
+static InputEvent events[INPUT_MAX_EVENTS];
+static int eventCount = 0;
+static int nextEvent = 0;
+static bool scripted = false;
+
+static FILE *recordFile = NULL;
+static int recordW = 0;
+static int recordH = 0;
+
+// État de l'image courante (mode rejoué)
+static long frame = -1;
+static bool mousePressed = false;
+static Vector2 mousePos = { 0 };
+static int keys[INPUT_MAX_KEYS_PER_FRAME];
+static int keyCount = 0;
+static int screenW = 800;
+static int screenH = 600;
+
+static bool AddEvent(long eventFrame, int type, int a, int b)
+{
+    if (eventCount >= INPUT_MAX_EVENTS) return false;
+    events[eventCount++] = (InputEvent){ eventFrame, type, a, b };
+    return true;
+}
+
+// Centre d'une case "e2" à l'écran, avec le même calcul que GameLogicUpdate et GameDraw
+static bool SquareCenter(const char *square, int w, int h, int *px, int *py)
+{
+    if (square[0] < 'a' || square[0] > 'h' || square[1] < '1' || square[1] > '8') return false;
+    int tileSizeW = w / 8;
+    int tileSizeH = h / 8;
+    int tileSize = (tileSizeW < tileSizeH) ? tileSizeW : tileSizeH;
+    int offsetX = (w - tileSize * 8) / 2;
+    int offsetY = (h - tileSize * 8) / 2;
+    *px = offsetX + (square[0] - 'a') * tileSize + tileSize / 2;
+    *py = offsetY + ('8' - square[1]) * tileSize + tileSize / 2;
+    return true;
+}
+
+bool Input_LoadScript(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (f == NULL)
+    {
+        fprintf(stderr, "Impossible d'ouvrir %s\n", path);
+        return false;
+    }
+
+    eventCount = 0;
+    nextEvent = 0;
+    long lastFrame = 0;
+    int sizeW = 800; // Taille courante pendant la lecture (conversion des "move")
+    int sizeH = 600;
+    bool ok = true;
+    char line[256];
+    int lineNumber = 0;
+
+    while (ok && fgets(line, sizeof(line), f) != NULL)
+    {
+        lineNumber++;
+        char *comment = strchr(line, '#');
+        if (comment != NULL) *comment = '\0';
+
+        char first[32], kind[32], arg1[32], arg2[32];
+        int n = sscanf(line, "%31s %31s %31s %31s", first, kind, arg1, arg2);
+        if (n <= 0) continue;
+
+        // "size W H" sans numéro d'image : s'applique à l'image de l'évènement précédent
+        long eventFrame = lastFrame;
+        if (strcmp(first, "size") == 0)
+        {
+            if (n < 3) ok = false;
+            else
+            {
+                sizeW = atoi(kind);
+                sizeH = atoi(arg1);
+                ok = AddEvent(eventFrame, INPUT_EVENT_SIZE, sizeW, sizeH);
+            }
+        }
+        else
+        {
+            char *end;
+            long value = strtol((first[0] == '+') ? first + 1 : first, &end, 10);
+            eventFrame = (first[0] == '+') ? lastFrame + value : value;
+            if (*end != '\0' || n < 3 || eventFrame < lastFrame) ok = false;
+            else if (strcmp(kind, "click") == 0 && n == 4)
+            {
+                ok = AddEvent(eventFrame, INPUT_EVENT_CLICK, atoi(arg1), atoi(arg2));
+            }
+            else if (strcmp(kind, "key") == 0)
+            {
+                ok = AddEvent(eventFrame, INPUT_EVENT_KEY, atoi(arg1), 0);
+            }
+            else if (strcmp(kind, "size") == 0 && n == 4)
+            {
+                sizeW = atoi(arg1);
+                sizeH = atoi(arg2);
+                ok = AddEvent(eventFrame, INPUT_EVENT_SIZE, sizeW, sizeH);
+            }
+            else if (strcmp(kind, "move") == 0 && strlen(arg1) >= 4)
+            {
+                // Clic sur la pièce, puis sur la destination à l'image suivante
+                int x0, y0, x1, y1;
+                ok = SquareCenter(arg1, sizeW, sizeH, &x0, &y0) && SquareCenter(arg1 + 2, sizeW, sizeH, &x1, &y1)
+                    && AddEvent(eventFrame, INPUT_EVENT_CLICK, x0, y0)
+                    && AddEvent(eventFrame + 1, INPUT_EVENT_CLICK, x1, y1);
+                eventFrame++;
+            }
+            else ok = false;
+        }
+        lastFrame = eventFrame;
+    }
+    fclose(f);
+
+    if (!ok)
+    {
+        fprintf(stderr, "%s:%d : ligne invalide ou script trop long\n", path, lineNumber);
+        eventCount = 0;
+        return false;
+    }
+
+    scripted = true;
+    frame = -1;
+    mousePressed = false;
+    keyCount = 0;
+    screenW = 800;
+    screenH = 600;
+    // Taille initiale : les "size" placés avant le premier clic valent dès la première image
+    while (nextEvent < eventCount && events[nextEvent].type == INPUT_EVENT_SIZE && events[nextEvent].frame == 0)
+    {
+        screenW = events[nextEvent].a;
+        screenH = events[nextEvent].b;
+        nextEvent++;
+    }
+    return true;
+}
+
+bool Input_IsScripted(void)
+{
+    return scripted;
+}
+
+bool Input_ScriptFinished(void)
+{
+    return nextEvent >= eventCount;
+}
+
+long Input_ScriptLastFrame(void)
+{
+    return (eventCount > 0) ? events[eventCount - 1].frame : 0;
+}
+
+bool Input_StartRecording(const char *path)
+{
+    Input_StopRecording();
+    recordFile = fopen(path, "w");
+    if (recordFile == NULL) return false;
+    fprintf(recordFile, "# Entrées enregistrées (rejouer avec ./build/game --replay %s)\n", path);
+    recordW = 0;
+    recordH = 0;
+    return true;
+}
+
+void Input_StopRecording(void)
+{
+    if (recordFile == NULL) return;
+    fclose(recordFile);
+    recordFile = NULL;
+}
+
+void Input_BeginFrame(void)
+{
+    frame++;
+
+    if (!scripted)
+    {
+        if (recordFile == NULL) return;
+
+        // La taille de la fenêtre détermine la case visée par un clic : on la note à chaque changement
+        if (GetScreenWidth() != recordW || GetScreenHeight() != recordH)
+        {
+            recordW = GetScreenWidth();
+            recordH = GetScreenHeight();
+            fprintf(recordFile, "%ld size %d %d\n", frame, recordW, recordH);
+        }
+        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
+        {
+            Vector2 m = GetMousePosition();
+            fprintf(recordFile, "%ld click %d %d\n", frame, (int)m.x, (int)m.y);
+        }
+        // File des touches de raylib : la vider ne change pas IsKeyPressed
+        for (int key = GetKeyPressed(); key != 0; key = GetKeyPressed())
+        {
+            fprintf(recordFile, "%ld key %d\n", frame, key);
+        }
+        return;
+    }
+
+    mousePressed = false;
+    keyCount = 0;
+    while (nextEvent < eventCount && events[nextEvent].frame <= frame)
+    {
+        const InputEvent *e = &events[nextEvent++];
+        if (e->type == INPUT_EVENT_CLICK)
+        {
+            mousePressed = true;
+            mousePos = (Vector2){ (float)e->a, (float)e->b };
+        }
+        else if (e->type == INPUT_EVENT_KEY && keyCount < INPUT_MAX_KEYS_PER_FRAME)
+        {
+            keys[keyCount++] = e->a;
+        }
+        else if (e->type == INPUT_EVENT_SIZE)
+        {
+            screenW = e->a;
+            screenH = e->b;
+        }
+    }
+}
+
+long Input_Frame(void)
+{
+    return frame;
+}
+
+bool Input_HasActivity(void)
+{
+    if (scripted) return true;
+
+    Vector2 delta = GetMouseDelta();
+    if (delta.x != 0.0f || delta.y != 0.0f || GetMouseWheelMove() != 0.0f || IsWindowResized()) return true;
+    for (int button = MOUSE_BUTTON_LEFT; button <= MOUSE_BUTTON_BACK; button++)
+    {
+        if (IsMouseButtonPressed(button) || IsMouseButtonReleased(button)) return true;
+    }
+    for (int key = KEY_SPACE; key <= KEY_KB_MENU; key++)
+    {
+        if (IsKeyPressed(key) || IsKeyReleased(key)) return true;
+    }
+    return false;
+}
+
+bool Input_MouseLeftPressed(void)
+{
+    return scripted ? mousePressed : IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
+}
+
+Vector2 Input_MousePosition(void)
+{
+    return scripted ? mousePos : GetMousePosition();
+}
+
+bool Input_KeyPressed(int key)
+{
+    if (!scripted) return IsKeyPressed(key);
+    for (int i = 0; i < keyCount; i++)
+    {
+        if (keys[i] == key) return true;
+    }
+    return false;
+}
+
+int Input_ScreenWidth(void)
+{
+    return scripted ? screenW : GetScreenWidth();
+}
+
+int Input_ScreenHeight(void)
+{
+    return scripted ? screenH : GetScreenHeight();
+}
@@ -0,0 +1,149 @@
+#include "learn.h"
+#include "mapfile.h"
+#include "tt.h"
+#include <string.h>
+
+static MappedFile gLearnFile = { 0 };
+static LearnHeader *gHeader = NULL;
+static LearnEntry *gSlots = NULL;
+static uint64_t gBucketCount = 0;
+static uint16_t gGeneration = 0;
+
+bool Learn_Open(const char *path, int sizeMB)
+{
+    Learn_Close();
+    if (sizeMB <= 0) return false;
+
+    // Plus grande puissance de 2 de seaux qui tient dans la taille demandée
+    size_t bytes = (size_t)sizeMB * 1024 * 1024 - sizeof(LearnHeader);
+    uint64_t buckets = 1;
+    while ((buckets * 2) * LEARN_BUCKET_SIZE * sizeof(LearnEntry) <= bytes) buckets *= 2;
+    uint64_t slotCount = buckets * LEARN_BUCKET_SIZE;
+
+    size_t fileSize = sizeof(LearnHeader) + (size_t)slotCount * sizeof(LearnEntry);
+    if (!MapFileOpenWritable(&gLearnFile, path, fileSize)) return false;
+
+    gHeader = gLearnFile.data;
+    gSlots = (LearnEntry *)((uint8_t *)gLearnFile.data + sizeof(LearnHeader));
+    gBucketCount = buckets;
+
+    // Fichier neuf, d'une autre version ou d'une autre taille : on repart de zéro
+    if (memcmp(gHeader->magic, LEARN_MAGIC, 4) != 0 || gHeader->version != LEARN_VERSION
+        || gHeader->slotCount != slotCount)
+    {
+        memset(gLearnFile.data, 0, fileSize);
+        memcpy(gHeader->magic, LEARN_MAGIC, 4);
+        gHeader->version = LEARN_VERSION;
+        gHeader->slotCount = slotCount;
+    }
+
+    gHeader->generation++;
+    gGeneration = (uint16_t)gHeader->generation;
+    return true;
+}
+
+void Learn_Close(void)
+{
+    MapFileClose(&gLearnFile);
+    gHeader = NULL;
+    gSlots = NULL;
+    gBucketCount = 0;
+}
+
+bool Learn_IsOpen(void)
+{
+    return gSlots != NULL;
+}
+
+static LearnEntry *Bucket(uint64_t key)
+{
+    return &gSlots[(key & (gBucketCount - 1)) * LEARN_BUCKET_SIZE];
+}
+
+// Valeur d'une entrée pour l'éviction : profondeur d'abord, puis racines et entrées utiles,
+// les sessions anciennes perdant progressivement leur place
+static int EntryWorth(const LearnEntry *e)
+{
+    if (e->key == 0) return -100000;
+    int age = (uint16_t)(gGeneration - e->generation);
+    if (age > 32) age = 32;
+    int hits = (e->hits > 8) ? 8 : (int)e->hits;
+    return e->depth * 4 + ((e->flags & LEARN_FLAG_ROOT) ? 8 : 0) + hits - age;
+}
+
+bool Learn_Probe(uint64_t key, LearnEntry *entry)
+{
+    if (gSlots == NULL) return false;
+
+    LearnEntry *bucket = Bucket(key);
+    for (int i = 0; i < LEARN_BUCKET_SIZE; i++)
+    {
+        if (bucket[i].key == key)
+        {
+            bucket[i].hits++;
+            bucket[i].generation = gGeneration; // Entrée encore utile : elle rajeunit
+            *entry = bucket[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+void Learn_Store(uint64_t key, int depth, int score, int bound, uint16_t move, bool isRoot)
+{
+    if (gSlots == NULL || key == 0) return;
+
+    LearnEntry *bucket = Bucket(key);
+    LearnEntry *victim = NULL;
+    for (int i = 0; i < LEARN_BUCKET_SIZE; i++)
+    {
+        if (bucket[i].key == key)
+        {
+            // Déjà connue : on ne remplace un résultat que par une recherche au moins aussi profonde
+            LearnEntry *e = &bucket[i];
+            bool deeper = depth > e->depth || (depth == e->depth && (bound == TT_EXACT || e->bound != TT_EXACT));
+            if (!deeper)
+            {
+                if (isRoot) e->flags |= LEARN_FLAG_ROOT;
+                return;
+            }
+            victim = e;
+            break;
+        }
+    }
+
+    LearnEntry fresh = { key, score, move, (int8_t)depth, (uint8_t)bound, gGeneration,
+                         isRoot ? LEARN_FLAG_ROOT : 0, 0 };
+    if (victim != NULL)
+    {
+        fresh.flags |= victim->flags;
+        fresh.hits = victim->hits;
+        if (fresh.move == TT_MOVE_NONE) fresh.move = victim->move;
+        *victim = fresh;
+        return;
+    }
+
+    // Seau plein : la nouvelle entrée ne chasse que moins utile qu'elle
+    victim = &bucket[0];
+    for (int i = 1; i < LEARN_BUCKET_SIZE; i++)
+    {
+        if (EntryWorth(&bucket[i]) < EntryWorth(victim)) victim = &bucket[i];
+    }
+    if (victim->key != 0 && EntryWorth(victim) > EntryWorth(&fresh)) return;
+    *victim = fresh;
+}
+
+long Learn_LoadIntoTT(void)
+{
+    if (gSlots == NULL) return 0;
+
+    long count = 0;
+    for (uint64_t i = 0; i < gBucketCount * LEARN_BUCKET_SIZE; i++)
+    {
+        const LearnEntry *e = &gSlots[i];
+        if (e->key == 0) continue;
+        TT_Store(e->key, e->depth, e->score, e->bound, e->move);
+        count++;
+    }
+    return count;
+}
@@ -1,8 +1,35 @@
 #include "raylib.h"
 #include "game.h"
+#include "bitbase.h"
+#include "book.h"
+#include "clock.h"
+#include "zobrist.h"
+#include "tt.h"
+#include "learn.h"
+#include "analysis.h"
+#include "ponder.h"
+#include "assets.h"
+#include "profiler.h"
+#include "profoverlay.h"
+#include "searchstats.h"
+#include "searchtrace.h"
+#include "input.h"
+#include "replay.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
-// Gestionnaire de texture
-Texture2D gTileTextures[32];
+#define IDLE_POLL_SECONDS 0.02  // Mode économe : évènements relevés 50 fois par seconde (latence d'une entrée)
+#define IDLE_GRACE_SECONDS 0.5  // Pleine cadence après la dernière entrée
+#define TICK_MAX_CATCHUP 8      // --tick-hz : pas rattrapés au plus d'affilée
+#define SPEED_MEASURE_MS 100.0  // Durée de la mesure de vitesse du moteur
+
+// Gestionnaire de texture : toutes les cases et pièces dans un atlas unique (rempli par assets.c)
+Texture2D gSpriteAtlas = { 0 };
+Rectangle gSpriteRects[32];
 int gTileTextureCount = 0;
 Texture2D gMenuBackground = { 0 };
 
@@ -10,14 +37,368 @@ Sound gPieceSound = { 0 };
 Sound gCheckSound = { 0 };
 Sound gEatingSound = { 0 };
 
-int main(void)
+// Moteur : évaluation, finales, livre, table de transposition (aucune fenêtre nécessaire)
+static void EngineInit(const char *learnPath, int learnMB)
+{
+    // Réseau d'évaluation optionnel : sans fichier de poids, l'IA garde EvalutatePosition
+    if (NNUE_Load("assets/nnue.bin"))
+    {
+        TraceLog(LOG_INFO, "NNUE : poids chargés depuis assets/nnue.bin");
+    }
+    else
+    {
+        TraceLog(LOG_INFO, "NNUE : pas de poids (assets/nnue.bin), évaluation matérielle");
+    }
+
+    // Bitbases de finales (KPK, KRK, KQK) projetées en mémoire, générées par "make bitbases"
+    int bitbaseCount = Bitbase_Load("assets");
+    TraceLog(LOG_INFO, "Bitbases : %d / 3 chargées", bitbaseCount);
+
+    // Livre d'ouverture (facultatif), construit avec build/bookgen
+    if (Book_Open("assets/book.bin"))
+    {
+        TraceLog(LOG_INFO, "Livre d'ouverture chargé (assets/book.bin)");
+    }
+
+    // Table de transposition, préremplie par le fichier d'apprentissage s'il est demandé
+    if (!TT_Init(TT_DEFAULT_MB))
+    {
+        TraceLog(LOG_WARNING, "Table de transposition : allocation impossible");
+    }
+
+    if (learnPath != NULL)
+    {
+        if (Learn_Open(learnPath, learnMB))
+        {
+            TraceLog(LOG_INFO, "Apprentissage : %ld positions rechargées depuis %s", Learn_LoadIntoTT(), learnPath);
+        }
+        else
+        {
+            TraceLog(LOG_WARNING, "Apprentissage : impossible d'ouvrir %s", learnPath);
+        }
+    }
+}
+
+// Vitesse de recherche de cette machine (avec l'évaluation chargée) : les niveaux de l'IA sont des
+// budgets de noeuds calculés à partir d'elle. Mesurée sur un thread une fois le menu affiché (elle
+// prend SPEED_MEASURE_MS) : les budgets ne servent qu'au premier coup de l'IA, calculés à ce moment-là.
+// --engine-nps la fixe (rejeux reproductibles).
+static pthread_t speedThread;
+static bool speedRunning = false;
+static atomic_bool speedDone;
+static double speedNps = 0.0;
+
+static void *SpeedMain(void *arg)
+{
+    (void)arg;
+    speedNps = MeasureSearchSpeed(SPEED_MEASURE_MS);
+    atomic_store(&speedDone, true);
+    return NULL;
+}
+
+static void SetEngineSpeed(double nodesPerSecond)
+{
+    TraceLog(LOG_INFO, "Moteur : %.0f noeuds/s", nodesPerSecond);
+    GameSetEngineSpeed(nodesPerSecond);
+}
+
+static void SpeedStart(void)
+{
+    atomic_store(&speedDone, false);
+    speedRunning = (pthread_create(&speedThread, NULL, SpeedMain, NULL) == 0);
+    if (!speedRunning) SetEngineSpeed(MeasureSearchSpeed(SPEED_MEASURE_MS)); // Sans thread : tant pis pour l'image
+}
+
+// Mesure finie : budgets de l'IA mis à jour (jusque-là, vitesse de référence AI_REFERENCE_NPS)
+static void SpeedPoll(void)
+{
+    if (!speedRunning || !atomic_load(&speedDone)) return;
+    pthread_join(speedThread, NULL);
+    speedRunning = false;
+    SetEngineSpeed(speedNps);
+}
+
+static void EngineShutdown(void)
+{
+    if (speedRunning)
+    {
+        pthread_join(speedThread, NULL);
+        speedRunning = false;
+    }
+    // Les threads de réflexion et d'analyse utilisent la table et l'évaluation
+    Ponder_Stop();
+    Analysis_Stop();
+    NNUE_Unload();
+    Bitbase_Unload();
+    Book_Close();
+    Learn_Close();
+    TT_Free();
+    SearchLog_Close();
+#ifdef SEARCH_TRACE
+    SearchTrace_Close();
+#endif
+}
+
+// BOUCLE PRINCIPALE (fenêtre)
+
+static Game game; // Trop gros pour la pile sous Windows
+static bool assetsReady = false;
+static bool firstFrame = true;
+static bool showProfiler = false;
+static double loadStart = 0.0;
+static uint64_t processStartNs = 0; // Début de main : la première image compte aussi ce qui précède la fenêtre
+static bool idleMode = false;
+static bool speedPending = false; // Vitesse à mesurer une fois le menu prêt (pas de --engine-nps)
+static double lastActivity = 0.0;
+static double idleUntil = 0.0;
+
+// Logique : assets, touches du profileur, entrées, GameUpdate (les évènements viennent d'être relevés)
+static void LoopUpdate(float dt)
+{
+    // Envoi au GPU de ce que le thread de chargement a fini ; le jeu attend la fin du chargement
+    if (!assetsReady)
+    {
+        assetsReady = Assets_Update();
+        if (assetsReady) TraceLog(LOG_INFO, "Assets chargés en %.0f ms", (GetTime() - loadStart) * 1000.0);
+    }
+
+    // Menu affiché et décodage fini : la mesure de vitesse ne concurrence plus le chargement
+    if (assetsReady && speedPending)
+    {
+        SpeedStart();
+        speedPending = false;
+    }
+    SpeedPoll();
+
+    // Profileur : F3 affiche le panneau, F4 exporte les dernières secondes (chrome://tracing)
+    if (IsKeyPressed(KEY_F3)) showProfiler = !showProfiler;
+    if (IsKeyPressed(KEY_F4))
+    {
+        const char *tracePath = TextFormat("trace_%ld.json", (long)time(NULL));
+        if (Prof_WriteChromeTrace(tracePath, PROF_TRACE_SECONDS)) TraceLog(LOG_INFO, "Trace écrite : %s", tracePath);
+        else TraceLog(LOG_WARNING, "Impossible d'écrire %s", tracePath);
+    }
+
+    if (assetsReady)
+    {
+        Input_BeginFrame();
+        PROF_BEGIN(GameUpdate);
+        GameUpdate(&game, dt); 
+        PROF_END(GameUpdate);
+        idleUntil = GetTime() + GameIdleSeconds(&game);
+    }
+}
+
+// Dessin ; EndDrawing relève aussi les évènements de la fenêtre
+static void LoopDraw(void)
+{
+    BeginDrawing(); 
+    ClearBackground(BLACK);  
+    PROF_BEGIN(GameDraw);
+    GameDraw(&game); 
+    PROF_END(GameDraw);
+    if (!assetsReady)
+    {
+        DrawText(TextFormat("Chargement... %d%%", (int)(Assets_Progress() * 100.0f)), 20, GetScreenHeight() - 40, 20, GRAY);
+    }
+    if (showProfiler) ProfOverlay_Draw();
+    PROF_BEGIN(EndDrawing);
+    EndDrawing();
+    PROF_END(EndDrawing);
+    Prof_FrameMark();
+
+    if (firstFrame)
+    {
+        TraceLog(LOG_INFO, "Première image après %.0f ms (%.0f ms depuis le lancement)", (GetTime() - loadStart) * 1000.0,
+                 (double)(Clock_NowNs() - processStartNs) * 1e-6);
+        firstFrame = false;
+    }
+}
+
+// Mode économe : tant qu'aucune entrée, aucun son et aucune échéance du jeu (pendule, tour de
+// l'IA) ne demande d'image, on dort en relevant seulement les évènements : ni dessin ni GPU.
+// Une entrée réveille aussitôt la boucle, qui reste à pleine cadence IDLE_GRACE_SECONDS.
+static bool LoopIsQuiet(double now)
+{
+    if (!idleMode || !assetsReady || showProfiler) return false;
+    if (Input_HasActivity() || IsSoundPlaying(gPieceSound) || IsSoundPlaying(gCheckSound) || IsSoundPlaying(gEatingSound))
+    {
+        lastActivity = now;
+        return false;
+    }
+    return now - lastActivity > IDLE_GRACE_SECONDS && now < idleUntil;
+}
+
+static void LoopSleep(double now)
+{
+    double wait = idleUntil - now;
+    WaitTime((wait < IDLE_POLL_SECONDS) ? wait : IDLE_POLL_SECONDS);
+    PollInputEvents();
+}
+
+// Par défaut : une mise à jour et un dessin par image, au rythme de la VSync
+static void RunLockstepLoop(void)
+{
+    while (!WindowShouldClose())
+    {
+        if (LoopIsQuiet(GetTime()))
+        {
+            LoopSleep(GetTime());
+            continue;
+        }
+        LoopUpdate(GetFrameTime());
+        LoopDraw();
+    }
+}
+
+// --tick-hz : la logique (entrées, pendules, suivi de l'IA) avance par pas fixes de 1/tickHz s,
+// chacun précédé d'un relevé des évènements ; le dessin suit la fréquence de l'écran, sans VSync.
+// Un pas qui reçoit un clic fait dessiner tout de suite : la case choisie s'affiche au plus un pas
+// et un dessin plus tard, sans attendre la prochaine image de l'écran. Rien n'est à interpoler entre
+// deux pas : le plateau ne bouge qu'aux coups et les pendules sont lues à l'instant du dessin.
+static void RunFixedTickLoop(int tickHz)
+{
+    double tick = 1.0 / tickHz;
+    int refreshRate = GetMonitorRefreshRate(GetCurrentMonitor());
+    double renderInterval = 1.0 / ((refreshRate > 0) ? refreshRate : 60);
+    double nextTick = GetTime();
+    double nextRender = nextTick;
+    bool polled = true; // Évènements relevés (EndDrawing, sommeil) pas encore passés à un pas
+
+    while (!WindowShouldClose())
+    {
+        double now = GetTime();
+        if (LoopIsQuiet(now))
+        {
+            LoopSleep(now);
+            polled = true;
+            nextTick = GetTime(); // Pas de rattrapage après un sommeil
+            continue;
+        }
+
+        // Pas en retard, un relevé chacun (jamais deux relevés sans pas : un clic serait perdu).
+        // Au-delà de TICK_MAX_CATCHUP (recherche bloquante), le retard est abandonné.
+        bool clicked = false;
+        for (int steps = 0; now >= nextTick && steps < TICK_MAX_CATCHUP; steps++)
+        {
+            if (!polled) PollInputEvents();
+            polled = false;
+            LoopUpdate((float)tick);
+            if (assetsReady && Input_MouseLeftPressed()) clicked = true;
+            nextTick += tick;
+        }
+        if (now >= nextTick) nextTick = now + tick;
+
+        now = GetTime();
+        if (clicked || now >= nextRender)
+        {
+            LoopDraw();
+            polled = true;
+            nextRender = now + renderInterval;
+        }
+        else
+        {
+            double wake = (nextTick < nextRender) ? nextTick : nextRender;
+            if (wake > now) WaitTime(wake - now);
+        }
+    }
+}
+
+int main(int argc, char **argv)
 {
+    processStartNs = Clock_NowNs();
+    Zobrist_Init();
+    srand((unsigned int)time(NULL));
+
+    // Outil en ligne de commande : aucune fenêtre ni audio
+    // (solveur de mat, livre et banc d'essai : build/mate, build/bookgen, build/bench)
+    if (argc >= 2 && strcmp(argv[1], "--pack") == 0)
+    {
+        // Paquet d'assets pré-décodés : ./game --pack [assets/bundle.pak]
+        return Assets_WriteBundle((argc >= 3) ? argv[2] : BUNDLE_PATH) ? 0 : 1;
+    }
+
+    // Options : --learn <fichier> [--learn-mb N] (apprentissage persistant), --search-log <fichier.csv|.jsonl>,
+    // --trace <fichier> (versions TRACE=1), --record <script> (entrées de la session),
+    // --replay <script> [--draw] [--frames N] [--csv fichier] [--prof fichier.json] (rejeu chronométré),
+    // --no-ponder (l'IA ne réfléchit pas pendant le tour du joueur), --engine-nps N (vitesse imposée au lieu de la mesure)
+    // --slice-ms N (recherche de l'IA répartie sur les images, N ms par image, sans thread)
+    // --clock 3+2 | 5d3 | 5b3 (cadence contre l'IA : minutes + incrément Fischer, délai ou Bronstein en secondes),
+    // --idle (mode économe : aucune image tant que rien ne change à l'écran),
+    // --tick-hz N (logique à N pas par seconde, indépendante du dessin)
+    const char *learnPath = NULL;
+    int learnMB = LEARN_DEFAULT_MB;
+    const char *recordPath = NULL;
+    double engineNps = 0.0;
+    int tickHz = 0;
+    ReplayOptions replay = { 0 };
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--learn") == 0 && i + 1 < argc) learnPath = argv[++i];
+        else if (strcmp(argv[i], "--learn-mb") == 0 && i + 1 < argc) learnMB = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--search-log") == 0 && i + 1 < argc)
+        {
+            // Statistiques de chaque coup de l'IA : fichier .csv (une ligne par itération) ou .jsonl
+            const char *logPath = argv[++i];
+            if (!SearchLog_Open(logPath)) fprintf(stderr, "Impossible d'ouvrir %s\n", logPath);
+        }
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+        {
+            // Arbre de recherche complet, à analyser avec build/tracestat
+            const char *tracePath = argv[++i];
+#ifdef SEARCH_TRACE
+            if (!SearchTrace_Open(tracePath)) fprintf(stderr, "Impossible d'ouvrir %s\n", tracePath);
+#else
+            fprintf(stderr, "--trace %s ignoré : recompiler avec make TRACE=1\n", tracePath);
+#endif
+        }
+        else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) recordPath = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) replay.scriptPath = argv[++i];
+        else if (strcmp(argv[i], "--draw") == 0) replay.draw = true;
+        else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) replay.maxFrames = atol(argv[++i]);
+        else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) replay.csvPath = argv[++i];
+        else if (strcmp(argv[i], "--prof") == 0 && i + 1 < argc) replay.profPath = argv[++i];
+        else if (strcmp(argv[i], "--no-ponder") == 0) GameSetPondering(false);
+        else if (strcmp(argv[i], "--engine-nps") == 0 && i + 1 < argc) engineNps = atof(argv[++i]);
+        else if (strcmp(argv[i], "--slice-ms") == 0 && i + 1 < argc) GameSetSearchSlice(atof(argv[++i]));
+        else if (strcmp(argv[i], "--idle") == 0) idleMode = true;
+        else if (strcmp(argv[i], "--tick-hz") == 0 && i + 1 < argc) tickHz = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--clock") == 0 && i + 1 < argc)
+        {
+            GameClock timeControl;
+            const char *text = argv[++i];
+            if (GameClock_Parse(&timeControl, text))
+            {
+                char description[64];
+                GameClock_Describe(&timeControl, description, (int)sizeof(description));
+                TraceLog(LOG_INFO, "Cadence contre l'IA : %s", description);
+                GameSetTimeControl(&timeControl);
+            }
+            else fprintf(stderr, "--clock %s ignoré : attendu 10, 3+2, 5d3 ou 5b3\n", text);
+        }
+    }
+
+    EngineInit(learnPath, learnMB);
+    if (engineNps > 0.0) SetEngineSpeed(engineNps);
+
+    // Rejeu d'un script : le vrai GameUpdate, sans fenêtre (ni audio) sauf avec --draw
+    if (replay.scriptPath != NULL)
+    {
+        if (engineNps <= 0.0) SetEngineSpeed(MeasureSearchSpeed(SPEED_MEASURE_MS)); // Aucune image à attendre
+
+        int status = Replay_Run(&replay);
+        EngineShutdown();
+        return status;
+    }
+
     // ===============================================================
     // CONFIGURATION INTELLIGENTE (WINDOWS vs MAC)
     // ===============================================================
     
-    // On part sur une base commune : Redimensionnable + VSync
-    unsigned int flags = FLAG_WINDOW_RESIZABLE | FLAG_VSYNC_HINT;
+    // On part sur une base commune : Redimensionnable + VSync (sauf logique à pas fixe :
+    // la synchronisation bloquerait les pas pendant l'attente de l'écran, voir RunFixedTickLoop)
+    unsigned int flags = FLAG_WINDOW_RESIZABLE;
+    if (tickHz <= 0) flags |= FLAG_VSYNC_HINT;
 
     // MAGIE DU C : Ce bloc ne s'active que si on compile sur Mac (__APPLE__)
     #if defined(__APPLE__)
@@ -48,60 +429,33 @@ int main(void)
     
     // Taille minimale pour éviter de casser l'affichage
     SetWindowMinSize(400, 400);
-    InitAudioDevice();
-    // Chargement des assets    
-    gTileTextures[0] = LoadTexture("assets/carreau_blanc.png");
-    gTileTextures[1] = LoadTexture("assets/carreau_noir.png");
-    gTileTextures[2] = LoadTexture("assets/cavalier_blanc.png");
-    gTileTextures[3] = LoadTexture("assets/cavalier_noir.png");
-    gTileTextures[4] = LoadTexture("assets/fou_blanc.png");
-    gTileTextures[5] = LoadTexture("assets/fou_noir.png");
-    gTileTextures[6] = LoadTexture("assets/pion_blanc.png");
-    gTileTextures[7] = LoadTexture("assets/pion_noir.png");
-    gTileTextures[8] = LoadTexture("assets/reine_blanche.png");
-    gTileTextures[9] = LoadTexture("assets/reine_noir.png");
-    gTileTextures[10] = LoadTexture("assets/roi_blanc.png");
-    gTileTextures[11] = LoadTexture("assets/roi_noir.png");
-    gTileTextures[12] = LoadTexture("assets/tour_blanche.png");
-    gTileTextures[13] = LoadTexture("assets/tour_noir.png");
-    gTileTextureCount = 14;
-
-    gMenuBackground = LoadTexture("assets/fond_bois.jpg");
-    gPieceSound = LoadSound("assets/piece_sound.mp3");
-    gCheckSound = LoadSound("assets/echec_sound.mp3");
-    gEatingSound = LoadSound("assets/eating_sound.mp3");
-    SetSoundVolume(gPieceSound, 2.0f);
-    SetSoundVolume(gCheckSound, 1.5f);
-    SetSoundVolume(gEatingSound, 1.5f);
-    
-    Board board = {0}; 
-    GameInit(&board); 
 
-    while (!WindowShouldClose())
+    // Chargement des assets en arrière-plan : le menu s'affiche pendant le décodage
+    speedPending = (engineNps <= 0.0);
+    loadStart = GetTime();
+    if (!Assets_StartLoading(BUNDLE_PATH))
     {
-        float dt = GetFrameTime(); 
-        GameUpdate(&board, dt); 
+        TraceLog(LOG_INFO, "Pas de paquet %s (make bundle) : décodage des fichiers d'origine", BUNDLE_PATH);
+    }
+    InitAudioDevice();
 
-        BeginDrawing(); 
-        ClearBackground(BLACK);  
-        GameDraw(&board); 
-        EndDrawing();
+    if (recordPath != NULL && !Input_StartRecording(recordPath))
+    {
+        TraceLog(LOG_WARNING, "Impossible d'enregistrer les entrées dans %s", recordPath);
     }
 
-    UnloadSound(gPieceSound);
-    UnloadSound(gCheckSound);
-    UnloadSound(gEatingSound);
+    GameInit(&game); 
+    if (tickHz > 0) RunFixedTickLoop(tickHz);
+    else RunLockstepLoop();
 
-    UnloadTexture(gMenuBackground);
+    GameUnload();
+    EngineShutdown();
+    Input_StopRecording();
 
+    // Libération mémoire (textures et sons, avant de fermer l'audio)
+    Assets_Unload();
     CloseAudioDevice();
 
-    // Libération mémoire
-    for (int i = 0; i < gTileTextureCount; i++)
-    {
-        UnloadTexture(gTileTextures[i]);
-    }
-
     CloseWindow();
     return 0; 
 }
\ No newline at end of file
@@ -0,0 +1,158 @@
+#if !defined(_WIN32)
+    #define _POSIX_C_SOURCE 200809L // ftruncate en mode -std=c17
+#endif
+
+#include "mapfile.h"
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+bool MapFileOpen(MappedFile *mf, const char *path)
+{
+    mf->data = NULL;
+    mf->size = 0;
+    mf->writable = false;
+    mf->fileHandle = NULL;
+    mf->mapHandle = NULL;
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == NULL)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    mf->data = view;
+    mf->size = (size_t)size.QuadPart;
+    mf->fileHandle = file;
+    mf->mapHandle = mapping;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    void *view = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // Le mapping reste valide après la fermeture du descripteur
+    if (view == MAP_FAILED) return false;
+
+    mf->data = view;
+    mf->size = (size_t)st.st_size;
+#endif
+    return true;
+}
+
+bool MapFileOpenWritable(MappedFile *mf, const char *path, size_t size)
+{
+    mf->data = NULL;
+    mf->size = 0;
+    mf->writable = false;
+    mf->fileHandle = NULL;
+    mf->mapHandle = NULL;
+    if (size == 0) return false;
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    // Le mapping agrandit lui-même le fichier s'il est plus petit que 'size'
+    LARGE_INTEGER wanted;
+    wanted.QuadPart = (LONGLONG)size;
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READWRITE, (DWORD)(wanted.QuadPart >> 32), (DWORD)(wanted.QuadPart & 0xFFFFFFFF), NULL);
+    if (mapping == NULL)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+    if (view == NULL)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    mf->fileHandle = file;
+    mf->mapHandle = mapping;
+#else
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || ((size_t)st.st_size < size && ftruncate(fd, (off_t)size) != 0))
+    {
+        close(fd);
+        return false;
+    }
+
+    void *view = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) return false;
+#endif
+    mf->data = view;
+    mf->size = size;
+    mf->writable = true;
+    return true;
+}
+
+void MapFileFlush(MappedFile *mf)
+{
+    if (mf->data == NULL || !mf->writable) return;
+
+#if defined(_WIN32)
+    FlushViewOfFile(mf->data, 0);
+#else
+    msync(mf->data, mf->size, MS_ASYNC);
+#endif
+}
+
+void MapFileClose(MappedFile *mf)
+{
+    if (mf->data == NULL) return;
+    MapFileFlush(mf);
+
+#if defined(_WIN32)
+    UnmapViewOfFile(mf->data);
+    CloseHandle((HANDLE)mf->mapHandle);
+    CloseHandle((HANDLE)mf->fileHandle);
+#else
+    munmap(mf->data, mf->size);
+#endif
+    mf->data = NULL;
+    mf->size = 0;
+    mf->writable = false;
+    mf->fileHandle = NULL;
+    mf->mapHandle = NULL;
+}
@@ -0,0 +1,253 @@
+#include "matesearch.h"
+#include <stdlib.h>
+
+#define PN_INFINITY 100000000
+
+// Nœud de l'arbre : OR = attaquant au trait (un coup suffit), AND = défenseur au trait (tous les coups)
+typedef struct
+{
+    Move move;       // Coup qui mène à ce nœud
+    int parent;
+    int firstChild;  // Les enfants sont contigus dans le tableau
+    int childCount;
+    int pn;          // Nombre de preuve : feuilles à prouver pour établir le mat
+    int dn;          // Nombre de réfutation
+    int ply;         // Demi-coups depuis la racine (pair = attaquant au trait)
+    bool expanded;
+} PNNode;
+
+typedef struct
+{
+    PNNode *nodes;
+    long count;
+    long capacity;
+    int attacker;
+    int maxMateDistance;
+} PNTree;
+
+static int AddSat(int a, int b)
+{
+    long s = (long)a + b;
+    return (s >= PN_INFINITY) ? PN_INFINITY : (int)s;
+}
+
+// Recalcule pn/dn d'un nœud développé à partir de ses enfants
+static void UpdateNode(PNTree *tree, int index)
+{
+    PNNode *node = &tree->nodes[index];
+    bool orNode = (node->ply % 2 == 0);
+    int pn = orNode ? PN_INFINITY : 0;
+    int dn = orNode ? 0 : PN_INFINITY;
+
+    for (int i = 0; i < node->childCount; i++)
+    {
+        const PNNode *child = &tree->nodes[node->firstChild + i];
+        if (orNode)
+        {
+            if (child->pn < pn) pn = child->pn;
+            dn = AddSat(dn, child->dn);
+        }
+        else
+        {
+            pn = AddSat(pn, child->pn);
+            if (child->dn < dn) dn = child->dn;
+        }
+    }
+
+    // Nœud sans coup utile : OR sans échec = réfuté, AND sans réponse = déjà traité à la création
+    if (node->childCount == 0)
+    {
+        pn = orNode ? PN_INFINITY : 0;
+        dn = orNode ? 0 : PN_INFINITY;
+    }
+    node->pn = pn;
+    node->dn = dn;
+}
+
+static int NewNode(PNTree *tree, Move move, int parent, int ply)
+{
+    PNNode *node = &tree->nodes[tree->count];
+    node->move = move;
+    node->parent = parent;
+    node->firstChild = -1;
+    node->childCount = 0;
+    node->pn = 1;
+    node->dn = 1;
+    node->ply = ply;
+    node->expanded = false;
+    return (int)tree->count++;
+}
+
+// Développe un nœud (le plateau est dans la position du nœud)
+static bool ExpandNode(PNTree *tree, Board *board, int index)
+{
+    Move moves[MAX_MOVES];
+    int ply = tree->nodes[index].ply;
+    bool orNode = (ply % 2 == 0);
+    int mover = orNode ? tree->attacker : 1 - tree->attacker;
+    int count = GenerateLegalMoves(board, moves, mover);
+
+    if (tree->count + count > tree->capacity) return false; // Plus de place
+
+    tree->nodes[index].firstChild = (int)tree->count;
+    tree->nodes[index].expanded = true;
+
+    if (orNode)
+    {
+        // Attaquant : seuls les échecs sont examinés
+        int attackerMove = ply / 2 + 1;
+        for (int i = 0; i < count; i++)
+        {
+            SimulateMove(board, moves[i]);
+            if (IsKingInCheck(board, 1 - tree->attacker))
+            {
+                Move replies[MAX_MOVES];
+                int replyCount = GenerateLegalMoves(board, replies, 1 - tree->attacker);
+
+                int child = NewNode(tree, moves[i], index, ply + 1);
+                if (replyCount == 0)
+                {
+                    // Mat !
+                    tree->nodes[child].pn = 0;
+                    tree->nodes[child].dn = PN_INFINITY;
+                    tree->nodes[child].expanded = true;
+                    tree->nodes[child].firstChild = (int)tree->count;
+                }
+                else if (attackerMove >= tree->maxMateDistance)
+                {
+                    // Distance maximale atteinte sans mat
+                    tree->nodes[child].pn = PN_INFINITY;
+                    tree->nodes[child].dn = 0;
+                }
+                else
+                {
+                    // Moins le défenseur a de réponses, plus le mat est probable
+                    tree->nodes[child].pn = replyCount;
+                }
+                tree->nodes[index].childCount++;
+            }
+            UndoSimulatedMove(board, moves[i]);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < count; i++)
+        {
+            NewNode(tree, moves[i], index, ply + 1);
+            tree->nodes[index].childCount++;
+        }
+    }
+
+    UpdateNode(tree, index);
+    return true;
+}
+
+// Longueur (en demi-coups) du mat prouvé sous un nœud, défense la plus longue
+static int ProofLength(const PNTree *tree, int index)
+{
+    const PNNode *node = &tree->nodes[index];
+    if (node->childCount == 0) return 0;
+
+    bool orNode = (node->ply % 2 == 0);
+    int best = orNode ? PN_INFINITY : -1;
+    for (int i = 0; i < node->childCount; i++)
+    {
+        int c = node->firstChild + i;
+        if (orNode && tree->nodes[c].pn != 0) continue;
+        int length = ProofLength(tree, c) + 1;
+        if (orNode ? (length < best) : (length > best)) best = length;
+    }
+    return best;
+}
+
+bool MateSearch(Board *board, int attackerColor, int maxMateDistance, long maxNodes, MateResult *result)
+{
+    result->found = false;
+    result->mateIn = 0;
+    result->lineLength = 0;
+    result->nodes = 0;
+
+    if (maxMateDistance > MATE_MAX_DISTANCE) maxMateDistance = MATE_MAX_DISTANCE;
+    if (maxMateDistance < 1 || maxNodes < 1) return false;
+
+    PNTree tree;
+    tree.nodes = malloc(sizeof(PNNode) * (size_t)maxNodes);
+    if (tree.nodes == NULL) return false;
+    tree.count = 0;
+    tree.capacity = maxNodes;
+    tree.attacker = attackerColor;
+    tree.maxMateDistance = maxMateDistance;
+
+    Move none = { -1, -1, -1, -1, 0, 0, false, -1, -1 };
+    NewNode(&tree, none, -1, 0);
+
+    Move path[2 * MATE_MAX_DISTANCE];
+    while (tree.nodes[0].pn != 0 && tree.nodes[0].dn != 0)
+    {
+        // 1. Descente vers le nœud le plus prouvant
+        int index = 0;
+        int depth = 0;
+        while (tree.nodes[index].expanded)
+        {
+            const PNNode *node = &tree.nodes[index];
+            bool orNode = (node->ply % 2 == 0);
+            int best = node->firstChild;
+            for (int i = 1; i < node->childCount; i++)
+            {
+                const PNNode *c = &tree.nodes[node->firstChild + i];
+                if (orNode ? (c->pn < tree.nodes[best].pn) : (c->dn < tree.nodes[best].dn))
+                {
+                    best = node->firstChild + i;
+                }
+            }
+            index = best;
+            path[depth++] = tree.nodes[index].move;
+            SimulateMove(board, tree.nodes[index].move);
+        }
+
+        // 2. Développement
+        bool ok = ExpandNode(&tree, board, index);
+
+        // 3. Retour à la racine en mettant à jour les ancêtres
+        for (int d = depth - 1; d >= 0; d--) UndoSimulatedMove(board, path[d]);
+        if (!ok) break;
+
+        for (int p = tree.nodes[index].parent; p != -1; p = tree.nodes[p].parent)
+        {
+            UpdateNode(&tree, p);
+        }
+    }
+
+    result->nodes = tree.count;
+    if (tree.nodes[0].pn == 0)
+    {
+        // Extraction de la variante : plus court mat pour l'attaquant, défense la plus longue
+        int index = 0;
+        while (tree.nodes[index].childCount > 0 && result->lineLength < MATE_MAX_LINE)
+        {
+            const PNNode *node = &tree.nodes[index];
+            bool orNode = (node->ply % 2 == 0);
+            int chosen = -1;
+            int chosenLength = orNode ? PN_INFINITY : -1;
+            for (int i = 0; i < node->childCount; i++)
+            {
+                int c = node->firstChild + i;
+                if (tree.nodes[c].pn != 0) continue;
+                int length = ProofLength(&tree, c);
+                if (orNode ? (length < chosenLength) : (length > chosenLength))
+                {
+                    chosen = c;
+                    chosenLength = length;
+                }
+            }
+            if (chosen == -1) break;
+            result->line[result->lineLength++] = tree.nodes[chosen].move;
+            index = chosen;
+        }
+        result->found = true;
+        result->mateIn = (result->lineLength + 1) / 2;
+    }
+
+    free(tree.nodes);
+    return result->found;
+}
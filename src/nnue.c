@@ -0,0 +1,308 @@
+#include "nnue.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define NNUE_USE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define NNUE_USE_SSE2
+#endif
+
+// Décalage appliqué après chaque couche (poids quantifiés sur 6 bits) et échelle de sortie
+#define NNUE_WEIGHT_SHIFT 6
+#define NNUE_OUTPUT_SCALE 16
+#define NNUE_MAX_SCORE 30000 // Reste loin des scores de mat (INFINITY)
+
+// POIDS DU RÉSEAU (chargés une seule fois au démarrage)
+static bool gNNUELoaded = false;
+static int16_t *gFTWeights = NULL;                       // [NNUE_INPUTS][NNUE_HALF_DIMS]
+static int16_t gFTBias[NNUE_HALF_DIMS];
+static int32_t gL1Bias[NNUE_L1];
+static int8_t gL1Weights[NNUE_L1][2 * NNUE_HALF_DIMS];
+static int32_t gL2Bias[NNUE_L2];
+static int8_t gL2Weights[NNUE_L2][NNUE_L1];
+static int32_t gOutBias;
+static int8_t gOutWeights[NNUE_L2];
+
+// NOYAUX SIMD (AVX2 / SSE2 / version scalaire)
+
+// acc[i] += row[i]
+static void VecAddI16(int16_t *acc, const int16_t *row)
+{
+#if defined(NNUE_USE_AVX2)
+    for (int i = 0; i < NNUE_HALF_DIMS; i += 16)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(acc + i));
+        __m256i w = _mm256_loadu_si256((const __m256i *)(row + i));
+        _mm256_storeu_si256((__m256i *)(acc + i), _mm256_add_epi16(a, w));
+    }
+#elif defined(NNUE_USE_SSE2)
+    for (int i = 0; i < NNUE_HALF_DIMS; i += 8)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *)(acc + i));
+        __m128i w = _mm_loadu_si128((const __m128i *)(row + i));
+        _mm_storeu_si128((__m128i *)(acc + i), _mm_add_epi16(a, w));
+    }
+#else
+    for (int i = 0; i < NNUE_HALF_DIMS; i++) acc[i] += row[i];
+#endif
+}
+
+// acc[i] -= row[i]
+static void VecSubI16(int16_t *acc, const int16_t *row)
+{
+#if defined(NNUE_USE_AVX2)
+    for (int i = 0; i < NNUE_HALF_DIMS; i += 16)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(acc + i));
+        __m256i w = _mm256_loadu_si256((const __m256i *)(row + i));
+        _mm256_storeu_si256((__m256i *)(acc + i), _mm256_sub_epi16(a, w));
+    }
+#elif defined(NNUE_USE_SSE2)
+    for (int i = 0; i < NNUE_HALF_DIMS; i += 8)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *)(acc + i));
+        __m128i w = _mm_loadu_si128((const __m128i *)(row + i));
+        _mm_storeu_si128((__m128i *)(acc + i), _mm_sub_epi16(a, w));
+    }
+#else
+    for (int i = 0; i < NNUE_HALF_DIMS; i++) acc[i] -= row[i];
+#endif
+}
+
+// out[i] = clamp(in[i], 0, 127) (n multiple de 16)
+static void ClipI16ToU8(uint8_t *out, const int16_t *in, int n)
+{
+#if defined(NNUE_USE_AVX2) || defined(NNUE_USE_SSE2)
+    const __m128i maxv = _mm_set1_epi16(127);
+    for (int i = 0; i < n; i += 16)
+    {
+        __m128i lo = _mm_min_epi16(_mm_loadu_si128((const __m128i *)(in + i)), maxv);
+        __m128i hi = _mm_min_epi16(_mm_loadu_si128((const __m128i *)(in + i + 8)), maxv);
+        _mm_storeu_si128((__m128i *)(out + i), _mm_packus_epi16(lo, hi)); // packus sature aussi à 0
+    }
+#else
+    for (int i = 0; i < n; i++)
+    {
+        int v = in[i];
+        out[i] = (uint8_t)(v < 0 ? 0 : (v > 127 ? 127 : v));
+    }
+#endif
+}
+
+// Produit scalaire uint8 x int8 -> int32 (n multiple de 32)
+static int32_t DotU8I8(const uint8_t *a, const int8_t *b, int n)
+{
+#if defined(NNUE_USE_AVX2)
+    __m256i sum = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi16(1);
+    for (int i = 0; i < n; i += 32)
+    {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(b + i));
+        // a <= 127 : maddubs ne peut pas saturer
+        __m256i prod = _mm256_madd_epi16(_mm256_maddubs_epi16(va, vb), ones);
+        sum = _mm256_add_epi32(sum, prod);
+    }
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+    return _mm_cvtsi128_si32(s);
+#elif defined(NNUE_USE_SSE2)
+    __m128i sum = _mm_setzero_si128();
+    const __m128i zero = _mm_setzero_si128();
+    for (int i = 0; i < n; i += 16)
+    {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + i));
+        __m128i sign = _mm_cmpgt_epi8(zero, vb); // Extension de signe int8 -> int16
+        __m128i aLo = _mm_unpacklo_epi8(va, zero);
+        __m128i aHi = _mm_unpackhi_epi8(va, zero);
+        __m128i bLo = _mm_unpacklo_epi8(vb, sign);
+        __m128i bHi = _mm_unpackhi_epi8(vb, sign);
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(aLo, bLo));
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(aHi, bHi));
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+    return _mm_cvtsi128_si32(sum);
+#else
+    int32_t sum = 0;
+    for (int i = 0; i < n; i++) sum += (int32_t)a[i] * (int32_t)b[i];
+    return sum;
+#endif
+}
+
+// INDEXATION DES ENTRÉES
+
+// Type de pièce 0..4 (Pion, Cavalier, Fou, Tour, Reine), -1 pour le roi ou un sol
+static int PieceType(int pieceID)
+{
+    switch (pieceID)
+    {
+        case 6: case 7: return 0;
+        case 2: case 3: return 1;
+        case 4: case 5: return 2;
+        case 12: case 13: return 3;
+        case 8: case 9: return 4;
+        default: return -1;
+    }
+}
+
+// Les Noirs voient le plateau retourné verticalement
+static int Orient(int perspective, int square)
+{
+    return (perspective == 0) ? square : (square ^ 56);
+}
+
+static int FeatureIndex(int perspective, int kingSquare, int pieceID, int square)
+{
+    int type = PieceType(pieceID);
+    if (type < 0) return -1;
+
+    int color = pieceID % 2; // Pairs = Blancs, impairs = Noirs
+    int pieceIndex = (color == perspective) ? type : type + 5;
+    return (Orient(perspective, kingSquare) * NNUE_PIECE_TYPES + pieceIndex) * 64 + Orient(perspective, square);
+}
+
+// CHARGEMENT
+
+bool NNUE_Load(const char *path)
+{
+    NNUE_Unload();
+
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) return false;
+
+    char magic[8];
+    uint32_t version = 0;
+    uint32_t halfDims = 0;
+    bool ok = fread(magic, 1, 8, f) == 8 && memcmp(magic, NNUE_MAGIC, 8) == 0
+           && fread(&version, sizeof(version), 1, f) == 1 && version == NNUE_VERSION
+           && fread(&halfDims, sizeof(halfDims), 1, f) == 1 && halfDims == NNUE_HALF_DIMS;
+
+    if (ok)
+    {
+        gFTWeights = malloc(sizeof(int16_t) * (size_t)NNUE_INPUTS * NNUE_HALF_DIMS);
+        ok = gFTWeights != NULL
+          && fread(gFTBias, sizeof(gFTBias), 1, f) == 1
+          && fread(gFTWeights, sizeof(int16_t) * NNUE_HALF_DIMS, NNUE_INPUTS, f) == NNUE_INPUTS
+          && fread(gL1Bias, sizeof(gL1Bias), 1, f) == 1
+          && fread(gL1Weights, sizeof(gL1Weights), 1, f) == 1
+          && fread(gL2Bias, sizeof(gL2Bias), 1, f) == 1
+          && fread(gL2Weights, sizeof(gL2Weights), 1, f) == 1
+          && fread(&gOutBias, sizeof(gOutBias), 1, f) == 1
+          && fread(gOutWeights, sizeof(gOutWeights), 1, f) == 1;
+    }
+    fclose(f);
+
+    if (!ok)
+    {
+        NNUE_Unload();
+        return false;
+    }
+    gNNUELoaded = true;
+    return true;
+}
+
+void NNUE_Unload(void)
+{
+    free(gFTWeights);
+    gFTWeights = NULL;
+    gNNUELoaded = false;
+}
+
+bool NNUE_IsLoaded(void)
+{
+    return gNNUELoaded;
+}
+
+// ACCUMULATEUR
+
+void NNUE_Refresh(NNUEAccumulator *acc, const int squares[64])
+{
+    if (!gNNUELoaded) return;
+
+    for (int p = 0; p < 2; p++)
+    {
+        if (acc->computed[p]) continue;
+
+        int kingID = (p == 0) ? 10 : 11;
+        int kingSquare = -1;
+        for (int sq = 0; sq < 64; sq++)
+        {
+            if (squares[sq] == kingID) kingSquare = sq;
+        }
+        if (kingSquare == -1) continue; // Position sans roi : rien à évaluer
+
+        memcpy(acc->values[p], gFTBias, sizeof(gFTBias));
+        for (int sq = 0; sq < 64; sq++)
+        {
+            int index = FeatureIndex(p, kingSquare, squares[sq], sq);
+            if (index >= 0) VecAddI16(acc->values[p], gFTWeights + (size_t)index * NNUE_HALF_DIMS);
+        }
+        acc->kingSquare[p] = kingSquare;
+        acc->computed[p] = true;
+    }
+}
+
+void NNUE_ApplyChanges(NNUEAccumulator *acc,
+                       const NNUEFeature *removed, int removedCount,
+                       const NNUEFeature *added, int addedCount)
+{
+    if (!gNNUELoaded) return;
+
+    for (int p = 0; p < 2; p++)
+    {
+        if (!acc->computed[p]) continue; // Sera recalculée au prochain NNUE_Refresh
+
+        for (int i = 0; i < removedCount; i++)
+        {
+            int index = FeatureIndex(p, acc->kingSquare[p], removed[i].pieceID, removed[i].square);
+            if (index >= 0) VecSubI16(acc->values[p], gFTWeights + (size_t)index * NNUE_HALF_DIMS);
+        }
+        for (int i = 0; i < addedCount; i++)
+        {
+            int index = FeatureIndex(p, acc->kingSquare[p], added[i].pieceID, added[i].square);
+            if (index >= 0) VecAddI16(acc->values[p], gFTWeights + (size_t)index * NNUE_HALF_DIMS);
+        }
+    }
+}
+
+// PROPAGATION AVANT
+
+int NNUE_Evaluate(const NNUEAccumulator *acc, int sideToMove)
+{
+    uint8_t input[2 * NNUE_HALF_DIMS];
+    uint8_t hidden1[NNUE_L1];
+    uint8_t hidden2[NNUE_L2];
+    int16_t tmp[NNUE_L1];
+
+    // Le camp au trait est toujours placé en premier
+    ClipI16ToU8(input, acc->values[sideToMove], NNUE_HALF_DIMS);
+    ClipI16ToU8(input + NNUE_HALF_DIMS, acc->values[1 - sideToMove], NNUE_HALF_DIMS);
+
+    for (int j = 0; j < NNUE_L1; j++)
+    {
+        int32_t v = (gL1Bias[j] + DotU8I8(input, gL1Weights[j], 2 * NNUE_HALF_DIMS)) >> NNUE_WEIGHT_SHIFT;
+        tmp[j] = (int16_t)(v < -32768 ? -32768 : (v > 32767 ? 32767 : v));
+    }
+    ClipI16ToU8(hidden1, tmp, NNUE_L1);
+
+    for (int j = 0; j < NNUE_L2; j++)
+    {
+        int32_t v = (gL2Bias[j] + DotU8I8(hidden1, gL2Weights[j], NNUE_L1)) >> NNUE_WEIGHT_SHIFT;
+        tmp[j] = (int16_t)(v < -32768 ? -32768 : (v > 32767 ? 32767 : v));
+    }
+    ClipI16ToU8(hidden2, tmp, NNUE_L2);
+
+    int32_t out = (gOutBias + DotU8I8(hidden2, gOutWeights, NNUE_L2)) / NNUE_OUTPUT_SCALE;
+    if (out > NNUE_MAX_SCORE) out = NNUE_MAX_SCORE;
+    if (out < -NNUE_MAX_SCORE) out = -NNUE_MAX_SCORE;
+
+    // Le réseau évalue du point de vue du camp au trait, le moteur attend Blanc positif
+    return (sideToMove == 0) ? out : -out;
+}
@@ -0,0 +1,179 @@
+#include "notation.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ID (blanc) d'une lettre de pièce, 0 si ce n'est pas une pièce
+static int PieceFromLetter(char c)
+{
+    switch (c)
+    {
+        case 'N': return 2;
+        case 'B': return 4;
+        case 'Q': return 8;
+        case 'K': return 10;
+        case 'R': return 12;
+        default: return 0;
+    }
+}
+
+bool ParseSAN(Board *board, int side, const char *san, Move *move, int *promotionPieceID)
+{
+    // Copie nettoyée : sans échec, mat ni annotations
+    char text[16];
+    int length = 0;
+    for (const char *p = san; *p != '\0' && length < (int)sizeof(text) - 1; p++)
+    {
+        if (*p == '+' || *p == '#' || *p == '!' || *p == '?') continue;
+        text[length++] = *p;
+    }
+    text[length] = '\0';
+    if (length < 2) return false;
+
+    Move moves[MAX_MOVES];
+    int count = GenerateLegalMoves(board, moves, side);
+    *promotionPieceID = 0;
+
+    // Roques
+    if (strcmp(text, "O-O") == 0 || strcmp(text, "0-0") == 0 || strcmp(text, "O-O-O") == 0 || strcmp(text, "0-0-0") == 0)
+    {
+        int direction = (length == 3) ? 1 : -1;
+        for (int i = 0; i < count; i++)
+        {
+            if (moves[i].movingPieceID == 10 + side && moves[i].endX - moves[i].startX == 2 * direction)
+            {
+                *move = moves[i];
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Promotion : "e8=Q" ou "e8Q"
+    int promotion = 0;
+    if (length >= 2 && PieceFromLetter(text[length - 1]) != 0 && text[length - 1] != 'K')
+    {
+        promotion = PieceFromLetter(text[length - 1]) + side;
+        length--;
+        if (length > 0 && text[length - 1] == '=') length--;
+        text[length] = '\0';
+    }
+
+    // Pièce qui joue (pion si pas de lettre)
+    int pieceID = 6 + side;
+    int start = 0;
+    if (PieceFromLetter(text[0]) != 0)
+    {
+        pieceID = PieceFromLetter(text[0]) + side;
+        start = 1;
+    }
+
+    // Case d'arrivée : les deux derniers caractères
+    if (length - start < 2) return false;
+    char fileChar = text[length - 2];
+    char rankChar = text[length - 1];
+    if (fileChar < 'a' || fileChar > 'h' || rankChar < '1' || rankChar > '8') return false;
+    int endX = fileChar - 'a';
+    int endY = '8' - rankChar;
+
+    // Désambiguïsation éventuelle (colonne et/ou rangée de départ)
+    int fromX = -1;
+    int fromY = -1;
+    for (int i = start; i < length - 2; i++)
+    {
+        if (text[i] >= 'a' && text[i] <= 'h') fromX = text[i] - 'a';
+        else if (text[i] >= '1' && text[i] <= '8') fromY = '8' - text[i];
+        else if (text[i] != 'x' && text[i] != '-') return false;
+    }
+
+    int found = -1;
+    for (int i = 0; i < count; i++)
+    {
+        const Move *m = &moves[i];
+        if (m->movingPieceID != pieceID || m->endX != endX || m->endY != endY) continue;
+        if (fromX != -1 && m->startX != fromX) continue;
+        if (fromY != -1 && m->startY != fromY) continue;
+        if (found != -1) return false; // Ambigu
+        found = i;
+    }
+    if (found == -1) return false;
+
+    *move = moves[found];
+    *promotionPieceID = promotion;
+    return true;
+}
+
+// Lettre d'une pièce (majuscule), 0 pour un pion
+static char LetterFromPiece(int pieceID)
+{
+    switch (pieceID & ~1)
+    {
+        case 2: return 'N';
+        case 4: return 'B';
+        case 8: return 'Q';
+        case 10: return 'K';
+        case 12: return 'R';
+        default: return 0;
+    }
+}
+
+void MoveToSAN(Board *board, Move move, int promotionPieceID, char out[16])
+{
+    int side = GetPieceColor(move.movingPieceID);
+    int length = 0;
+    char letter = LetterFromPiece(move.movingPieceID);
+    bool capture = (move.capturedPieceID != 0 || move.isEnPassant);
+
+    if (letter == 'K' && abs(move.endX - move.startX) == 2)
+    {
+        strcpy(out, (move.endX > move.startX) ? "O-O" : "O-O-O");
+        length = (int)strlen(out);
+    }
+    else
+    {
+        if (letter != 0)
+        {
+            out[length++] = letter;
+
+            // Désambiguïsation : une autre pièce du même type atteint la même case
+            Move moves[MAX_MOVES];
+            int count = GenerateLegalMoves(board, moves, side);
+            bool sameFile = false, sameRank = false, ambiguous = false;
+            for (int i = 0; i < count; i++)
+            {
+                const Move *m = &moves[i];
+                if (m->movingPieceID != move.movingPieceID || m->endX != move.endX || m->endY != move.endY) continue;
+                if (m->startX == move.startX && m->startY == move.startY) continue;
+                ambiguous = true;
+                if (m->startX == move.startX) sameFile = true;
+                if (m->startY == move.startY) sameRank = true;
+            }
+            if (ambiguous && (!sameFile || sameRank)) out[length++] = (char)('a' + move.startX);
+            if (ambiguous && sameFile) out[length++] = (char)('8' - move.startY);
+        }
+        else if (capture)
+        {
+            out[length++] = (char)('a' + move.startX); // Pion : colonne de départ
+        }
+
+        if (capture) out[length++] = 'x';
+        out[length++] = (char)('a' + move.endX);
+        out[length++] = (char)('8' - move.endY);
+
+        bool promotes = (letter == 0 && (move.endY == 0 || move.endY == 7));
+        if (promotes)
+        {
+            out[length++] = '=';
+            out[length++] = (promotionPieceID != 0) ? LetterFromPiece(promotionPieceID) : 'Q';
+        }
+    }
+
+    // Échec ou mat : on joue le coup sur une copie
+    Board after = *board;
+    ApplyMove(&after, move, promotionPieceID);
+    if (IsKingInCheck(&after, 1 - side))
+    {
+        Move replies[MAX_MOVES];
+        out[length++] = (GenerateLegalMoves(&after, replies, 1 - side) == 0) ? '#' : '+';
+    }
+    out[length] = '\0';
+}
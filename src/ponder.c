@@ -0,0 +1,109 @@
+#include "ponder.h"
+#include "searchstats.h"
+#include "tt.h"
+#include <pthread.h>
+#include <stdatomic.h>
+
+// État partagé avec le thread de réflexion : il n'écrit que gBestMove, gStats et gDone,
+// lus par le jeu seulement après gDone (puis pthread_join)
+static pthread_t gThread;
+static bool gRunning = false;   // Thread lancé et pas encore rejoint
+static atomic_bool gDone;
+static SearchControl gControl;
+static uint64_t gKey;
+static Move gBestMove;
+static SearchStats gStats;
+
+#ifndef SEARCH_TRACE // Pas de thread de réflexion avec la trace (voir Ponder_Start)
+static Board gBoard;            // Position après la réponse attendue
+static SearchLimits gLimits;
+
+static void *PonderMain(void *arg)
+{
+    (void)arg;
+    gBestMove = ChooseMoveWithLimits(&gBoard, &gLimits);
+    gStats = *GetLastSearchStats(); // Statistiques propres à ce thread
+    atomic_store(&gDone, true);
+    return NULL;
+}
+#endif
+
+bool Ponder_Start(const Board *board, Move reply, const SearchLimits *limits)
+{
+    Ponder_Stop();
+#ifdef SEARCH_TRACE
+    // La trace de recherche n'enregistre qu'un seul thread
+    (void)board;
+    (void)reply;
+    (void)limits;
+    return false;
+#else
+    // Variante principale coupée (startX = -1) : coup de la table de transposition.
+    // Dans les deux cas, on retrouve le coup légal complet.
+    gBoard = *board;
+    int side = gBoard.sideToMove;
+    uint16_t packed = TT_MOVE_NONE;
+    TTEntry entry;
+    if (reply.startX >= 0) packed = TT_MOVE(reply.startX, reply.startY, reply.endX, reply.endY);
+    else if (TT_Probe(PositionKey(&gBoard, side), &entry)) packed = entry.move;
+    if (packed == TT_MOVE_NONE) return false;
+
+    Move moves[MAX_MOVES];
+    int count = GenerateLegalMoves(&gBoard, moves, side);
+    int found = -1;
+    for (int i = 0; i < count && found < 0; i++)
+    {
+        if (TT_MOVE(moves[i].startX, moves[i].startY, moves[i].endX, moves[i].endY) == packed) found = i;
+    }
+    if (found < 0) return false;
+
+    ApplyMove(&gBoard, moves[found], 0); // Promotion supposée en Dame ; sinon la clé ne correspondra pas
+    gBoard.sideToMove = 1 - side;
+    if (GenerateLegalMoves(&gBoard, moves, gBoard.sideToMove) == 0) return false;
+
+    gKey = PositionKey(&gBoard, gBoard.sideToMove);
+    gLimits = *limits;
+    gLimits.threads = 1;
+    gLimits.control = &gControl;
+    gLimits.onIteration = NULL;
+    SearchControl_Reset(&gControl);
+    atomic_store(&gDone, false);
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, PONDER_THREAD_STACK);
+    gRunning = (pthread_create(&gThread, &attr, PonderMain, NULL) == 0);
+    pthread_attr_destroy(&attr);
+    return gRunning;
+#endif
+}
+
+bool Ponder_IsActive(void)
+{
+    return gRunning;
+}
+
+bool Ponder_Matches(const Board *board)
+{
+    return gRunning && PositionKey(board, board->sideToMove) == gKey;
+}
+
+bool Ponder_Result(Move *bestMove)
+{
+    if (!gRunning || !atomic_load(&gDone)) return false;
+
+    pthread_join(gThread, NULL);
+    gRunning = false;
+    *bestMove = gBestMove;
+    SetLastSearchStats(&gStats);
+    return true;
+}
+
+void Ponder_Stop(void)
+{
+    if (!gRunning) return;
+
+    SearchControl_Stop(&gControl);
+    pthread_join(gThread, NULL);
+    gRunning = false;
+}
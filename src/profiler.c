@@ -0,0 +1,158 @@
+#include "profiler.h"
+#include "clock.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct
+{
+    const char *name;
+    uint64_t startNs;
+    uint64_t durationNs;
+    int threadId;
+} ProfEvent;
+
+static ProfEvent gEvents[PROF_MAX_EVENTS];
+static long gEventCount = 0; // Total écrit (l'indice réel est modulo PROF_MAX_EVENTS)
+static pthread_mutex_t gEventLock = PTHREAD_MUTEX_INITIALIZER;
+
+static float gFrameMs[PROF_MAX_FRAMES];
+static int gFrameCount = 0;
+static uint64_t gFrameStart = 0;
+
+// Identifiant court par thread pour la colonne "tid" de la trace
+static atomic_int gNextThreadId = 1;
+static _Thread_local int tlsThreadId = 0;
+
+static int ThreadId(void)
+{
+    if (tlsThreadId == 0) tlsThreadId = atomic_fetch_add(&gNextThreadId, 1);
+    return tlsThreadId;
+}
+
+uint64_t Prof_Begin(void)
+{
+    return Clock_NowNs();
+}
+
+void Prof_End(const char *name, uint64_t startNs)
+{
+    uint64_t now = Clock_NowNs();
+    ProfEvent e = { name, startNs, now - startNs, ThreadId() };
+
+    pthread_mutex_lock(&gEventLock);
+    gEvents[gEventCount % PROF_MAX_EVENTS] = e;
+    gEventCount++;
+    pthread_mutex_unlock(&gEventLock);
+}
+
+void Prof_FrameMark(void)
+{
+    uint64_t now = Clock_NowNs();
+    if (gFrameStart != 0)
+    {
+        Prof_End("Frame", gFrameStart);
+        gFrameMs[gFrameCount % PROF_MAX_FRAMES] = (float)((double)(now - gFrameStart) * 1e-6);
+        gFrameCount++;
+    }
+    gFrameStart = now;
+}
+
+int Prof_FrameTimes(float *outMs, int max)
+{
+    int available = (gFrameCount < PROF_MAX_FRAMES) ? gFrameCount : PROF_MAX_FRAMES;
+    int n = (available < max) ? available : max;
+    for (int i = 0; i < n; i++)
+    {
+        outMs[i] = gFrameMs[(gFrameCount - n + i) % PROF_MAX_FRAMES];
+    }
+    return n;
+}
+
+static int CompareFloats(const void *a, const void *b)
+{
+    float x = *(const float *)a;
+    float y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+bool Prof_FramePercentiles(float *p50, float *p95, float *p99, float *maxMs)
+{
+    static float sorted[PROF_MAX_FRAMES];
+    int n = Prof_FrameTimes(sorted, PROF_MAX_FRAMES);
+    if (n == 0) return false;
+
+    qsort(sorted, (size_t)n, sizeof(float), CompareFloats);
+    *p50 = sorted[(n - 1) * 50 / 100];
+    *p95 = sorted[(n - 1) * 95 / 100];
+    *p99 = sorted[(n - 1) * 99 / 100];
+    *maxMs = sorted[n - 1];
+    return true;
+}
+
+// Première zone commencée après 'sinceNs', en remontant depuis la plus récente (verrou tenu)
+static long FirstEventSince(uint64_t sinceNs)
+{
+    long oldest = (gEventCount > PROF_MAX_EVENTS) ? gEventCount - PROF_MAX_EVENTS : 0;
+    long first = gEventCount;
+    while (first > oldest && gEvents[(first - 1) % PROF_MAX_EVENTS].startNs >= sinceNs) first--;
+    return first;
+}
+
+int Prof_ZoneSummary(ProfZoneStat *out, int max, double windowSeconds)
+{
+    uint64_t now = Clock_NowNs();
+    uint64_t window = (uint64_t)(windowSeconds * 1e9);
+    uint64_t since = (now > window) ? now - window : 0;
+    int count = 0;
+
+    pthread_mutex_lock(&gEventLock);
+    for (long i = FirstEventSince(since); i < gEventCount; i++)
+    {
+        const ProfEvent *e = &gEvents[i % PROF_MAX_EVENTS];
+        int k = 0;
+        while (k < count && strcmp(out[k].name, e->name) != 0) k++;
+        if (k == count)
+        {
+            if (count == max) continue;
+            out[count++] = (ProfZoneStat){ e->name, 0, 0.0, 0.0 };
+        }
+
+        double ms = (double)e->durationNs * 1e-6;
+        out[k].calls++;
+        out[k].totalMs += ms;
+        if (ms > out[k].maxMs) out[k].maxMs = ms;
+    }
+    pthread_mutex_unlock(&gEventLock);
+    return count;
+}
+
+bool Prof_WriteChromeTrace(const char *path, double lastSeconds)
+{
+    FILE *f = fopen(path, "w");
+    if (f == NULL) return false;
+
+    uint64_t now = Clock_NowNs();
+    uint64_t window = (uint64_t)(lastSeconds * 1e9);
+    uint64_t since = (now > window) ? now - window : 0;
+
+    // Format "trace event" : zones complètes ("X"), temps en microsecondes
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Jeu d'echecs\"}}");
+
+    pthread_mutex_lock(&gEventLock);
+    for (long i = FirstEventSince(since); i < gEventCount; i++)
+    {
+        const ProfEvent *e = &gEvents[i % PROF_MAX_EVENTS];
+        fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+            e->name, e->threadId, (double)(e->startNs - since) * 1e-3, (double)e->durationNs * 1e-3);
+    }
+    pthread_mutex_unlock(&gEventLock);
+
+    fprintf(f, "\n]}\n");
+    bool ok = (ferror(f) == 0);
+    fclose(f);
+    return ok;
+}
@@ -0,0 +1,54 @@
+#include "profoverlay.h"
+#include "profiler.h"
+#include "raylib.h"
+
+#define OVERLAY_GRAPH_FRAMES 240
+#define OVERLAY_MAX_ZONES 16
+
+void ProfOverlay_Draw(void)
+{
+    const int x = 10;
+    const int y = 10;
+    const int width = 360;
+    const int graphHeight = 80;
+
+    ProfZoneStat zones[OVERLAY_MAX_ZONES];
+    int zoneCount = Prof_ZoneSummary(zones, OVERLAY_MAX_ZONES, 1.0);
+    int height = 60 + graphHeight + zoneCount * 16;
+
+    DrawRectangle(x, y, width, height, Fade(BLACK, 0.75f));
+
+    float p50 = 0, p95 = 0, p99 = 0, maxMs = 0;
+    Prof_FramePercentiles(&p50, &p95, &p99, &maxMs);
+    DrawText(TextFormat("Image  p50 %.1f  p95 %.1f  p99 %.1f  max %.1f ms", p50, p95, p99, maxMs), x + 8, y + 8, 14, RAYWHITE);
+
+    // Graphe : une barre par image, échelle fixe de 0 à 33 ms (ligne à 16,7 ms)
+    float frames[OVERLAY_GRAPH_FRAMES];
+    int n = Prof_FrameTimes(frames, OVERLAY_GRAPH_FRAMES);
+    int graphY = y + 30;
+    float scale = (float)graphHeight / 33.3f;
+    float barWidth = (float)(width - 16) / OVERLAY_GRAPH_FRAMES;
+    for (int i = 0; i < n; i++)
+    {
+        float h = frames[i] * scale;
+        if (h > graphHeight) h = (float)graphHeight;
+        Color c = (frames[i] > 33.3f) ? RED : (frames[i] > 16.7f) ? ORANGE : GREEN;
+        DrawRectangleRec((Rectangle){ x + 8 + i * barWidth, graphY + graphHeight - h, barWidth, h }, c);
+    }
+    DrawLine(x + 8, graphY + graphHeight - (int)(16.7f * scale), x + width - 8, graphY + graphHeight - (int)(16.7f * scale), Fade(RAYWHITE, 0.5f));
+
+    // Zones de la dernière seconde : appels, temps moyen et maximum
+    int rowY = graphY + graphHeight + 10;
+    DrawText("zone", x + 8, rowY, 12, GRAY);
+    DrawText("appels", x + 200, rowY, 12, GRAY);
+    DrawText("moy ms", x + 250, rowY, 12, GRAY);
+    DrawText("max ms", x + 305, rowY, 12, GRAY);
+    for (int i = 0; i < zoneCount; i++)
+    {
+        rowY += 16;
+        DrawText(zones[i].name, x + 8, rowY, 12, RAYWHITE);
+        DrawText(TextFormat("%d", zones[i].calls), x + 200, rowY, 12, RAYWHITE);
+        DrawText(TextFormat("%.2f", zones[i].totalMs / zones[i].calls), x + 250, rowY, 12, RAYWHITE);
+        DrawText(TextFormat("%.2f", zones[i].maxMs), x + 305, rowY, 12, RAYWHITE);
+    }
+}
@@ -0,0 +1,195 @@
+#include "replay.h"
+#include "game.h"
+#include "input.h"
+#include "assets.h"
+#include "clock.h"
+#include "profiler.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct
+{
+    double totalMs;
+    double meanMs;
+    double p50, p95, p99;
+    double maxMs;
+    long maxFrame;
+} FrameTimeSummary;
+
+static int CompareTimes(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static double PercentileMs(const uint64_t *sorted, long count, double p)
+{
+    long index = (long)(p * (double)(count - 1) + 0.5);
+    return (double)sorted[index] * 1e-6;
+}
+
+static FrameTimeSummary Summarize(const uint64_t *timesNs, long count)
+{
+    FrameTimeSummary s = { 0 };
+    if (count == 0) return s;
+
+    uint64_t *sorted = malloc((size_t)count * sizeof(uint64_t));
+    if (sorted == NULL) return s;
+
+    uint64_t total = 0;
+    for (long i = 0; i < count; i++)
+    {
+        total += timesNs[i];
+        sorted[i] = timesNs[i];
+        if (timesNs[i] > timesNs[s.maxFrame]) s.maxFrame = i;
+    }
+    qsort(sorted, (size_t)count, sizeof(uint64_t), CompareTimes);
+
+    s.totalMs = (double)total * 1e-6;
+    s.meanMs = s.totalMs / (double)count;
+    s.p50 = PercentileMs(sorted, count, 0.50);
+    s.p95 = PercentileMs(sorted, count, 0.95);
+    s.p99 = PercentileMs(sorted, count, 0.99);
+    s.maxMs = (double)sorted[count - 1] * 1e-6;
+    free(sorted);
+    return s;
+}
+
+static void PrintSummary(const char *name, const uint64_t *timesNs, long count)
+{
+    FrameTimeSummary s = Summarize(timesNs, count);
+    printf("%-10s total %9.3f ms  moyenne %7.3f  p50 %7.3f  p95 %7.3f  p99 %7.3f  max %9.3f ms (image %ld)\n",
+           name, s.totalMs, s.meanMs, s.p50, s.p95, s.p99, s.maxMs, s.maxFrame);
+}
+
+static const char *StateName(const Game *game)
+{
+    switch (game->state)
+    {
+        case STATE_MAIN_MENU: return "menu principal";
+        case STATE_DIFFICULTY_MENU: return "menu difficulté";
+        case STATE_TIME_MENU: return "menu temps";
+        case STATE_PLAYING: return "en jeu";
+        case STATE_GAMEOVER:
+            if (game->winner == 0) return "terminée, victoire des Blancs";
+            if (game->winner == 1) return "terminée, victoire des Noirs";
+            return "terminée, nulle";
+    }
+    return "?";
+}
+
+int Replay_Run(const ReplayOptions *options)
+{
+    if (!Input_LoadScript(options->scriptPath)) return 1;
+
+    long maxFrames = options->maxFrames;
+    if (maxFrames <= 0) maxFrames = Input_ScriptLastFrame() + REPLAY_TAIL_FRAMES;
+
+    uint64_t *updateNs = calloc((size_t)maxFrames, sizeof(uint64_t));
+    uint64_t *drawNs = calloc((size_t)maxFrames, sizeof(uint64_t));
+    if (updateNs == NULL || drawNs == NULL)
+    {
+        fprintf(stderr, "Rejeu : mémoire insuffisante pour %ld images\n", maxFrames);
+        free(updateNs);
+        free(drawNs);
+        return 1;
+    }
+
+    // Seuls les avertissements : le rapport final reste lisible
+    SetTraceLogLevel(LOG_WARNING);
+
+    // Sans fenêtre, GameUpdate tourne seul (les sons non chargés sont ignorés par raylib).
+    // Avec --draw, fenêtre cachée à la taille du script et assets chargés avant la première image.
+    int windowW = Input_ScreenWidth();
+    int windowH = Input_ScreenHeight();
+    if (options->draw)
+    {
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+        InitWindow(windowW, windowH, "Rejeu");
+        Assets_StartLoading(BUNDLE_PATH);
+        while (!Assets_Update()) { }
+    }
+
+    // Pendules au pas fixe des images, comme le reste du rejeu
+    GameSetFrameClock(true);
+    static Game game;
+    GameInit(&game);
+
+    FILE *csv = NULL;
+    if (options->csvPath != NULL)
+    {
+        csv = fopen(options->csvPath, "w");
+        if (csv == NULL) fprintf(stderr, "Impossible d'ouvrir %s\n", options->csvPath);
+        else fprintf(csv, "frame,update_us,draw_us,state\n");
+    }
+
+    uint64_t replayStart = Clock_NowNs();
+    long frames = 0;
+    while (frames < maxFrames)
+    {
+        Input_BeginFrame();
+
+        uint64_t t0 = Clock_NowNs();
+        PROF_BEGIN(GameUpdate);
+        GameUpdate(&game, REPLAY_DT);
+        PROF_END(GameUpdate);
+        uint64_t t1 = Clock_NowNs();
+        updateNs[frames] = t1 - t0;
+
+        if (options->draw)
+        {
+            if (Input_ScreenWidth() != windowW || Input_ScreenHeight() != windowH)
+            {
+                windowW = Input_ScreenWidth();
+                windowH = Input_ScreenHeight();
+                SetWindowSize(windowW, windowH);
+            }
+            BeginDrawing();
+            ClearBackground(BLACK);
+            PROF_BEGIN(GameDraw);
+            GameDraw(&game);
+            PROF_END(GameDraw);
+            EndDrawing();
+            drawNs[frames] = Clock_NowNs() - t1;
+        }
+        Prof_FrameMark();
+
+        if (csv != NULL)
+        {
+            fprintf(csv, "%ld,%.1f,%.1f,%d\n", frames, updateNs[frames] * 1e-3, drawNs[frames] * 1e-3, (int)game.state);
+        }
+        frames++;
+
+        // Fin du script et partie finie : inutile d'attendre la fin de la marge
+        if (Input_ScriptFinished() && game.state == STATE_GAMEOVER) break;
+    }
+    double elapsed = (double)(Clock_NowNs() - replayStart) * 1e-9;
+
+    printf("Rejeu de %s : %ld images (%.2f s de jeu, %.2f s réelles), %ld coups, partie %s\n",
+           options->scriptPath, frames, frames * REPLAY_DT, elapsed, (long)game.history.count, StateName(&game));
+    if (!Input_ScriptFinished())
+    {
+        printf("Attention : script non terminé après %ld images (--frames)\n", frames);
+    }
+    PrintSummary("GameUpdate", updateNs, frames);
+    if (options->draw) PrintSummary("GameDraw", drawNs, frames);
+
+    if (csv != NULL) fclose(csv);
+    if (options->profPath != NULL)
+    {
+        if (Prof_WriteChromeTrace(options->profPath, elapsed + 1.0)) printf("Trace du profileur : %s\n", options->profPath);
+        else fprintf(stderr, "Impossible d'écrire %s\n", options->profPath);
+    }
+
+    free(updateNs);
+    free(drawNs);
+    if (options->draw)
+    {
+        GameUnload();
+        Assets_Unload();
+        CloseWindow();
+    }
+    return 0;
+}
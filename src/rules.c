@@ -0,0 +1,956 @@
+#include "chesscore.h"
+#include "zobrist.h"
+#include <stdio.h> 
+#include <stdlib.h> 
+
+// PROTOTYPES (OBLIGATOIRES)
+static bool IsSquareAttacked(const Board *board, int x, int y, int color);
+static bool IsMoveValid(const Board *board, int startX, int startY, int endX, int endY);
+static bool IsPathClear(const Board *board, int startX, int startY, int endX, int endY);
+
+// FONCTIONS UTILITAIRES
+
+// Vide complètement une case (enlève toutes les pièces)
+static void TileClear(Tile *t) 
+{
+    t->layerCount = 0;
+    for(int i = 0; i < MAX_LAYERS; i++) 
+    {
+        t->layers[i] = 0;
+    }
+}
+
+// Ajoute une texture (ID de pièce) sur une case
+static void TilePush(Tile *t, int textureIndex) 
+{
+    if (t->layerCount < MAX_LAYERS) 
+    {
+        t->layers[t->layerCount] = textureIndex;
+        t->layerCount++;
+    }
+}
+
+// Retire la dernière texture posée (la pièce du dessus) et renvoie son ID
+static int TilePop(Tile *t) 
+{
+    if (t->layerCount <= 1) return 0; // Ne retire pas le sol
+    
+    int objectIndex = t->layers[t->layerCount - 1];
+    t->layerCount--;
+    
+    return objectIndex;
+}
+
+// Renvoie la couleur d'une pièce : 0 = Blanc, 1 = Noir, -1 = Pas une pièce
+int GetPieceColor(int textureID)
+{
+    if (textureID < 2) return -1; // Les ID 0 et 1 sont les sols
+    
+    // Astuce : Les ID pairs sont blancs, les impairs sont noirs
+    if (textureID % 2 == 0)
+    {
+        return 0; // Blanc
+    }
+    else 
+    {
+        return 1; // Noir
+    }
+}
+
+// LOGIQUE DE DÉPLACEMENT
+
+// Vérifie si le chemin est libre entre A et B (pour Tour, Fou, Reine)
+static bool IsPathClear(const Board *board, int startX, int startY, int endX, int endY)
+{
+    // Cas 1 : Déplacement Horizontal
+    if (startY == endY) 
+    {
+        int step = (endX > startX) ? 1 : -1;
+
+        // On parcourt les cases ENTRE le départ et l'arrivée
+        for (int x = startX + step; x != endX; x += step)
+        {
+            if (board->tiles[startY][x].layerCount > 1) 
+            {
+                return false; // Obstacle trouvé
+            }
+        }
+    }
+    // Cas 2 : Déplacement Vertical
+    else if (startX == endX)
+    {
+        int step = (endY > startY) ? 1 : -1;
+
+        for (int y = startY + step; y != endY; y += step)
+        {
+            if (board->tiles[y][startX].layerCount > 1) 
+            {
+                return false; // Obstacle trouvé
+            }
+        }
+    }
+    // Cas 3 : Déplacement Diagonal
+    else if (abs(endX - startX) == abs(endY - startY)) 
+    {
+        int stepX = (endX > startX) ? 1 : -1;
+        int stepY = (endY > startY) ? 1 : -1;
+
+        int x = startX + stepX; 
+        int y = startY + stepY; 
+
+        // On avance en diagonale jusqu'à la case juste avant l'arrivée
+        while (x != endX) 
+        {
+            if (board->tiles[y][x].layerCount > 1) 
+            {
+                return false; // Obstacle trouvé
+            }
+            x += stepX; 
+            y += stepY; 
+        }
+    }
+    return true; // Chemin libre
+}
+
+// Vérifie si une pièce a le droit de bouger de A vers B (Règles des échecs de base)
+static bool IsMoveValid(const Board *board, int startX, int startY, int endX, int endY)
+{
+    // Règle 0 : On ne peut pas faire du surplace
+    if (startX == endX && startY == endY) return false;
+    
+    const Tile *oldTile = &board->tiles[startY][startX];
+    const Tile *targetTile = &board->tiles[endY][endX];
+    
+    // Sécurité : Si la case de départ est vide
+    if (oldTile->layerCount <= 1) return false;
+
+    int pieceID = oldTile->layers[oldTile->layerCount - 1]; 
+    int currentTurnColor = GetPieceColor(pieceID); 
+    
+    int dx = endX - startX; 
+    int dy = endY - startY; 
+    bool ruleMatch = false;
+
+    // ANALYSE SELON LA PIÈCE
+
+    // TOUR (ID 12 Blanc, 13 Noir)
+    if (pieceID == 12 || pieceID == 13) 
+    {
+        // Doit bouger en ligne droite (soit dx est 0, soit dy est 0)
+        if ((dx != 0 && dy == 0) || (dx == 0 && dy != 0)) 
+        {
+            if (IsPathClear(board, startX, startY, endX, endY)) 
+            {
+                ruleMatch = true;
+            }
+        }
+    }
+    // FOU (ID 4 Blanc, 5 Noir)
+    else if (pieceID == 4 || pieceID == 5) 
+    {
+        // Doit bouger en diagonale parfaite (dx égal à dy en valeur absolue)
+        if (abs(dx) == abs(dy) && dx != 0) 
+        {
+            if (IsPathClear(board, startX, startY, endX, endY)) 
+            {
+                ruleMatch = true;
+            }
+        }
+    }
+    // REINE (ID 8 Blanc, 9 Noir)
+    else if (pieceID == 8 || pieceID == 9) 
+    {
+        // Combine Tour et Fou
+        if ((dx != 0 && dy == 0) || (dx == 0 && dy != 0) || (abs(dx) == abs(dy))) 
+        {
+            if (IsPathClear(board, startX, startY, endX, endY)) 
+            {
+                ruleMatch = true;
+            }
+        }
+    }
+    // ROI (ID 10 Blanc, 11 Noir)
+    else if (pieceID == 10 || pieceID == 11) 
+    {
+        // Déplacement 1 case dans toutes les directions
+        if (abs(dx) <= 1 && abs(dy) <= 1) 
+        {
+            ruleMatch = true;
+        }
+        // ROQUE
+        else if (dy == 0 && (dx == 2 || dx == -2))
+        {
+            // Roi déjà déplacé
+            if (board->kingMoved[currentTurnColor])
+                return false;
+
+            // Tour déjà déplacée
+            int rookSide = (dx == 2) ? 1 : 0; // 0=gauche, 1=droite
+            if (board->rookMoved[currentTurnColor][rookSide])
+                return false;
+
+            if (IsKingInCheck(board, currentTurnColor))
+                return false;
+
+            int rookX = (dx == 2) ? startX + 3 : startX - 4;
+
+            const Tile *rookTile = &board->tiles[startY][rookX];
+            if (rookTile->layerCount <= 1) return false;
+
+            int rookID = rookTile->layers[rookTile->layerCount - 1];
+            bool correctRook =
+                (currentTurnColor == 0 && rookID == 12) ||
+                (currentTurnColor == 1 && rookID == 13);
+
+            if (!correctRook) return false;
+
+            int step = (dx > 0) ? 1 : -1;
+
+            // Cases VIDES entre roi et tour
+            for (int x = startX + step; x != rookX; x += step)
+            {
+                if (board->tiles[startY][x].layerCount > 1)
+                    return false;
+            }
+
+            //  Cases NON ATTAQUÉES (roi → intermédiaire → arrivée)
+            for (int x = startX; x != endX + step; x += step)
+            {
+                if (IsSquareAttacked(board, x, startY, currentTurnColor))
+                    return false;
+            }
+
+            ruleMatch = true;
+        }
+    }
+    
+
+    // CAVALIER (ID 2 Blanc, 3 Noir)
+    else if (pieceID == 2 || pieceID == 3) 
+    {
+        // Mouvement en "L" (2 cases d'un côté, 1 case de l'autre)
+        if ((abs(dx) == 1 && abs(dy) == 2) || (abs(dx) == 2 && abs(dy) == 1)) 
+        {
+            ruleMatch = true;
+        }
+    }
+    // PION (ID 6 Blanc, 7 Noir)
+    else if (pieceID == 6 || pieceID == 7) 
+    {
+        int direction;
+        int initialRow;
+
+        if (currentTurnColor == 0) { // Blanc
+            direction = -1; // Monte
+            initialRow = 6;
+        } else { // Noir
+            direction = 1; // Descend
+            initialRow = 1;
+        }
+        
+        // Capture en diagonale
+        if (abs(dx) == 1 && dy == direction) 
+        {
+            // Il faut qu'il y ait une pièce ennemie sur la cible
+            if (targetTile->layerCount > 1) 
+            { 
+                int targetColor = GetPieceColor(targetTile->layers[targetTile->layerCount - 1]);
+                if (targetColor != -1 && targetColor != currentTurnColor) 
+                {
+                    ruleMatch = true; 
+                }
+            }
+            // --- MODIFICATION : PRISE EN PASSANT ---
+            // Si la case cible est vide MAIS qu'elle correspond aux coordonnées de prise en passant
+            else if (targetTile->layerCount <= 1 && endX == board->enPassantX && endY == board->enPassantY)
+            {
+                ruleMatch = true;
+            }
+        }
+        // Avance simple (1 case)
+        else if (dx == 0 && dy == direction) 
+        {
+            // La case cible doit être vide
+            if (targetTile->layerCount == 1) 
+            {
+                ruleMatch = true;
+            }
+        }
+        // Double avance (Premier tour)
+        else if (dx == 0 && dy == 2 * direction && startY == initialRow) 
+        {
+            // La case cible ET la case intermédiaire doivent être vides
+            const Tile *midTile = &board->tiles[startY + direction][startX];
+            if (targetTile->layerCount == 1 && midTile->layerCount == 1) 
+            {
+                ruleMatch = true;
+            }
+        }
+    }
+
+    // Si la règle physique n'est pas respectée, c'est invalide
+    if (!ruleMatch) return false;
+
+    // VÉRIFICATION COLLISION ALLIÉE
+    // On ne peut pas manger ses propres pièces
+    if (targetTile->layerCount > 1) 
+    {
+        int targetID = targetTile->layers[targetTile->layerCount - 1];
+        int targetColor = GetPieceColor(targetID);
+        
+        if (targetColor != -1 && targetColor == currentTurnColor) 
+        {
+            // Exception : Pour le roque, l'arrivée est vide.
+            if (!((pieceID == 10 || pieceID == 11) && abs(dx) == 2))
+            {
+                return false; // Bloqué par un ami
+            }
+        }
+    }
+
+    return true; 
+}
+
+// LOGIQUE DE SÉCURITÉ (ECHEC / MAT)
+
+// Détecte si le Roi d'une couleur donnée est menacé ACTUELLEMENT
+bool IsKingInCheck(const Board *board, int kingColor)
+{
+    int kingX = -1;
+    int kingY = -1;
+    int targetKingID = (kingColor == 0) ? 10 : 11; // 10=Blanc, 11=Noir
+
+    // On cherche où est le Roi
+    for (int y = 0; y < BOARD_ROWS; y++) 
+    {
+        for (int x = 0; x < BOARD_COLS; x++) 
+        {
+            const Tile *t = &board->tiles[y][x];
+            if (t->layerCount > 1) 
+            {
+                if (t->layers[t->layerCount - 1] == targetKingID) 
+                {
+                    kingX = x; 
+                    kingY = y;
+                }
+            }
+        }
+    }
+    
+    if (kingX == -1 || kingY == -1) return false;
+
+    // On regarde si un ennemi peut attaquer cette case (kingX, kingY)
+    for (int y = 0; y < BOARD_ROWS; y++) 
+    {
+        for (int x = 0; x < BOARD_COLS; x++) 
+        {
+            const Tile *t = &board->tiles[y][x];
+            
+            if (t->layerCount <= 1) continue;
+
+            int attackerID = t->layers[t->layerCount - 1];
+            int attackerColor = GetPieceColor(attackerID);
+
+            if (attackerColor == -1 || attackerColor == kingColor) continue;
+            
+            // Si cet ennemi peut légalement aller sur la case du Roi
+            // (IsMoveValid ne modifie pas le plateau : pas besoin de copie)
+            if (IsMoveValid(board, x, y, kingX, kingY)) 
+            {
+                return true; // Le Roi est en échec !
+            }
+        }
+    }
+    return false;
+}
+
+static bool IsSquareAttacked(const Board *board, int x, int y, int color)
+{
+    for (int sy = 0; sy < BOARD_ROWS; sy++)
+    {
+        for (int sx = 0; sx < BOARD_COLS; sx++)
+        {
+            const Tile *t = &board->tiles[sy][sx];
+            if (t->layerCount <= 1) continue;
+
+            int pieceID = t->layers[t->layerCount - 1];
+            int pieceColor = GetPieceColor(pieceID);
+
+            if (pieceColor != 1 - color) continue;
+
+            int dx = x - sx;
+            int dy = y - sy;
+
+            // PIONS
+            if (pieceID == 6 || pieceID == 7)
+            {
+                int dir = (pieceColor == 0) ? -1 : 1;
+                if (abs(dx) == 1 && dy == dir)
+                    return true;
+            }
+
+            // CAVALIERS
+            else if (pieceID == 2 || pieceID == 3)
+            {
+                if ((abs(dx) == 1 && abs(dy) == 2) || (abs(dx) == 2 && abs(dy) == 1))
+                    return true;
+            }
+
+            // ROI (attaque 1 case SEULEMENT, PAS DE ROQUE)
+            else if (pieceID == 10 || pieceID == 11)
+            {
+                if (abs(dx) <= 1 && abs(dy) <= 1)
+                    return true;
+            }
+
+            // FOU
+            else if (pieceID == 4 || pieceID == 5)
+            {
+                if (abs(dx) == abs(dy) && IsPathClear(board, sx, sy, x, y))
+                    return true;
+            }
+
+            // TOUR
+            else if (pieceID == 12 || pieceID == 13)
+            {
+                if ((dx == 0 || dy == 0) && IsPathClear(board, sx, sy, x, y))
+                    return true;
+            }
+
+            // REINE
+            else if (pieceID == 8 || pieceID == 9)
+            {
+                if (((dx == 0 || dy == 0) || abs(dx) == abs(dy)) &&
+                    IsPathClear(board, sx, sy, x, y))
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
+// ACCUMULATEUR NNUE
+
+// Force le recalcul complet de l'accumulateur NNUE (nouvelle partie, promotion...)
+static void NNUEInvalidate(Board *board)
+{
+    board->nnue.computed[0] = false;
+    board->nnue.computed[1] = false;
+}
+
+// Répercute un coup sur l'accumulateur NNUE (undo = true depuis UnmakeMove)
+static void NNUEUpdate(Board *board, Move move, int pieceID, bool undo)
+{
+    if (!NNUE_IsLoaded()) return;
+
+    NNUEFeature removed[3];
+    NNUEFeature added[3];
+    int removedCount = 0;
+    int addedCount = 0;
+
+    removed[removedCount++] = (NNUEFeature){ pieceID, move.startY * 8 + move.startX };
+    added[addedCount++] = (NNUEFeature){ pieceID, move.endY * 8 + move.endX };
+
+    if (move.capturedPieceID != 0)
+    {
+        // En passant : le pion mangé est à côté de la case de départ
+        int capturedY = move.isEnPassant ? move.startY : move.endY;
+        removed[removedCount++] = (NNUEFeature){ move.capturedPieceID, capturedY * 8 + move.endX };
+    }
+
+    if (pieceID == 10 || pieceID == 11)
+    {
+        // Le roi fait partie de l'indexation (HalfKP) : sa perspective doit être recalculée
+        board->nnue.computed[GetPieceColor(pieceID)] = false;
+
+        if (abs(move.endX - move.startX) == 2)
+        {
+            int rookID = (pieceID == 10) ? 12 : 13;
+            int rookX_start = (move.endX > move.startX) ? move.startX + 3 : move.startX - 4;
+            int rookX_end = (move.endX > move.startX) ? move.startX + 1 : move.startX - 1;
+            removed[removedCount++] = (NNUEFeature){ rookID, move.startY * 8 + rookX_start };
+            added[addedCount++] = (NNUEFeature){ rookID, move.startY * 8 + rookX_end };
+        }
+    }
+
+    if (undo)
+    {
+        NNUE_ApplyChanges(&board->nnue, added, addedCount, removed, removedCount);
+    }
+    else
+    {
+        NNUE_ApplyChanges(&board->nnue, removed, removedCount, added, addedCount);
+    }
+}
+
+// Effectue le coup (déplace la pièce, gère la capture, le roque).
+// simulation = true pour la recherche : ni pièces mangées, ni roque, ni version ne sont touchés
+static void MakeMove(Board *board, Move move, bool simulation)
+{
+    Tile *startTile = &board->tiles[move.startY][move.startX]; 
+    Tile *endTile = &board->tiles[move.endY][move.endX]; 
+    
+    // Sauvegarder la pièce capturée (si elle n'est pas déjà dans 'move.capturedPieceID')
+    // Pour l'IA, on suppose que 'capturedPieceID' est déjà pré-rempli par GenerateLegalMoves.
+    if (!move.isEnPassant && move.capturedPieceID == 0 && endTile->layerCount > 1) 
+    {
+        move.capturedPieceID = TilePop(endTile); // Retire la pièce mangée et stocke son ID
+    } 
+    else if (move.capturedPieceID != 0 && !move.isEnPassant)
+    {
+         TilePop(endTile); // Retire la pièce mangée (elle est déjà stockée)
+    }
+
+    // --- LOGIQUE PRISE EN PASSANT (EXECUTION) ---
+    if (move.isEnPassant)
+    {
+        // La pièce mangée n'est pas sur endY, mais sur startY (à côté du départ)
+        Tile *capturedPawnTile = &board->tiles[move.startY][move.endX];
+        TilePop(capturedPawnTile); // On supprime le pion adverse
+    }
+    // --------------------------------------------
+
+    if (move.capturedPieceID != 0) board->pieceCount--;
+
+    NNUEUpdate(board, move, startTile->layers[startTile->layerCount - 1], false);
+
+    // --- NOUVEAU : ENREGISTREMENT DES PIÈCES MANGÉES ---
+    // On ne le fait que si ce n'est PAS une simulation (donc un vrai coup de joueur ou de l'IA validé)
+    if (!simulation && move.capturedPieceID != 0)
+    {
+        // Qui a mangé ? C'est celui qui bouge.
+        int capturerColor = GetPieceColor(move.movingPieceID);
+        
+        if (capturerColor == 0) // C'est Blanc qui a mangé
+        {
+            if (board->capturedByWhiteCount < 16)
+            {
+                board->capturedByWhite[board->capturedByWhiteCount] = move.capturedPieceID;
+                board->capturedByWhiteCount++;
+            }
+        }
+        else // C'est Noir qui a mangé
+        {
+            if (board->capturedByBlackCount < 16)
+            {
+                board->capturedByBlack[board->capturedByBlackCount] = move.capturedPieceID;
+                board->capturedByBlackCount++;
+            }
+        }
+    }
+    // ----------------------------------------------------
+    
+    // Le sol reste (sauf s'il y a un bug). TilePop gère cela.
+    int pieceID = TilePop(startTile); // Retire la pièce de départ
+    TilePush (endTile, pieceID); // Place la pièce sur la nouvelle case
+
+    // Marquer le déplacement du roi
+    if (!simulation)
+    {
+        board->version++;
+
+        if (pieceID == 10 || pieceID == 11)
+        {
+            board->kingMoved[GetPieceColor(pieceID)] = true;
+        }
+
+        if (pieceID == 12 || pieceID == 13)
+        {
+            int color = GetPieceColor(pieceID);
+            if (move.startX == 0) board->rookMoved[color][0] = true;
+            if (move.startX == 7) board->rookMoved[color][1] = true;
+        }
+    }
+
+    // Logique du roque si c'est un coup de roque
+    if ((pieceID == 10 || pieceID == 11) && abs(move.endX - move.startX) == 2)
+    {
+        int rookX_start = (move.endX > move.startX) ? move.startX + 3 : move.startX - 4;
+        int rookX_end = (move.endX > move.startX) ? move.startX + 1 : move.startX - 1;
+
+        Tile *rookStartTile = &board->tiles[move.startY][rookX_start];
+        Tile *rookEndTile = &board->tiles[move.endY][rookX_end];
+        
+        int rookID = TilePop(rookStartTile);
+        TilePush(rookEndTile, rookID);
+    }
+
+    // --- MISE A JOUR ETAT EN PASSANT (POUR LE PROCHAIN TOUR) ---
+    // 1. On efface l'ancienne possibilité (elle ne dure qu'un tour)
+    board->enPassantX = -1;
+    board->enPassantY = -1;
+
+    // 2. Si c'est un PION qui avance de 2 CASES, on crée une nouvelle cible
+    if ((pieceID == 6 || pieceID == 7) && abs(move.endY - move.startY) == 2)
+    {
+        board->enPassantX = move.startX;
+        // La cible est la case sautée (moyenne des Y)
+        board->enPassantY = (move.startY + move.endY) / 2;
+    }
+    // -----------------------------------------------------------
+}
+
+// Annule le coup (replace la pièce, replace la pièce capturée, annule le roque)
+static void UnmakeMove(Board *board, Move move)
+{
+    Tile *startTile = &board->tiles[move.startY][move.startX]; // Case départ originale
+    Tile *endTile = &board->tiles[move.endY][move.endX]; // Case arrivée origniale
+
+    // Déplacer la pièce qui a bougé
+    int pieceID = TilePop(endTile); // Supprime la pièce tout en la stockant
+    TilePush(startTile, pieceID); // Replace la pièce à son ancienne position
+
+    NNUEUpdate(board, move, pieceID, true);
+
+    // --- RESTAURATION PRISE EN PASSANT ---
+    if (move.isEnPassant)
+    {
+        // On remet le pion mangé sur sa case d'origine (à côté de start)
+        Tile *capturedPawnTile = &board->tiles[move.startY][move.endX];
+        TilePush(capturedPawnTile, move.capturedPieceID);
+    }
+    else if (move.capturedPieceID != 0)
+    {
+        // Capture classique
+        TilePush(endTile, move.capturedPieceID); 
+    }
+    if (move.capturedPieceID != 0) board->pieceCount++;
+    
+    // Restauration des variables globales du board
+    board->enPassantX = move.prevEnPassantX;
+    board->enPassantY = move.prevEnPassantY;
+    // --------------------------------------
+    
+    // Annuler le roque si c'était un coup de roque
+    if ((pieceID == 10 || pieceID == 11) && abs(move.endX - move.startX) == 2)
+    {
+        int rookX_start = (move.endX > move.startX) ? move.startX + 3 : move.startX - 4;
+        int rookX_end = (move.endX > move.startX) ? move.startX + 1 : move.startX - 1;
+
+        Tile *rookStartTile = &board->tiles[move.startY][rookX_start];
+        Tile *rookEndTile = &board->tiles[move.endY][rookX_end];
+        
+        int rookID = TilePop(rookEndTile);
+        TilePush(rookStartTile, rookID);
+    }
+}
+
+// Génère tous les coups LÉGAUX (qui ne mettent pas le roi en échec) pour le joueur donné
+int GenerateLegalMoves(Board *board, Move movelist[], int playerColor)
+{
+    int count = 0;
+
+    for (int startY = 0; startY < BOARD_ROWS; startY++)
+    {
+        for (int startX = 0; startX < BOARD_COLS; startX++)
+        {
+            Tile *startTile = &board->tiles[startY][startX];
+            
+            // Vérifier que c'est une pièce du joueur actuel
+            if (startTile->layerCount <= 1) continue; 
+            int pieceID = startTile->layers[startTile->layerCount - 1];
+            if (GetPieceColor(pieceID) != playerColor) continue;
+
+            // Générer tous les mouvements possibles selon les règles physiques
+            for (int endY = 0; endY < BOARD_ROWS; endY++)
+            {
+                for (int endX = 0; endX < BOARD_COLS; endX++)
+                {
+                    if (IsMoveValid(board, startX, startY, endX, endY))
+                    {
+                        // Créer le coup de base
+                        Move m = {startX, startY, endX, endY, pieceID, 0, false, 0, 0}; 
+
+                        // Sauvegarde de l'état actuel du En Passant
+                        m.prevEnPassantX = board->enPassantX;
+                        m.prevEnPassantY = board->enPassantY;
+
+                        // Vérification si c'est une Prise en Passant
+                        Tile *endTile = &board->tiles[endY][endX];
+                        
+                        // Si c'est un pion, qui va en diagonale, sur une case vide
+                        if ((pieceID == 6 || pieceID == 7) && abs(endX - startX) == 1 && endTile->layerCount <= 1)
+                        {
+                            // C'est un En Passant valide (validé par IsMoveValid)
+                            m.isEnPassant = true;
+                            // La pièce mangée est sur la case [startY][endX]
+                            Tile *capturedTile = &board->tiles[startY][endX];
+                            if (capturedTile->layerCount > 1)
+                            {
+                                m.capturedPieceID = capturedTile->layers[capturedTile->layerCount - 1];
+                            }
+                        }
+                        else
+                        {
+                            // Capture classique ou déplacement normal
+                            if (endTile->layerCount > 1)
+                            {
+                                m.capturedPieceID = endTile->layers[endTile->layerCount - 1];
+                            }
+                        }
+                        
+                        // On simule le coup
+                        MakeMove(board, m, true); 
+                        
+                        // Si le roi n'est PAS en échec après le coup, c'est un coup légal
+                        if (!IsKingInCheck(board, playerColor))
+                        {
+                            if (count < MAX_MOVES)
+                            {
+                                movelist[count++] = m;
+                            }
+                        }
+                        
+                        // Annuler le coup pour revenir à la position de départ
+                        UnmakeMove(board, m); 
+                    }
+                }
+            }
+        }
+    }
+    return count;
+}
+
+// Joue un coup de simulation (aucun effet sur les captures affichées ni sur le roque)
+void SimulateMove(Board *board, Move move)
+{
+    MakeMove(board, move, true);
+}
+
+void UndoSimulatedMove(Board *board, Move move)
+{
+    UnmakeMove(board, move);
+}
+
+// Joue un coup réel (suivi du roque, pièces mangées) puis la promotion éventuelle
+void ApplyMove(Board *board, Move move, int promotionPieceID)
+{
+    MakeMove(board, move, false);
+    board->lastMove = move;
+
+    Tile *endTile = &board->tiles[move.endY][move.endX];
+    int pieceID = endTile->layers[endTile->layerCount - 1];
+    if (promotionPieceID != PROMOTION_DEFERRED && ((pieceID == 6 && move.endY == 0) || (pieceID == 7 && move.endY == 7)))
+    {
+        PromotePawn(board, move.endX, move.endY, (promotionPieceID != 0) ? promotionPieceID : pieceID + 2); // Dame par défaut
+    }
+}
+
+// Remplace le pion arrivé en (x, y) par la pièce choisie
+void PromotePawn(Board *board, int x, int y, int pieceID)
+{
+    Tile *tile = &board->tiles[y][x];
+    TilePop(tile); // Enlève le pion
+    TilePush(tile, pieceID); // Met la nouvelle pièce
+    NNUEInvalidate(board);
+    board->version++;
+}
+
+// Clé Zobrist : pièces, trait, droits de roque et colonne en passant
+uint64_t PositionKey(const Board *board, int sideToMove)
+{
+    uint64_t key = 0;
+    for (int y = 0; y < BOARD_ROWS; y++)
+    {
+        for (int x = 0; x < BOARD_COLS; x++)
+        {
+            const Tile *t = &board->tiles[y][x];
+            if (t->layerCount > 1) key ^= gZobristPiece[t->layers[t->layerCount - 1]][y * 8 + x];
+        }
+    }
+
+    if (!board->kingMoved[0] && !board->rookMoved[0][1]) key ^= gZobristCastling[0];
+    if (!board->kingMoved[0] && !board->rookMoved[0][0]) key ^= gZobristCastling[1];
+    if (!board->kingMoved[1] && !board->rookMoved[1][1]) key ^= gZobristCastling[2];
+    if (!board->kingMoved[1] && !board->rookMoved[1][0]) key ^= gZobristCastling[3];
+
+    if (board->enPassantX != -1) key ^= gZobristEnPassant[board->enPassantX];
+    if (sideToMove == 1) key ^= gZobristSide;
+    return key;
+}
+
+
+// INITIALISATION
+
+// Position initiale : pièces, droits de roque, en passant et captures remis à zéro
+void BoardReset(Board *board)
+{
+    // On parcourt tout le plateau pour placer les pièces
+    for (int y = 0; y < BOARD_ROWS; y++) 
+    {
+        for (int x = 0; x < BOARD_COLS; x++) 
+        {
+            Tile *t = &board->tiles[y][x];
+            TileClear(t); // On nettoie la case
+            
+            // Ajout du sol (Carreaux)
+            int groundIndex = (x + y) % 2;
+            TilePush(t, groundIndex);
+
+            // PLACEMENT DES PIECES 
+            
+            // Pions Noirs (Ligne 1)
+            if (y == 1) TilePush(t, 7); 
+            
+            // Pions Blancs (Ligne 6)
+            if (y == 6) TilePush(t, 6); 
+
+            // Pièces Nobles Noires (Ligne 0)
+            if (y == 0) 
+            { 
+                if (x == 0 || x == 7) TilePush(t, 13); // Tour (13)
+                if (x == 1 || x == 6) TilePush(t, 3);  // Cavalier (3)
+                if (x == 2 || x == 5) TilePush(t, 5);  // Fou (5)
+                if (x == 3) TilePush(t, 9);            // Reine (9)
+                if (x == 4) TilePush(t, 11);           // Roi (11)
+            }
+            
+            // Pièces Nobles Blanches (Ligne 7)
+            if (y == 7) 
+            { 
+                if (x == 0 || x == 7) TilePush(t, 12); // Tour (12)
+                if (x == 1 || x == 6) TilePush(t, 2);  // Cavalier (2)
+                if (x == 2 || x == 5) TilePush(t, 4);  // Fou (4)
+                if (x == 3) TilePush(t, 8);            // Reine (8)
+                if (x == 4) TilePush(t, 10);           // Roi (10)
+            }
+        }
+    }
+
+    board->sideToMove = 0;
+    board->lastMove.startX = -1;
+    board->lastMove.startY = -1;
+    board->lastMove.endX = -1;
+    board->lastMove.endY = -1;
+    board->lastMove.movingPieceID = -1;
+    board->lastMove.capturedPieceID = 0;
+
+    // Pièces capturées et prise en passant
+    board->capturedByWhiteCount = 0;
+    board->capturedByBlackCount = 0;
+    board->enPassantX = -1;
+    board->enPassantY = -1;
+
+    board->kingMoved[0] = board->kingMoved[1] = false;
+    board->rookMoved[0][0] = board->rookMoved[0][1] = false;
+    board->rookMoved[1][0] = board->rookMoved[1][1] = false;
+    board->pieceCount = 32;
+
+    NNUEInvalidate(board);
+    board->version++;
+}
+
+// POSITIONS FEN
+
+// Charge une position FEN (pièces, trait, roques, en passant). Le reste de la partie est réinitialisé.
+bool BoardFromFEN(Board *board, const char *fen, int *sideToMove)
+{
+    BoardReset(board);
+
+    // On vide le plateau en gardant le sol
+    for (int y = 0; y < BOARD_ROWS; y++)
+    {
+        for (int x = 0; x < BOARD_COLS; x++)
+        {
+            Tile *t = &board->tiles[y][x];
+            TileClear(t);
+            TilePush(t, (x + y) % 2);
+        }
+    }
+
+    // 1. Pièces (de la rangée 8 vers la rangée 1, donc y = 0 d'abord)
+    const char *p = fen;
+    int x = 0;
+    int y = 0;
+    int pieceCount = 0;
+    int kingCount[2] = { 0, 0 };
+    while (*p != '\0' && *p != ' ')
+    {
+        char c = *p++;
+        if (c == '/')
+        {
+            if (x != BOARD_COLS) return false;
+            x = 0;
+            y++;
+            continue;
+        }
+        if (c >= '1' && c <= '8')
+        {
+            x += c - '0';
+            continue;
+        }
+
+        int pieceID = 0;
+        switch (c)
+        {
+            case 'P': pieceID = 6; break;   case 'p': pieceID = 7; break;
+            case 'N': pieceID = 2; break;   case 'n': pieceID = 3; break;
+            case 'B': pieceID = 4; break;   case 'b': pieceID = 5; break;
+            case 'R': pieceID = 12; break;  case 'r': pieceID = 13; break;
+            case 'Q': pieceID = 8; break;   case 'q': pieceID = 9; break;
+            case 'K': pieceID = 10; break;  case 'k': pieceID = 11; break;
+            default: return false;
+        }
+        if (x >= BOARD_COLS || y >= BOARD_ROWS) return false;
+        TilePush(&board->tiles[y][x], pieceID);
+        pieceCount++;
+        if (pieceID == 10 || pieceID == 11) kingCount[pieceID - 10]++;
+        x++;
+    }
+    if (y != BOARD_ROWS - 1 || x != BOARD_COLS) return false;
+    if (kingCount[0] != 1 || kingCount[1] != 1) return false; // Sans roi, ni échec ni mat n'ont de sens
+    board->pieceCount = pieceCount;
+
+    // 2. Trait
+    while (*p == ' ') p++;
+    int side = 0;
+    if (*p == 'b') side = 1;
+    else if (*p != 'w') return false;
+    p++;
+
+    // 3. Roques : sans droit pour une couleur, on considère que son roi a bougé
+    while (*p == ' ') p++;
+    board->kingMoved[0] = board->kingMoved[1] = true;
+    board->rookMoved[0][0] = board->rookMoved[0][1] = true;
+    board->rookMoved[1][0] = board->rookMoved[1][1] = true;
+    while (*p != '\0' && *p != ' ')
+    {
+        switch (*p)
+        {
+            case 'K': board->kingMoved[0] = false; board->rookMoved[0][1] = false; break;
+            case 'Q': board->kingMoved[0] = false; board->rookMoved[0][0] = false; break;
+            case 'k': board->kingMoved[1] = false; board->rookMoved[1][1] = false; break;
+            case 'q': board->kingMoved[1] = false; board->rookMoved[1][0] = false; break;
+            default: break; // '-'
+        }
+        p++;
+    }
+
+    // 4. Case en passant
+    while (*p == ' ') p++;
+    if (p[0] >= 'a' && p[0] <= 'h' && p[1] >= '1' && p[1] <= '8')
+    {
+        board->enPassantX = p[0] - 'a';
+        board->enPassantY = '8' - p[1];
+    }
+
+    board->sideToMove = side;
+    board->version++;
+    if (sideToMove != NULL) *sideToMove = side;
+    return true;
+}
+
+// Notation coordonnées (colonne a-h, rangée 1-8 ; y = 0 correspond à la rangée 8)
+void MoveToString(Move move, char out[6])
+{
+    if (move.startX < 0)
+    {
+        snprintf(out, 6, "0000"); // Aucun coup (notation UCI)
+        return;
+    }
+    out[0] = (char)('a' + move.startX);
+    out[1] = (char)('8' - move.startY);
+    out[2] = (char)('a' + move.endX);
+    out[3] = (char)('8' - move.endY);
+    out[4] = '\0';
+}
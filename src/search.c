@@ -0,0 +1,1237 @@
+#include "chesscore.h"
+#include "bitbase.h"
+#include "matesearch.h"
+#include "book.h"
+#include "zobrist.h"
+#include "tt.h"
+#include "learn.h"
+#include "profiler.h"
+#include "searchstats.h"
+#include "clock.h"
+#include "searchtrace.h"
+#include <pthread.h>
+#include <stdio.h> 
+#include <stdlib.h> 
+#include <string.h>
+
+// Ajout des fonctions min et max pour l'AlphaBeta
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#define max(a, b) ((a) > (b) ? (a) : (b))
+
+#define BITBASE_WIN_SCORE 10000 // Finale gagnée d'après les bitbases (sous les scores de mat)
+#define BITBASE_PROMOTION_BONUS 1000 // Pion promu dans une finale gagnée : au-dessus de tout progrès du roi
+#define BITBASE_PROMOTION_FLOOR (BITBASE_WIN_SCORE + BITBASE_PROMOTION_BONUS / 2) // Scores de promotion (dépendent du ply)
+#define AI_MATE_MIN_ADVANTAGE 300 // Avance matérielle à partir de laquelle l'IA cherche un mat
+#define AI_MATE_EXTRA_MOVES 2 // Le solveur de mat regarde plus loin que AlphaBeta (en coups de l'attaquant)
+#define AI_MATE_NODES 20000 // Au plus, et jamais plus que le budget de noeuds de la recherche
+#define SEARCH_MAX_THREADS 64
+#define SEARCH_POLL_MASK 1023 // Arrêt et échéance vérifiés tous les 1024 noeuds
+#define SEARCH_DEFAULT_MOVES_TO_GO 30 // Coups restants supposés quand la pendule ne le dit pas
+#define SEARCH_SPEED_FEN "r1bqk2r/pppp1ppp/2n2n2/2b1p3/2B1P3/3P1N2/PPP2PPP/RNBQK2R w KQkq - 1 5" // MeasureSearchSpeed
+#define SEARCH_THREAD_STACK (8 * 1024 * 1024) // ~10 Ko de liste de coups par ply (512 Ko par défaut sous macOS)
+
+// Statistiques de la recherche en cours et variante principale (table triangulaire par ply).
+// Propres à chaque thread : les threads auxiliaires (lazy SMP) ne partagent que la table de transposition.
+static _Thread_local SearchStats searchStats;
+static _Thread_local SearchIteration *currentIteration = NULL;
+static _Thread_local Move pvTable[SEARCH_MAX_PV + 1][SEARCH_MAX_PV + 1];
+static _Thread_local int pvLength[SEARCH_MAX_PV + 1];
+
+// Conditions d'arrêt de la recherche du thread
+static _Thread_local SearchControl *searchControl = NULL;
+static _Thread_local atomic_bool *helperStop = NULL; // Fin de la recherche principale (threads auxiliaires)
+static _Thread_local long nodeLimit = 0;
+static _Thread_local bool searchAborted = false;
+static _Thread_local bool helperThread = false;
+static _Thread_local bool materialEval = false;  // SearchLimits.materialEval
+static _Thread_local bool noBitbases = false;    // SearchLimits.noBitbases
+static _Thread_local int multiPV = 0;            // SearchLimits.multiPV (thread principal seulement)
+
+// Fonction d'évaluation simple
+static int EvalutatePosition(const Board *board)
+{
+    int PAWN_VAL = 100;
+    int KNIGHT_VAL = 320;
+    int BISHOP_VAL = 330;
+    int ROOK_VAL = 500;
+    int QUEEN_VAL = 900;
+    int score = 0;
+
+    // Calcul de la valeur matérielle
+    for (int y = 0; y < BOARD_ROWS; y++)
+    {
+        for (int x = 0; x < BOARD_COLS; x++)
+        {
+            const Tile *t = &board->tiles[y][x];
+            
+            if (t->layerCount > 1)
+            {
+                int pieceID = t->layers[t->layerCount - 1]; 
+                int pieceColor = GetPieceColor(pieceID); 
+
+                int value = 0;
+
+                // Identification de la pièce et assignation de la valeur
+                if (pieceID == 6 || pieceID == 7) value = PAWN_VAL;       
+                else if (pieceID == 2 || pieceID == 3) value = KNIGHT_VAL; 
+                else if (pieceID == 4 || pieceID == 5) value = BISHOP_VAL;  
+                else if (pieceID == 12 || pieceID == 13) value = ROOK_VAL;  
+                else if (pieceID == 8 || pieceID == 9) value = QUEEN_VAL;   
+
+                // Ajout ou soustraction au score total
+                if (pieceColor == 0) // Blanc (maximise)
+                {
+                    score += value;
+                }
+                else // Noir (minimise)
+                {
+                    score -= value;
+                }
+
+                // Facteurs positionnels simples
+                if ((pieceID == 6 || pieceID == 7) && (x >= 3 && x <= 4)) // Pions centraux
+                {
+                    if (pieceColor == 0) score += 5; 
+                    else score -= 5;                 
+                }
+            }
+        }
+    }
+    return score;
+}
+
+// Copie les pièces du plateau dans un tableau de 64 cases (0 = vide)
+static void BoardToSquares(const Board *board, int squares[64])
+{
+    for (int y = 0; y < BOARD_ROWS; y++)
+    {
+        for (int x = 0; x < BOARD_COLS; x++)
+        {
+            const Tile *t = &board->tiles[y][x];
+            squares[y * 8 + x] = (t->layerCount > 1) ? t->layers[t->layerCount - 1] : 0;
+        }
+    }
+}
+
+// Évaluation utilisée par la recherche : réseau NNUE si chargé, sinon EvalutatePosition
+static int Evaluate(Board *board, int sideToMove)
+{
+    if (materialEval || !NNUE_IsLoaded()) return EvalutatePosition(board);
+
+    if (!board->nnue.computed[0] || !board->nnue.computed[1])
+    {
+        int squares[64];
+        BoardToSquares(board, squares);
+        NNUE_Refresh(&board->nnue, squares);
+
+        // Position sans roi (ne devrait pas arriver) : on garde l'évaluation matérielle
+        if (!board->nnue.computed[0] || !board->nnue.computed[1]) return EvalutatePosition(board);
+    }
+    return NNUE_Evaluate(&board->nnue, sideToMove);
+}
+
+// Pion arrivé sur sa dernière rangée : la recherche ne change pas la pièce (SimulateMove), il vaut une Dame
+static bool BitbasePromoted(const int squares[64])
+{
+    for (int x = 0; x < 8; x++)
+    {
+        if (squares[x] == 6 || squares[56 + x] == 7) return true;
+    }
+    return false;
+}
+
+// Score d'une finale gagnée d'après la bitbase : gros bonus + progrès vers le mat
+// (roi adverse repoussé au bord, rois rapprochés, pion avancé)
+static int BitbaseWinScore(const int squares[64], BitbaseResult result)
+{
+    int strongColor = (result == BITBASE_WHITE_WINS) ? 0 : 1;
+    int strongKing = -1;
+    int weakKing = -1;
+    int pawnY = -1;
+
+    for (int sq = 0; sq < 64; sq++)
+    {
+        int id = squares[sq];
+        if (id == 10 + strongColor) strongKing = sq;
+        else if (id == 11 - strongColor) weakKing = sq;
+        else if (id == 6 || id == 7) pawnY = sq / 8;
+    }
+
+    int wx = weakKing % 8, wy = weakKing / 8;
+    int centerDist = max(abs(2 * wx - 7), abs(2 * wy - 7)) / 2; // 0 (centre) à 3 (bord)
+    int kingDist = max(abs(wx - strongKing % 8), abs(wy - strongKing / 8));
+
+    int score = BITBASE_WIN_SCORE + 20 * centerDist + 5 * (7 - kingDist);
+    if (pawnY != -1)
+    {
+        score += 20 * ((strongColor == 0) ? 6 - pawnY : pawnY - 1);
+    }
+    return (strongColor == 0) ? score : -score;
+}
+
+static BitbaseResult ProbeBitbase(const Board *board, int sideToMove, int squares[64])
+{
+    if (noBitbases || board->pieceCount != 3) return BITBASE_NONE; // Avant de recopier le plateau : à chaque noeud
+    BoardToSquares(board, squares);
+    return Bitbase_Probe(squares, sideToMove);
+}
+
+const SearchStats *GetLastSearchStats(void)
+{
+    return &searchStats;
+}
+
+void SetLastSearchStats(const SearchStats *stats)
+{
+    searchStats = *stats;
+}
+
+// Arrêt demandé ou échéance dépassée ; jamais pendant la première itération (il faut un coup)
+static bool SearchShouldStop(void)
+{
+    if (searchAborted) return true;
+    if ((!helperThread && searchStats.iterationCount == 0) || (currentIteration->nodes & SEARCH_POLL_MASK) != 0) return false;
+
+    if (helperStop != NULL && atomic_load_explicit(helperStop, memory_order_relaxed)) searchAborted = true;
+    if (nodeLimit > 0 && searchStats.totalNodes + currentIteration->nodes >= nodeLimit) searchAborted = true;
+    if (searchControl != NULL)
+    {
+        uint64_t deadline = atomic_load_explicit(&searchControl->deadlineNs, memory_order_relaxed);
+        if (atomic_load_explicit(&searchControl->stop, memory_order_relaxed)) searchAborted = true;
+        else if (deadline != 0 && Clock_NowNs() >= deadline) searchAborted = true;
+    }
+    return searchAborted;
+}
+
+// Note le coup 'm' comme meilleur au ply donné, suivi de la variante du ply suivant
+static void UpdatePV(int ply, Move m)
+{
+    if (ply >= SEARCH_MAX_PV) return;
+    pvTable[ply][0] = m;
+    int childLength = (ply + 1 < SEARCH_MAX_PV) ? pvLength[ply + 1] : 0;
+    for (int i = 0; i < childLength && i + 1 < SEARCH_MAX_PV; i++) pvTable[ply][i + 1] = pvTable[ply + 1][i];
+    pvLength[ply] = (childLength + 1 < SEARCH_MAX_PV) ? childLength + 1 : SEARCH_MAX_PV;
+}
+
+// Les scores de promotion comptent les demi-coups depuis la racine : la table les garde comptés
+// depuis le noeud, sans quoi une transposition atteinte à un autre ply hériterait d'une distance fausse
+static int ScoreToTable(int score, int ply)
+{
+    if (score >= BITBASE_PROMOTION_FLOOR && score < INFINITY_SCORE) return score + ply;
+    if (score <= -BITBASE_PROMOTION_FLOOR && score > -INFINITY_SCORE) return score - ply;
+    return score;
+}
+
+static int ScoreFromTable(int score, int ply)
+{
+    if (score >= BITBASE_PROMOTION_FLOOR && score < INFINITY_SCORE) return score - ply;
+    if (score <= -BITBASE_PROMOTION_FLOOR && score > -INFINITY_SCORE) return score + ply;
+    return score;
+}
+
+// Début d'un noeud, commun à AlphaBeta et à la recherche par tranches : arrêt, bitbases, feuille,
+// table de transposition, mat ou pat. true si le noeud est résolu là (score dans *score) ;
+// sinon ses coups sont dans moves (coup de la table en tête) et sa clé dans *key.
+static bool NodeProbe(Board *b, int profondeur, int a, int beta, bool isMax, int playerTurn, int ply,
+                      uint64_t *key, Move moves[], int *count, int *score)
+{
+    currentIteration->nodes++;
+    if (ply < SEARCH_MAX_PV) pvLength[ply] = 0;
+    *score = 0;
+    if (SearchShouldStop()) return true; // Résultat ignoré : l'itération interrompue est abandonnée
+
+    // Finales connues : un nul est définitif, un gain sert de score aux feuilles
+    int squares[64];
+    BitbaseResult known = ProbeBitbase(b, playerTurn, squares);
+    if (known == BITBASE_DRAW)
+    {
+        TRACE_NODE(ply, TRACE_EXIT_BITBASE, -1, 0);
+        return true;
+    }
+
+    // Gain avec un pion promu : acquis dès ici, d'autant mieux noté que la promotion est proche
+    // (sans cela, promouvoir plus tard vaut autant que maintenant et l'IA peut repousser sans fin)
+    if (known != BITBASE_NONE && BitbasePromoted(squares))
+    {
+        currentIteration->leafNodes++;
+        TRACE_NODE(ply, TRACE_EXIT_BITBASE, -1, 0);
+        int bonus = BITBASE_WIN_SCORE + BITBASE_PROMOTION_BONUS - ply;
+        *score = (known == BITBASE_WHITE_WINS) ? bonus : -bonus;
+        return true;
+    }
+
+    if (profondeur == 0)
+    {
+        currentIteration->leafNodes++;
+        TRACE_NODE(ply, TRACE_EXIT_LEAF, -1, 0);
+        *score = (known != BITBASE_NONE) ? BitbaseWinScore(squares, known) : Evaluate(b, playerTurn);
+        return true;
+    }
+
+    // Table de transposition : position déjà vue à une profondeur suffisante
+    *key = PositionKey(b, playerTurn);
+    uint16_t ttMove = TT_MOVE_NONE;
+    TTEntry tte;
+    currentIteration->ttProbes++;
+    if (TT_Probe(*key, &tte))
+    {
+        currentIteration->ttHits++;
+        if (tte.depth >= profondeur)
+        {
+            int bound = TT_Bound(&tte);
+            int ttScore = ScoreFromTable(tte.score, ply);
+            if (bound == TT_EXACT
+                || (bound == TT_LOWER && ttScore >= beta)
+                || (bound == TT_UPPER && ttScore <= a))
+            {
+                currentIteration->ttCutoffs++;
+                TRACE_NODE(ply, TRACE_EXIT_TT, -1, 0);
+                *score = ttScore;
+                return true;
+            }
+        }
+        ttMove = tte.move;
+    }
+
+    *count = GenerateLegalMoves(b, moves, playerTurn);
+    if (*count == 0)
+    {
+        // Gérer échec et mat / pat
+        TRACE_NODE(ply, TRACE_EXIT_MATE, -1, 0);
+        if (IsKingInCheck(b, playerTurn))
+        {
+             *score = isMax ? -INFINITY : INFINITY; // Mat
+        }
+        return true; // Pat : 0
+    }
+
+    // Le meilleur coup connu de la table est essayé en premier
+    if (ttMove != TT_MOVE_NONE)
+    {
+        for (int i = 1; i < *count; i++)
+        {
+            Move m = moves[i];
+            if (TT_MOVE(m.startX, m.startY, m.endX, m.endY) == ttMove)
+            {
+                moves[i] = moves[0];
+                moves[0] = m;
+                break;
+            }
+        }
+    }
+    TRACE_NODE(ply, TRACE_EXIT_SEARCHED, -1, *count); // Remplacé en cas de coupure
+    return false;
+}
+
+// Fin d'un noeud parcouru : borne du score dans la table de transposition (et l'apprentissage)
+static void NodeStore(uint64_t key, int profondeur, int ply, int bestEval, int alphaOrig, int betaOrig, Move best)
+{
+    // Scores toujours vus des Blancs : la borne ne dépend pas du camp au trait
+    int bound = TT_EXACT;
+    if (bestEval <= alphaOrig) bound = TT_UPPER;
+    else if (bestEval >= betaOrig) bound = TT_LOWER;
+    uint16_t packed = TT_MOVE(best.startX, best.startY, best.endX, best.endY);
+    int stored = ScoreToTable(bestEval, ply);
+    TT_Store(key, profondeur, stored, bound, packed);
+    if (profondeur >= LEARN_MIN_DEPTH && !helperThread) Learn_Store(key, profondeur, stored, bound, packed, false);
+}
+
+#ifdef SEARCH_TRACE
+// Version tracée : AlphaBeta encadre chaque noeud d'un enregistrement d'entrée et de sortie
+static int AlphaBeta(Board *b, int profondeur, int a, int beta, bool isMax, int playerTurn, int ply);
+    #define ALPHABETA_NODE AlphaBetaNode
+#else
+    #define ALPHABETA_NODE AlphaBeta
+#endif
+
+static int ALPHABETA_NODE(Board *b, int profondeur, int a, int beta, bool isMax, int playerTurn, int ply)
+{
+    uint64_t key;
+    Move LocalMoveList[MAX_MOVES];
+    int count;
+    int score;
+    if (NodeProbe(b, profondeur, a, beta, isMax, playerTurn, ply, &key, LocalMoveList, &count, &score)) return score;
+
+    int alphaOrig = a;
+    int betaOrig = beta;
+    int bestEval;
+    Move best = LocalMoveList[0];
+
+    if (isMax) // Cherche le meilleur coup pour Blanc (maximise)
+    {
+        int maxEval = -INFINITY_SCORE;
+        for (int i = 0; i < count; i++) 
+        {
+            Move m = LocalMoveList[i];
+            SimulateMove(b, m); 
+            TRACE_MOVE(ply + 1, m);
+            int eval = AlphaBeta(b, profondeur - 1, a, beta, false, 1 - playerTurn, ply + 1); 
+            UndoSimulatedMove(b, m);
+            if (searchAborted) return 0;
+            if (eval > maxEval)
+            {
+                best = m;
+                UpdatePV(ply, m);
+            }
+            maxEval = max(maxEval, eval);
+            a = max(a, eval); 
+            if (beta <= a)
+            {
+                currentIteration->betaCutoffs++;
+                if (i == 0) currentIteration->firstMoveCutoffs++;
+                TRACE_NODE(ply, TRACE_EXIT_SEARCHED, i, i + 1);
+                break; 
+            }
+        }
+        bestEval = maxEval;
+    }
+    else // Cherche le meilleur coup pour Noir (minimise)
+    {
+        int minEval = INFINITY_SCORE;
+        for (int i = 0; i < count; i++)
+        {
+            Move m = LocalMoveList[i];
+            SimulateMove(b, m);
+            TRACE_MOVE(ply + 1, m);
+            int eval = AlphaBeta(b, profondeur - 1, a, beta, true, 1 - playerTurn, ply + 1);
+            UndoSimulatedMove(b, m);
+            if (searchAborted) return 0;
+            if (eval < minEval)
+            {
+                best = m;
+                UpdatePV(ply, m);
+            }
+            minEval = min(minEval, eval);
+            beta = min(beta, eval);
+            if (beta <= a)
+            {
+                currentIteration->betaCutoffs++;
+                if (i == 0) currentIteration->firstMoveCutoffs++;
+                TRACE_NODE(ply, TRACE_EXIT_SEARCHED, i, i + 1);
+                break;
+            }
+        }
+        bestEval = minEval;
+    }
+
+    NodeStore(key, profondeur, ply, bestEval, alphaOrig, betaOrig, best);
+    return bestEval;
+}
+
+#ifdef SEARCH_TRACE
+static int AlphaBeta(Board *b, int profondeur, int a, int beta, bool isMax, int playerTurn, int ply)
+{
+    SearchTrace_Enter(ply, profondeur, a, beta, playerTurn);
+    int score = AlphaBetaNode(b, profondeur, a, beta, isMax, playerTurn, ply);
+    SearchTrace_Exit(ply, profondeur, score);
+    return score;
+}
+#endif
+
+// Entre deux itérations : faut-il en commencer une autre ? (arrêt, échéance douce, limite de noeuds)
+static bool SearchCanDeepen(void)
+{
+    if (helperStop != NULL && atomic_load(helperStop)) return false;
+    if (nodeLimit > 0 && searchStats.totalNodes >= nodeLimit) return false;
+    if (searchControl != NULL)
+    {
+        uint64_t now = Clock_NowNs();
+        uint64_t soft = atomic_load(&searchControl->softDeadlineNs);
+        uint64_t hard = atomic_load(&searchControl->deadlineNs);
+        if (atomic_load(&searchControl->stop)) return false;
+        if ((soft != 0 && now >= soft) || (hard != 0 && now >= hard)) return false;
+    }
+    return true;
+}
+
+// Multi-PV : range le coup racine qui vient d'être cherché parmi les meilleurs (variante dans pvTable[1])
+static void InsertRootLine(SearchLine lines[], int *lineCount, int playerTurn, int eval, Move move)
+{
+    int limit = min(multiPV, SEARCH_MAX_LINES);
+    int pos = *lineCount;
+    while (pos > 0 && ((playerTurn == 0) ? eval > lines[pos - 1].score : eval < lines[pos - 1].score)) pos--;
+    if (pos >= limit) return;
+
+    int last = min(*lineCount, limit - 1);
+    memmove(&lines[pos + 1], &lines[pos], sizeof(SearchLine) * (size_t)(last - pos));
+    if (*lineCount < limit) (*lineCount)++;
+
+    SearchLine *line = &lines[pos];
+    line->score = eval;
+    line->pv[0] = move;
+    line->pvLength = 1;
+    for (int k = 0; k < pvLength[1] && line->pvLength < SEARCH_MAX_PV; k++) line->pv[line->pvLength++] = pvTable[1][k];
+}
+
+// Itération en cours à la racine, commune à l'approfondissement itératif et à la recherche par tranches
+typedef struct
+{
+    SearchIteration *it;
+    uint64_t start;
+    int score;
+    Move best;
+    Move pv[SEARCH_MAX_PV];
+    int pvLength;
+    SearchLine lines[SEARCH_MAX_LINES];
+    int lineCount;
+} RootIteration;
+
+static void RootIterationBegin(RootIteration *root, int depth, int playerTurn, Move firstMove)
+{
+    SearchIteration *it = &searchStats.iterations[searchStats.iterationCount];
+    memset(it, 0, sizeof(*it));
+    it->depth = depth;
+    currentIteration = it;
+    root->it = it;
+    root->start = Clock_NowNs();
+    TRACE_ITERATION_BEGIN(depth);
+
+    root->score = (playerTurn == 0) ? -INFINITY_SCORE : INFINITY_SCORE;
+    root->best = firstMove;
+    root->pvLength = 0;
+    root->lineCount = 0;
+}
+
+// Score exact d'un coup racine (sa variante est dans pvTable[1])
+static void RootIterationMove(RootIteration *root, int playerTurn, Move move, int eval)
+{
+    // Mise à jour du meilleur coup trouvé (Blanc maximise, Noir minimise)
+    bool better = (playerTurn == 0) ? (eval > root->score) : (eval < root->score);
+    if (better)
+    {
+        root->score = eval;
+        root->best = move;
+        root->pv[0] = move;
+        root->pvLength = 1;
+        for (int k = 0; k < pvLength[1] && root->pvLength < SEARCH_MAX_PV; k++) root->pv[root->pvLength++] = pvTable[1][k];
+    }
+    // Fenêtre complète à la racine : chaque coup a un score exact, le multi-PV ne coûte rien
+    if (multiPV > 1) InsertRootLine(root->lines, &root->lineCount, playerTurn, eval, move);
+}
+
+// Itération terminée : statistiques, meilleur coup en tête pour la suivante, rappel onIteration
+static void RootIterationEnd(RootIteration *root, Move legalMoves[], int count, const SearchLimits *limits)
+{
+    SearchIteration *it = root->it;
+    Move iterationBest = root->best;
+    for (int i = 1; i < count; i++)
+    {
+        if (legalMoves[i].startX == iterationBest.startX && legalMoves[i].startY == iterationBest.startY
+            && legalMoves[i].endX == iterationBest.endX && legalMoves[i].endY == iterationBest.endY)
+        {
+            legalMoves[i] = legalMoves[0];
+            legalMoves[0] = iterationBest;
+            break;
+        }
+    }
+
+    it->timeMs = (double)(Clock_NowNs() - root->start) * 1e-6;
+    it->nps = (it->timeMs > 0.0) ? it->nodes * 1000.0 / it->timeMs : 0.0;
+    if (searchStats.iterationCount > 0 && searchStats.iterations[searchStats.iterationCount - 1].nodes > 0)
+    {
+        it->branchingFactor = (double)it->nodes / searchStats.iterations[searchStats.iterationCount - 1].nodes;
+    }
+    it->score = root->score;
+    it->bestMove = iterationBest;
+    it->pvLength = root->pvLength;
+    memcpy(it->pv, root->pv, sizeof(Move) * (size_t)root->pvLength);
+    if (multiPV > 1)
+    {
+        memcpy(searchStats.lines, root->lines, sizeof(SearchLine) * (size_t)root->lineCount);
+        searchStats.lineCount = root->lineCount;
+    }
+    searchStats.iterationCount++;
+    searchStats.totalNodes += it->nodes;
+
+    if (limits->onIteration != NULL) limits->onIteration(limits->user);
+}
+
+// Approfondissement itératif : chaque itération trie la racine avec le meilleur coup précédent
+// et remplit la table de transposition pour la suivante. Une itération interrompue est abandonnée :
+// on rend le meilleur coup de la dernière itération terminée.
+static Move IterativeDeepening(Board *board, Move legalMoves[], int count, int firstDepth, int maxDepth,
+                               const SearchLimits *limits, int *bestScore)
+{
+    int playerTurn = board->sideToMove;
+    Move bestMove = legalMoves[0];
+    *bestScore = 0;
+
+    for (int d = firstDepth; d <= maxDepth; d++)
+    {
+        if (d > firstDepth && !SearchCanDeepen()) break;
+
+        RootIteration root;
+        RootIterationBegin(&root, d, playerTurn, legalMoves[0]);
+        for (int i = 0; i < count; i++)
+        {
+            Move move = legalMoves[i];
+            SimulateMove(board, move);
+            TRACE_MOVE(1, move);
+            // L'IA joue (Min) si elle est Noir (1), et Max si elle est Blanc (0)
+            // L'appel AlphaBeta va évaluer la position du point de vue de l'adversaire (1 - playerTurn)
+            int eval = AlphaBeta(board, d - 1, -INFINITY_SCORE, INFINITY_SCORE, (playerTurn == 0) ? false : true, 1 - playerTurn, 1);
+            UndoSimulatedMove(board, move);
+            if (searchAborted) break;
+            RootIterationMove(&root, playerTurn, move, eval);
+        }
+
+        if (searchAborted)
+        {
+            searchStats.totalNodes += root.it->nodes;
+            break;
+        }
+
+        RootIterationEnd(&root, legalMoves, count, limits);
+        bestMove = root.best;
+        *bestScore = root.score;
+    }
+    currentIteration = NULL;
+    return bestMove;
+}
+
+// Thread auxiliaire (lazy SMP) : même recherche sur sa propre copie du plateau, avec un ordre
+// des coups racine et une profondeur de départ différents. Son seul apport est la table de
+// transposition, que le thread principal relit ; son coup n'est pas utilisé.
+typedef struct
+{
+    Board board;
+    Move moves[MAX_MOVES];
+    int count;
+    int index;
+    int maxDepth;
+    SearchControl *control;
+    atomic_bool *stop;
+    TTable *table;
+    bool materialEval;
+    bool noBitbases;
+    long nodes;
+} SearchHelper;
+
+static void *SearchHelperMain(void *arg)
+{
+    SearchHelper *h = arg;
+    memset(&searchStats, 0, sizeof(searchStats));
+    searchControl = h->control;
+    helperStop = h->stop;
+    nodeLimit = 0;
+    searchAborted = false;
+    helperThread = true;
+    materialEval = h->materialEval;
+    noBitbases = h->noBitbases;
+    TT_Bind(h->table); // Même table que le thread principal
+
+    // Rotation des coups racine : chaque thread commence par une branche différente
+    Move rotated[MAX_MOVES];
+    for (int i = 0; i < h->count; i++) rotated[i] = h->moves[(i + h->index) % h->count];
+
+    SearchLimits none = { 0 };
+    int score;
+    IterativeDeepening(&h->board, rotated, h->count, 1 + (h->index & 1), h->maxDepth, &none, &score);
+    h->nodes = searchStats.totalNodes;
+    return NULL;
+}
+
+// Racine d'une recherche AlphaBeta, commune à SearchPosition et à la recherche par tranches
+typedef struct
+{
+    Move moves[MAX_MOVES];
+    int count;
+    int maxDepth;
+    int playerTurn;
+    uint64_t key;
+    BitbaseResult result;
+    uint64_t start;
+} SearchRoot;
+
+// Coups racine (filtrés par les bitbases), réponse apprise, état de la recherche du thread.
+// false si AlphaBeta est inutile (aucun coup légal, position apprise) : *bestMove est le résultat.
+static bool SearchBegin(Board *board, const SearchLimits *limits, SearchRoot *root, Move *bestMove)
+{
+    int playerTurn = board->sideToMove;
+    Move *legalMoves = root->moves;
+    int count = GenerateLegalMoves(board, legalMoves, playerTurn);
+    int maxDepth = (limits->depth > 0 && limits->depth < SEARCH_MAX_DEPTH) ? limits->depth : SEARCH_MAX_DEPTH;
+    materialEval = limits->materialEval;
+    noBitbases = limits->noBitbases;
+    multiPV = limits->multiPV;
+
+    memset(&searchStats, 0, sizeof(searchStats));
+    searchStats.source = SEARCH_SOURCE_SEARCH;
+    searchStats.side = playerTurn;
+    searchStats.requestedDepth = limits->depth;
+
+    if (count == 0) 
+    {
+        // Correction de l'avertissement : on initialise tous les champs
+        *bestMove = (Move){-1, -1, -1, -1, 0, 0, false, -1, -1};
+        return false;
+    }
+
+    // Finale dans les bitbases : on ne garde que les coups qui conservent le résultat théorique
+    int squares[64];
+    BitbaseResult rootResult = ProbeBitbase(board, playerTurn, squares);
+    if (rootResult != BITBASE_NONE)
+    {
+        int kept = 0;
+        for (int i = 0; i < count; i++)
+        {
+            SimulateMove(board, legalMoves[i]);
+            BitbaseResult childResult = ProbeBitbase(board, 1 - playerTurn, squares);
+            UndoSimulatedMove(board, legalMoves[i]);
+
+            if (childResult == rootResult) legalMoves[kept++] = legalMoves[i];
+        }
+        // Position perdue : tous les coups se valent, on les garde tous
+        if (kept > 0) count = kept;
+    }
+
+    // Position déjà analysée au moins aussi profondément (cette partie ou une précédente)
+    uint64_t key = PositionKey(board, playerTurn);
+    LearnEntry learned;
+    if (rootResult == BITBASE_NONE && Learn_Probe(key, &learned) && (learned.flags & LEARN_FLAG_ROOT)
+        && learned.depth >= maxDepth && learned.bound == TT_EXACT)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            Move m = legalMoves[i];
+            if (TT_MOVE(m.startX, m.startY, m.endX, m.endY) == learned.move)
+            {
+                searchStats.source = SEARCH_SOURCE_LEARN;
+                searchStats.bestMove = m;
+                searchStats.score = learned.score;
+                *bestMove = m;
+                return false;
+            }
+        }
+    }
+
+    root->count = count;
+    root->maxDepth = maxDepth;
+    root->playerTurn = playerTurn;
+    root->key = key;
+    root->result = rootResult;
+
+    TT_NewSearch();
+    TRACE_BEGIN(maxDepth, playerTurn);
+    root->start = Clock_NowNs();
+    searchControl = limits->control;
+    helperStop = NULL;
+    nodeLimit = limits->nodes;
+    searchAborted = false;
+    helperThread = false;
+    return true;
+}
+
+// Fin de la recherche : statistiques, score exact de la racine dans la table et l'apprentissage
+static void SearchEnd(const SearchRoot *root, Move bestMove, int bestScore)
+{
+    searchControl = NULL;
+    searchStats.totalMs = (double)(Clock_NowNs() - root->start) * 1e-6;
+    searchStats.bestMove = bestMove;
+    searchStats.score = bestScore;
+
+    // Fenêtre complète à la racine : le score est exact à la profondeur de la dernière itération finie
+    int completedDepth = searchStats.iterations[searchStats.iterationCount - 1].depth;
+    uint16_t packed = TT_MOVE(bestMove.startX, bestMove.startY, bestMove.endX, bestMove.endY);
+    TT_Store(root->key, completedDepth, bestScore, TT_EXACT, packed);
+    if (root->result == BITBASE_NONE) Learn_Store(root->key, completedDepth, bestScore, TT_EXACT, packed, true);
+}
+
+Move SearchPosition(Board *board, const SearchLimits *limits)
+{
+    SearchRoot root;
+    Move bestMove;
+    if (!SearchBegin(board, limits, &root, &bestMove)) return bestMove;
+
+    // Threads auxiliaires (la trace de recherche n'enregistre qu'un seul thread)
+    int threads = (limits->threads > 1) ? limits->threads : 1;
+    if (threads > SEARCH_MAX_THREADS) threads = SEARCH_MAX_THREADS;
+#ifdef SEARCH_TRACE
+    threads = 1;
+#endif
+    atomic_bool stopHelpers;
+    atomic_init(&stopHelpers, false);
+    SearchHelper *helpers = (threads > 1) ? malloc(sizeof(SearchHelper) * (size_t)(threads - 1)) : NULL;
+    pthread_t helperThreads[SEARCH_MAX_THREADS];
+    int helperCount = 0;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, SEARCH_THREAD_STACK);
+    for (int i = 0; helpers != NULL && i < threads - 1; i++)
+    {
+        SearchHelper *h = &helpers[i];
+        h->board = *board;
+        memcpy(h->moves, root.moves, sizeof(Move) * (size_t)root.count);
+        h->count = root.count;
+        h->index = i + 1;
+        h->maxDepth = root.maxDepth;
+        h->control = limits->control;
+        h->stop = &stopHelpers;
+        h->table = TT_Current();
+        h->materialEval = limits->materialEval;
+        h->noBitbases = limits->noBitbases;
+        h->nodes = 0;
+        if (pthread_create(&helperThreads[i], &attr, SearchHelperMain, h) != 0) break;
+        helperCount++;
+    }
+    pthread_attr_destroy(&attr);
+
+    int bestScore;
+    bestMove = IterativeDeepening(board, root.moves, root.count, 1, root.maxDepth, limits, &bestScore);
+
+    atomic_store(&stopHelpers, true);
+    for (int i = 0; i < helperCount; i++)
+    {
+        pthread_join(helperThreads[i], NULL);
+        searchStats.totalNodes += helpers[i].nodes;
+    }
+    free(helpers);
+
+    SearchEnd(&root, bestMove, bestScore);
+    return bestMove;
+}
+
+Move FindBestMove(Board *board, int depth)
+{
+    SearchLimits limits = { 0 };
+    limits.depth = depth;
+    limits.threads = 1;
+    return SearchPosition(board, &limits);
+}
+
+void SearchControl_Reset(SearchControl *control)
+{
+    atomic_store(&control->stop, false);
+    atomic_store(&control->deadlineNs, 0);
+    atomic_store(&control->softDeadlineNs, 0);
+}
+
+void SearchControl_SetTime(SearchControl *control, double softMs, double hardMs)
+{
+    uint64_t now = Clock_NowNs();
+    atomic_store(&control->softDeadlineNs, (softMs > 0.0) ? now + (uint64_t)(softMs * 1e6) : 0);
+    atomic_store(&control->deadlineNs, (hardMs > 0.0) ? now + (uint64_t)(hardMs * 1e6) : 0);
+}
+
+void SearchControl_Stop(SearchControl *control)
+{
+    atomic_store(&control->stop, true);
+}
+
+void AllocateMoveTime(double clockMs, double incMs, int movesToGo, double overheadMs, double *softMs, double *hardMs)
+{
+    // Part égale des coups restants plus l'essentiel de l'incrément ; une itération coûte plus que
+    // toutes les précédentes réunies, d'où l'arrêt à mi-budget. Jamais plus de la moitié de la pendule.
+    if (movesToGo <= 0) movesToGo = SEARCH_DEFAULT_MOVES_TO_GO;
+    double budget = clockMs / movesToGo + incMs * 0.75;
+    double ceiling = clockMs * 0.5 - overheadMs;
+    *hardMs = (budget * 3.0 < ceiling) ? budget * 3.0 : ceiling;
+    if (*hardMs < 1.0) *hardMs = 1.0;
+    *softMs = (budget * 0.5 < *hardMs) ? budget * 0.5 : *hardMs;
+}
+
+// Livre d'ouverture : tirage pondéré parmi les coups connus de la position
+static bool ProbeOpeningBook(Board *board, int side, Move *bookMove)
+{
+    if (!Book_IsOpen()) return false;
+
+    BookEntry entries[32];
+    int count = Book_Probe(PositionKey(board, side), entries, 32);
+    if (count == 0) return false;
+
+    long total = 0;
+    for (int i = 0; i < count; i++) total += entries[i].weight;
+    if (total == 0) return false;
+
+    long pick = rand() % total;
+    int chosen = 0;
+    while (pick >= entries[chosen].weight)
+    {
+        pick -= entries[chosen].weight;
+        chosen++;
+    }
+
+    // On retrouve le coup complet parmi les coups légaux (le livre peut être périmé)
+    uint16_t m = entries[chosen].move;
+    Move legalMoves[MAX_MOVES];
+    int legalCount = GenerateLegalMoves(board, legalMoves, side);
+    for (int i = 0; i < legalCount; i++)
+    {
+        const Move *lm = &legalMoves[i];
+        if (lm->startX == BOOK_MOVE_FROM_X(m) && lm->startY == BOOK_MOVE_FROM_Y(m)
+            && lm->endX == BOOK_MOVE_TO_X(m) && lm->endY == BOOK_MOVE_TO_Y(m))
+        {
+            *bookMove = *lm;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Livre d'ouverture, puis mat forcé en position décisive : true si le coup est trouvé sans
+// AlphaBeta (statistiques remplies, sauf la durée). 'depth' est en demi-coups, la distance du
+// solveur en coups de l'attaquant.
+static bool ChooseWithoutSearch(Board *board, const SearchLimits *limits, int depth, Move *bestMove)
+{
+    int side = board->sideToMove;
+    MateResult mate;
+    int advantage = (side == 0) ? EvalutatePosition(board) : -EvalutatePosition(board);
+    PROF_BEGIN(ProbeOpeningBook);
+    bool fromBook = ProbeOpeningBook(board, side, bestMove);
+    PROF_END(ProbeOpeningBook);
+
+    bool mateFound = false;
+    if (!fromBook && advantage >= AI_MATE_MIN_ADVANTAGE)
+    {
+        PROF_BEGIN(MateSearch);
+        long mateNodes = (limits->nodes > 0 && limits->nodes < AI_MATE_NODES) ? limits->nodes : AI_MATE_NODES;
+        mateFound = MateSearch(board, side, (depth + 1) / 2 + AI_MATE_EXTRA_MOVES, mateNodes, &mate);
+        PROF_END(MateSearch);
+    }
+    if (!fromBook && !mateFound) return false;
+
+    memset(&searchStats, 0, sizeof(searchStats));
+    searchStats.side = side;
+    searchStats.requestedDepth = depth;
+    if (fromBook)
+    {
+        searchStats.source = SEARCH_SOURCE_BOOK;
+    }
+    else
+    {
+        *bestMove = mate.line[0];
+        searchStats.source = SEARCH_SOURCE_MATE;
+        searchStats.totalNodes = mate.nodes;
+        searchStats.score = (side == 0) ? INFINITY : -INFINITY;
+    }
+    searchStats.bestMove = *bestMove;
+    return true;
+}
+
+// Décision complète de l'IA pour le camp au trait : livre d'ouverture d'abord ;
+// en position décisive, mat forcé par échecs successifs ; sinon AlphaBeta.
+// Les statistiques (GetLastSearchStats) indiquent d'où vient le coup.
+Move ChooseMoveWithLimits(Board *board, const SearchLimits *limits)
+{
+    uint64_t start = Clock_NowNs();
+    int depth = (limits->depth > 0) ? limits->depth : SEARCH_MAX_DEPTH;
+    Move bestMove;
+
+    if (!ChooseWithoutSearch(board, limits, depth, &bestMove))
+    {
+        PROF_BEGIN(FindBestMove);
+        bestMove = SearchPosition(board, limits);
+        PROF_END(FindBestMove);
+    }
+
+    searchStats.bestMove = bestMove;
+    searchStats.totalMs = (double)(Clock_NowNs() - start) * 1e-6;
+    return bestMove;
+}
+
+// RECHERCHE PAR TRANCHES : le même AlphaBeta, avec une pile explicite à la place de la récursion.
+// Chaque niveau de la pile garde ce que la récursion garde dans ses variables locales ; la
+// recherche peut donc s'interrompre entre deux noeuds et reprendre à l'image suivante.
+#define SLICE_CLOCK_MASK 15 // Horloge relue tous les 16 noeuds (dépassement de la tranche : ~0,1 ms)
+
+typedef struct
+{
+    int depth;
+    int alpha;
+    int beta;
+    int alphaOrig;
+    int betaOrig;
+    bool isMax;
+    int playerTurn;
+    int ply;
+    uint64_t key;
+    Move moves[MAX_MOVES];
+    int count;
+    int index;          // Coup en cours (joué sur le plateau pendant que son sous-arbre est cherché)
+    int bestEval;
+    Move best;
+} SliceFrame;
+
+typedef enum
+{
+    SLICE_IDLE,
+    SLICE_RUNNING,
+    SLICE_DONE
+} SliceState;
+
+// Une seule recherche par tranches à la fois, toujours sur le même thread (celui du jeu) :
+// l'état des recherches du thread (searchStats, table liée...) est le sien
+static struct
+{
+    SliceState state;
+    Board board;                // Copie : le plateau du jeu reste libre entre deux tranches
+    SearchLimits limits;
+    SearchRoot root;
+    RootIteration iteration;
+    bool iterationOpen;
+    int depth;                  // Itération en cours
+    int rootIndex;              // Coup racine en cours
+    Move bestMove;
+    int bestScore;
+    uint64_t start;
+    int top;                    // Niveaux utilisés (0 : entre deux coups racine)
+    SliceFrame frames[SEARCH_MAX_DEPTH];
+} slice;
+
+// Empile un noeud et commence-le : true s'il est résolu sans parcourir ses coups (*score)
+static bool SlicePush(int depth, int a, int beta, bool isMax, int playerTurn, int ply, int *score)
+{
+    SliceFrame *f = &slice.frames[slice.top++];
+    f->depth = depth;
+    f->alpha = f->alphaOrig = a;
+    f->beta = f->betaOrig = beta;
+    f->isMax = isMax;
+    f->playerTurn = playerTurn;
+    f->ply = ply;
+#ifdef SEARCH_TRACE
+    SearchTrace_Enter(ply, depth, a, beta, playerTurn);
+#endif
+    if (NodeProbe(&slice.board, depth, a, beta, isMax, playerTurn, ply, &f->key, f->moves, &f->count, score)) return true;
+
+    f->index = 0;
+    f->bestEval = isMax ? -INFINITY_SCORE : INFINITY_SCORE;
+    f->best = f->moves[0];
+    return false;
+}
+
+// Score du coup en cours d'un noeud : true si le noeud est fini (coupure ou dernier coup)
+static bool SliceChildResult(SliceFrame *f, int eval)
+{
+    Move m = f->moves[f->index];
+    bool better = f->isMax ? (eval > f->bestEval) : (eval < f->bestEval);
+    if (better)
+    {
+        f->best = m;
+        UpdatePV(f->ply, m);
+    }
+    if (f->isMax)
+    {
+        f->bestEval = max(f->bestEval, eval);
+        f->alpha = max(f->alpha, eval);
+    }
+    else
+    {
+        f->bestEval = min(f->bestEval, eval);
+        f->beta = min(f->beta, eval);
+    }
+    if (f->beta <= f->alpha)
+    {
+        currentIteration->betaCutoffs++;
+        if (f->index == 0) currentIteration->firstMoveCutoffs++;
+        TRACE_NODE(f->ply, TRACE_EXIT_SEARCHED, f->index, f->index + 1);
+        return true;
+    }
+    return f->index + 1 == f->count;
+}
+
+// Fin de la recherche (dernière itération, arrêt ou limite) : résultat comme SearchPosition
+static void SliceFinish(void)
+{
+    currentIteration = NULL;
+    SearchEnd(&slice.root, slice.bestMove, slice.bestScore);
+    searchStats.totalMs = (double)(Clock_NowNs() - slice.start) * 1e-6;
+    slice.state = SLICE_DONE;
+}
+
+// Coup racine cherché (score exact) : false si l'itération a été interrompue
+static bool SliceRootResult(int eval)
+{
+    Move move = slice.root.moves[slice.rootIndex];
+    UndoSimulatedMove(&slice.board, move);
+    if (searchAborted)
+    {
+        searchStats.totalNodes += slice.iteration.it->nodes;
+        return false;
+    }
+    RootIterationMove(&slice.iteration, slice.root.playerTurn, move, eval);
+    slice.rootIndex++;
+    return true;
+}
+
+// Avance la recherche jusqu'à sliceEnd (Clock_NowNs) : true quand elle est terminée
+static bool SliceRun(uint64_t sliceEnd)
+{
+    int playerTurn = slice.root.playerTurn;
+    for (;;)
+    {
+        // Début ou fin d'itération (entre deux coups racine), comme IterativeDeepening
+        if (slice.top == 0 && !slice.iterationOpen)
+        {
+            if (slice.depth > slice.root.maxDepth || (slice.depth > 1 && !SearchCanDeepen()))
+            {
+                SliceFinish();
+                return true;
+            }
+            RootIterationBegin(&slice.iteration, slice.depth, playerTurn, slice.root.moves[0]);
+            slice.iterationOpen = true;
+            slice.rootIndex = 0;
+        }
+        if (slice.top == 0 && slice.rootIndex == slice.root.count)
+        {
+            RootIterationEnd(&slice.iteration, slice.root.moves, slice.root.count, &slice.limits);
+            slice.bestMove = slice.iteration.best;
+            slice.bestScore = slice.iteration.score;
+            slice.iterationOpen = false;
+            slice.depth++;
+            continue;
+        }
+
+        // Tranche écoulée : on rend la main avant de descendre (l'état est entièrement dans la pile)
+        if ((currentIteration->nodes & SLICE_CLOCK_MASK) == 0 && Clock_NowNs() >= sliceEnd) return false;
+
+        // Descente : prochain coup de la racine ou du noeud au sommet
+        int score;
+        bool resolved;
+        if (slice.top == 0)
+        {
+            Move move = slice.root.moves[slice.rootIndex];
+            SimulateMove(&slice.board, move);
+            TRACE_MOVE(1, move);
+            resolved = SlicePush(slice.depth - 1, -INFINITY_SCORE, INFINITY_SCORE, (playerTurn == 0) ? false : true, 1 - playerTurn, 1, &score);
+        }
+        else
+        {
+            SliceFrame *f = &slice.frames[slice.top - 1];
+            Move m = f->moves[f->index];
+            SimulateMove(&slice.board, m);
+            TRACE_MOVE(f->ply + 1, m);
+            resolved = SlicePush(f->depth - 1, f->alpha, f->beta, !f->isMax, 1 - f->playerTurn, f->ply + 1, &score);
+        }
+        if (!resolved) continue;
+
+        // Remontée : le score passe au parent, tant que les noeuds se terminent
+        for (;;)
+        {
+            slice.top--;
+#ifdef SEARCH_TRACE
+            SearchTrace_Exit(slice.frames[slice.top].ply, slice.frames[slice.top].depth, score);
+#endif
+            if (slice.top == 0)
+            {
+                if (!SliceRootResult(score))
+                {
+                    SliceFinish();
+                    return true;
+                }
+                break;
+            }
+
+            SliceFrame *parent = &slice.frames[slice.top - 1];
+            UndoSimulatedMove(&slice.board, parent->moves[parent->index]);
+            if (searchAborted)
+            {
+                score = 0;
+                continue;
+            }
+            if (!SliceChildResult(parent, score))
+            {
+                parent->index++;
+                break;
+            }
+            NodeStore(parent->key, parent->depth, parent->ply, parent->bestEval, parent->alphaOrig, parent->betaOrig, parent->best);
+            score = parent->bestEval;
+        }
+    }
+}
+
+void SliceSearch_Start(const Board *board, const SearchLimits *limits)
+{
+    slice.start = Clock_NowNs();
+    slice.board = *board;
+    slice.limits = *limits;
+    slice.limits.threads = 1;
+    int depth = (limits->depth > 0) ? limits->depth : SEARCH_MAX_DEPTH;
+
+    // Livre et mat forcé : courts (solveur limité à AI_MATE_NODES noeuds), faits tout de suite
+    if (ChooseWithoutSearch(&slice.board, limits, depth, &slice.bestMove))
+    {
+        searchStats.totalMs = (double)(Clock_NowNs() - slice.start) * 1e-6;
+        slice.state = SLICE_DONE;
+        return;
+    }
+    if (!SearchBegin(&slice.board, &slice.limits, &slice.root, &slice.bestMove))
+    {
+        searchStats.bestMove = slice.bestMove;
+        searchStats.totalMs = (double)(Clock_NowNs() - slice.start) * 1e-6;
+        slice.state = SLICE_DONE;
+        return;
+    }
+    slice.bestMove = slice.root.moves[0];
+    slice.bestScore = 0;
+    slice.depth = 1;
+    slice.iterationOpen = false;
+    slice.top = 0;
+    slice.state = SLICE_RUNNING;
+}
+
+bool SliceSearch_Step(double sliceMs, Move *bestMove)
+{
+    if (slice.state == SLICE_RUNNING)
+    {
+        PROF_BEGIN(SliceSearch);
+        SliceRun(Clock_NowNs() + (uint64_t)(sliceMs * 1e6));
+        PROF_END(SliceSearch);
+    }
+    if (slice.state != SLICE_DONE) return false;
+
+    slice.state = SLICE_IDLE;
+    *bestMove = slice.bestMove;
+    return true;
+}
+
+bool SliceSearch_IsActive(void)
+{
+    return slice.state != SLICE_IDLE;
+}
+
+void SliceSearch_Abort(void)
+{
+    // Le plateau est une copie : rien à défaire, l'itération en cours est simplement oubliée
+    if (slice.state == SLICE_RUNNING)
+    {
+        currentIteration = NULL;
+        searchControl = NULL;
+    }
+    slice.state = SLICE_IDLE;
+}
+
+// Vitesse de la machine (noeuds/s) : courte recherche sur une position de milieu de partie,
+// avec sa propre table de transposition (la table globale n'est pas touchée)
+double MeasureSearchSpeed(double budgetMs)
+{
+    TTable *previous = TT_Current();
+    TTable *table = TT_Create(1);
+    if (table != NULL) TT_Bind(table);
+
+    static _Thread_local Board board;
+    BoardFromFEN(&board, SEARCH_SPEED_FEN, NULL);
+    SearchControl control;
+    SearchControl_Reset(&control);
+    SearchControl_SetTime(&control, budgetMs, budgetMs);
+    SearchLimits limits = { 0 };
+    limits.threads = 1;
+    limits.control = &control;
+
+    uint64_t start = Clock_NowNs();
+    SearchPosition(&board, &limits);
+    double ms = (double)(Clock_NowNs() - start) * 1e-6;
+    long nodes = searchStats.totalNodes;
+
+    TT_Bind(previous);
+    TT_Destroy(table);
+    memset(&searchStats, 0, sizeof(searchStats)); // Pas une décision de l'IA
+    return (ms > 0.0) ? nodes * 1000.0 / ms : 0.0;
+}
+
+Move ChooseMove(Board *board, int depth)
+{
+    SearchLimits limits = { 0 };
+    limits.depth = depth;
+    limits.threads = 1;
+    return ChooseMoveWithLimits(board, &limits);
+}
@@ -0,0 +1,102 @@
+#include "searchstats.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static FILE *gLogFile = NULL;
+static bool gLogCsv = false;
+static long gSearchId = 0;
+
+const char *SearchSourceName(SearchSource source)
+{
+    switch (source)
+    {
+        case SEARCH_SOURCE_SEARCH: return "recherche";
+        case SEARCH_SOURCE_BOOK: return "livre";
+        case SEARCH_SOURCE_MATE: return "mat";
+        case SEARCH_SOURCE_LEARN: return "apprentissage";
+        default: return "aucune";
+    }
+}
+
+bool SearchLog_Open(const char *path)
+{
+    SearchLog_Close();
+    gLogFile = fopen(path, "a");
+    if (gLogFile == NULL) return false;
+
+    size_t length = strlen(path);
+    gLogCsv = (length >= 4 && strcmp(path + length - 4, ".csv") == 0);
+
+    // En-tête seulement pour un fichier CSV neuf
+    fseek(gLogFile, 0, SEEK_END);
+    if (gLogCsv && ftell(gLogFile) == 0)
+    {
+        fprintf(gLogFile, "time,search,source,side,depth,nodes,leaf_nodes,time_ms,nps,ebf,"
+            "beta_cutoffs,first_move_cutoffs,tt_probes,tt_hits,tt_cutoffs,score,best,pv\n");
+    }
+    return true;
+}
+
+void SearchLog_Close(void)
+{
+    if (gLogFile != NULL) fclose(gLogFile);
+    gLogFile = NULL;
+}
+
+static void WritePV(const SearchIteration *it)
+{
+    for (int i = 0; i < it->pvLength; i++)
+    {
+        char text[6];
+        MoveToString(it->pv[i], text);
+        fprintf(gLogFile, (i == 0) ? "%s" : " %s", text);
+    }
+}
+
+void SearchLog_Write(const SearchStats *stats)
+{
+    if (gLogFile == NULL) return;
+
+    long now = (long)time(NULL);
+    gSearchId++;
+    char best[6];
+    MoveToString(stats->bestMove, best);
+
+    if (gLogCsv)
+    {
+        // Recherche sans itération (livre, mat...) : une seule ligne
+        int rows = (stats->iterationCount > 0) ? stats->iterationCount : 1;
+        for (int r = 0; r < rows; r++)
+        {
+            SearchIteration empty = { 0 };
+            const SearchIteration *it = (stats->iterationCount > 0) ? &stats->iterations[r] : &empty;
+            fprintf(gLogFile, "%ld,%ld,%s,%d,%d,%ld,%ld,%.3f,%.0f,%.2f,%ld,%ld,%ld,%ld,%ld,%d,%s,",
+                now, gSearchId, SearchSourceName(stats->source), stats->side, it->depth, it->nodes, it->leafNodes,
+                it->timeMs, it->nps, it->branchingFactor, it->betaCutoffs, it->firstMoveCutoffs,
+                it->ttProbes, it->ttHits, it->ttCutoffs, (stats->iterationCount > 0) ? it->score : stats->score, best);
+            WritePV(it);
+            fprintf(gLogFile, "\n");
+        }
+    }
+    else
+    {
+        fprintf(gLogFile, "{\"time\":%ld,\"search\":%ld,\"source\":\"%s\",\"side\":%d,\"depth\":%d,"
+            "\"nodes\":%ld,\"time_ms\":%.3f,\"score\":%d,\"best\":\"%s\",\"iterations\":[",
+            now, gSearchId, SearchSourceName(stats->source), stats->side, stats->requestedDepth,
+            stats->totalNodes, stats->totalMs, stats->score, best);
+        for (int r = 0; r < stats->iterationCount; r++)
+        {
+            const SearchIteration *it = &stats->iterations[r];
+            fprintf(gLogFile, "%s{\"depth\":%d,\"nodes\":%ld,\"leaf_nodes\":%ld,\"time_ms\":%.3f,\"nps\":%.0f,"
+                "\"ebf\":%.2f,\"beta_cutoffs\":%ld,\"first_move_cutoffs\":%ld,\"tt_probes\":%ld,\"tt_hits\":%ld,"
+                "\"tt_cutoffs\":%ld,\"score\":%d,\"pv\":\"",
+                (r == 0) ? "" : ",", it->depth, it->nodes, it->leafNodes, it->timeMs, it->nps, it->branchingFactor,
+                it->betaCutoffs, it->firstMoveCutoffs, it->ttProbes, it->ttHits, it->ttCutoffs, it->score);
+            WritePV(it);
+            fprintf(gLogFile, "\"}");
+        }
+        fprintf(gLogFile, "]}\n");
+    }
+    fflush(gLogFile);
+}
@@ -0,0 +1,121 @@
+#include "searchtrace.h"
+
+#ifdef SEARCH_TRACE
+
+#include "clock.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TRACE_BUFFER_RECORDS 4096
+#define TRACE_MAX_PLY 128
+
+static FILE *gTraceFile = NULL;
+static TraceRecord gBuffer[TRACE_BUFFER_RECORDS];
+static int gBuffered = 0;
+static uint64_t gSearchStart = 0;
+
+// Informations du noeud en cours à chaque ply
+static uint16_t gMove[TRACE_MAX_PLY];
+static uint8_t gReason[TRACE_MAX_PLY];
+static uint16_t gCutoff[TRACE_MAX_PLY];
+static int32_t gMoveCount[TRACE_MAX_PLY];
+
+static void Flush(void)
+{
+    if (gTraceFile != NULL && gBuffered > 0) fwrite(gBuffer, sizeof(TraceRecord), (size_t)gBuffered, gTraceFile);
+    gBuffered = 0;
+}
+
+static void Emit(int type, int ply, int depth, int info, uint16_t move, uint16_t extra, int32_t a, int32_t b)
+{
+    if (gTraceFile == NULL) return;
+
+    TraceRecord *r = &gBuffer[gBuffered++];
+    r->type = (uint8_t)type;
+    r->ply = (uint8_t)ply;
+    r->depth = (int8_t)depth;
+    r->info = (uint8_t)info;
+    r->move = move;
+    r->extra = extra;
+    r->a = a;
+    r->b = b;
+    r->timeUs = (uint32_t)((Clock_NowNs() - gSearchStart) / 1000);
+
+    if (gBuffered == TRACE_BUFFER_RECORDS) Flush();
+}
+
+bool SearchTrace_Open(const char *path)
+{
+    SearchTrace_Close();
+    gTraceFile = fopen(path, "wb");
+    if (gTraceFile == NULL) return false;
+
+    TraceHeader header;
+    memcpy(header.magic, TRACE_MAGIC, 4);
+    header.version = TRACE_VERSION;
+    header.recordSize = sizeof(TraceRecord);
+    header.reserved = 0;
+    fwrite(&header, sizeof(header), 1, gTraceFile);
+
+    for (int i = 0; i < TRACE_MAX_PLY; i++) gCutoff[i] = TRACE_NO_CUTOFF;
+    return true;
+}
+
+void SearchTrace_Close(void)
+{
+    if (gTraceFile == NULL) return;
+    Flush();
+    fclose(gTraceFile);
+    gTraceFile = NULL;
+}
+
+void SearchTrace_Begin(int depth, int side)
+{
+    gSearchStart = Clock_NowNs();
+    Emit(TRACE_SEARCH_BEGIN, 0, depth, side, 0, 0, 0, 0);
+}
+
+void SearchTrace_Iteration(int depth)
+{
+    Emit(TRACE_ITERATION, 0, depth, 0, 0, 0, 0, 0);
+    Flush(); // Une itération complète est toujours sur disque si le jeu s'arrête
+}
+
+void SearchTrace_SetMove(int ply, uint16_t move)
+{
+    if (ply < TRACE_MAX_PLY) gMove[ply] = move;
+}
+
+void SearchTrace_SetNodeInfo(int ply, int reason, int cutoffIndex, int moveCount)
+{
+    if (ply >= TRACE_MAX_PLY) return;
+    gReason[ply] = (uint8_t)reason;
+    gCutoff[ply] = (cutoffIndex < 0) ? TRACE_NO_CUTOFF : (uint16_t)cutoffIndex;
+    gMoveCount[ply] = moveCount;
+}
+
+void SearchTrace_Enter(int ply, int depth, int alpha, int beta, int side)
+{
+    uint16_t move = (ply < TRACE_MAX_PLY) ? gMove[ply] : 0;
+    Emit(TRACE_ENTER, ply, depth, side, move, 0, alpha, beta);
+}
+
+void SearchTrace_Exit(int ply, int depth, int score)
+{
+    if (ply >= TRACE_MAX_PLY)
+    {
+        Emit(TRACE_EXIT, ply, depth, TRACE_EXIT_SEARCHED, 0, TRACE_NO_CUTOFF, score, 0);
+        return;
+    }
+    Emit(TRACE_EXIT, ply, depth, gReason[ply], gMove[ply], gCutoff[ply], score, gMoveCount[ply]);
+    gReason[ply] = TRACE_EXIT_SEARCHED;
+    gCutoff[ply] = TRACE_NO_CUTOFF;
+    gMoveCount[ply] = 0;
+}
+
+#else
+
+// Unité de compilation vide dans les versions normales
+typedef int SearchTraceDisabled;
+
+#endif
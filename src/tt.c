@@ -0,0 +1,161 @@
+#include "tt.h"
+#include <stdlib.h>
+#include <string.h>
+
+struct TTable
+{
+    TTEntry *entries;
+    size_t bucketCount; // Puissance de 2
+    uint8_t age;        // 6 bits
+};
+
+// Table globale (TT_Init) et table utilisée par le thread (TT_Bind)
+static TTable gDefault = { NULL, 0, 0 };
+static _Thread_local TTable *tlsTable = NULL;
+
+static TTable *Current(void)
+{
+    return (tlsTable != NULL) ? tlsTable : &gDefault;
+}
+
+static bool Allocate(TTable *table, int sizeMB)
+{
+    if (sizeMB <= 0) return false;
+
+    // Plus grande puissance de 2 de seaux qui tient dans la taille demandée
+    size_t bytes = (size_t)sizeMB * 1024 * 1024;
+    size_t buckets = 1;
+    while (buckets * 2 * TT_BUCKET_SIZE * sizeof(TTEntry) <= bytes) buckets *= 2;
+
+    table->entries = calloc(buckets * TT_BUCKET_SIZE, sizeof(TTEntry));
+    if (table->entries == NULL) return false;
+    table->bucketCount = buckets;
+    table->age = 0;
+    return true;
+}
+
+bool TT_Init(int sizeMB)
+{
+    TT_Free();
+    return Allocate(&gDefault, sizeMB);
+}
+
+void TT_Free(void)
+{
+    free(gDefault.entries);
+    gDefault.entries = NULL;
+    gDefault.bucketCount = 0;
+}
+
+TTable *TT_Create(int sizeMB)
+{
+    TTable *table = calloc(1, sizeof(TTable));
+    if (table != NULL && !Allocate(table, sizeMB))
+    {
+        free(table);
+        table = NULL;
+    }
+    return table;
+}
+
+void TT_Destroy(TTable *table)
+{
+    if (table == NULL) return;
+    if (tlsTable == table) tlsTable = NULL;
+    free(table->entries);
+    free(table);
+}
+
+void TT_Bind(TTable *table)
+{
+    tlsTable = table;
+}
+
+TTable *TT_Current(void)
+{
+    return Current();
+}
+
+void TT_Clear(void)
+{
+    TTable *t = Current();
+    if (t->entries != NULL) memset(t->entries, 0, t->bucketCount * TT_BUCKET_SIZE * sizeof(TTEntry));
+    t->age = 0;
+}
+
+void TT_NewSearch(void)
+{
+    TTable *t = Current();
+    t->age = (uint8_t)((t->age + 1) & 63);
+}
+
+// Table partagée par les threads de recherche, sans verrou : chaque entrée garde key ^ données.
+// Une entrée à moitié écrite par un autre thread ne correspond plus à sa clé et est ignorée.
+_Static_assert(sizeof(TTEntry) == 16, "TTEntry : clé puis 8 octets de données");
+
+static uint64_t EntryData(const TTEntry *e)
+{
+    uint64_t data;
+    memcpy(&data, (const unsigned char *)e + sizeof(e->key), sizeof(data));
+    return data;
+}
+
+static TTEntry *Bucket(const TTable *t, uint64_t key)
+{
+    return &t->entries[(key & (t->bucketCount - 1)) * TT_BUCKET_SIZE];
+}
+
+bool TT_Probe(uint64_t key, TTEntry *entry)
+{
+    const TTable *t = Current();
+    if (t->entries == NULL) return false;
+
+    TTEntry *bucket = Bucket(t, key);
+    for (int i = 0; i < TT_BUCKET_SIZE; i++)
+    {
+        TTEntry copy = bucket[i];
+        if ((copy.key ^ EntryData(&copy)) == key)
+        {
+            copy.key = key;
+            *entry = copy;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TT_Store(uint64_t key, int depth, int score, int bound, uint16_t move)
+{
+    const TTable *t = Current();
+    if (t->entries == NULL) return;
+
+    // Remplacement : même position, sinon l'entrée la moins utile (peu profonde ou ancienne)
+    TTEntry *bucket = Bucket(t, key);
+    TTEntry *victim = &bucket[0];
+    int victimWorth = 1 << 30;
+    for (int i = 0; i < TT_BUCKET_SIZE; i++)
+    {
+        TTEntry *e = &bucket[i];
+        if ((e->key ^ EntryData(e)) == key)
+        {
+            victim = e;
+            if (move == TT_MOVE_NONE) move = e->move; // On garde le meilleur coup connu
+            break;
+        }
+        int age = (t->age - (e->boundAge >> 2)) & 63;
+        int worth = (e->key == 0) ? -1000 : e->depth - 2 * age;
+        if (worth < victimWorth)
+        {
+            victim = e;
+            victimWorth = worth;
+        }
+    }
+
+    TTEntry e = { 0 };
+    e.score = score;
+    e.move = move;
+    e.depth = (int8_t)depth;
+    e.boundAge = (uint8_t)((t->age << 2) | (bound & 3));
+    e.key = key ^ EntryData(&e);
+    *victim = e;
+}
@@ -0,0 +1,36 @@
+#include "zobrist.h"
+#include <stdbool.h>
+
+uint64_t gZobristPiece[14][64];
+uint64_t gZobristCastling[4];
+uint64_t gZobristEnPassant[8];
+uint64_t gZobristSide;
+
+// Générateur SplitMix64 : les clés doivent rester stables (livres d'ouverture, fichiers)
+static uint64_t NextRandom(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void Zobrist_Init(void)
+{
+    static bool initialized = false;
+    if (initialized) return;
+
+    uint64_t state = 0x43484553534B4559ULL; // "CHESSKEY"
+    for (int piece = 0; piece < 14; piece++)
+    {
+        for (int sq = 0; sq < 64; sq++)
+        {
+            gZobristPiece[piece][sq] = NextRandom(&state);
+        }
+    }
+    for (int i = 0; i < 4; i++) gZobristCastling[i] = NextRandom(&state);
+    for (int i = 0; i < 8; i++) gZobristEnPassant[i] = NextRandom(&state);
+    gZobristSide = NextRandom(&state);
+
+    initialized = true;
+}
@@ -0,0 +1,28 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+// Mini-cadre des tests du moteur (make test) : chaque test_*.c est un programme qui renvoie
+// 0 si toutes ses vérifications passent. Lancés depuis la racine du dépôt (assets/).
+#include <stdio.h>
+
+static int gCheckFailures = 0;
+
+#define CHECK(cond) \
+    do \
+    { \
+        if (!(cond)) \
+        { \
+            fprintf(stderr, "%s:%d : échec de %s\n", __FILE__, __LINE__, #cond); \
+            gCheckFailures++; \
+        } \
+    } while (0)
+
+// Fin du test : bilan sur une ligne, code de sortie pour make
+static int CheckReport(const char *name)
+{
+    if (gCheckFailures == 0) printf("%-16s ok\n", name);
+    else printf("%-16s %d échec(s)\n", name, gCheckFailures);
+    return gCheckFailures == 0 ? 0 : 1;
+}
+
+#endif
@@ -0,0 +1,130 @@
+// Bitbases : un pion sur la dernière rangée (promotion non jouée par SimulateMove) se lit dans KQK,
+// et une finale KPK gagnée se joue en promouvant.
+#include "bitbase.h"
+#include "chesscore.h"
+#include "check.h"
+#include "searchstats.h"
+#include "tt.h"
+#include "zobrist.h"
+
+static void BoardSquares(const Board *board, int squares[64])
+{
+    for (int sq = 0; sq < 64; sq++)
+    {
+        const Tile *t = &board->tiles[sq / 8][sq % 8];
+        squares[sq] = (t->layerCount > 1) ? t->layers[t->layerCount - 1] : 0;
+    }
+}
+
+static int SquaresFromFEN(const char *fen, int squares[64], int *side)
+{
+    static Board board;
+    if (!BoardFromFEN(&board, fen, side)) return 0;
+    BoardSquares(&board, squares);
+    return 1;
+}
+
+static void TestPromotedPawnProbe(void)
+{
+    int pawn[64], queen[64], side;
+    CHECK(SquaresFromFEN("P7/8/8/8/8/1K6/8/7k b - - 0 1", pawn, &side));
+    CHECK(SquaresFromFEN("Q7/8/8/8/8/1K6/8/7k b - - 0 1", queen, &side));
+    CHECK(Bitbase_Probe(queen, 1) == BITBASE_WHITE_WINS);
+    CHECK(Bitbase_Probe(pawn, 1) == Bitbase_Probe(queen, 1));
+
+    // Même chose côté Noir (symétrie du camp fort)
+    CHECK(SquaresFromFEN("7K/8/1k6/8/8/8/8/p7 w - - 0 1", pawn, &side));
+    CHECK(Bitbase_Probe(pawn, 0) == BITBASE_BLACK_WINS);
+}
+
+// Le compteur de pièces (filtre des sondages) suit les prises, en passant compris, et leur annulation
+static void TestPieceCount(void)
+{
+    static Board board;
+    int side;
+    CHECK(BoardFromFEN(&board, "4k3/8/8/n2pP3/8/8/8/R3K3 w - d6 0 1", &side));
+    CHECK(board.pieceCount == 6);
+
+    Move moves[MAX_MOVES];
+    int count = GenerateLegalMoves(&board, moves, 0);
+    int captures = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (moves[i].capturedPieceID == 0) continue;
+        captures++;
+        SimulateMove(&board, moves[i]);
+        CHECK(board.pieceCount == 5);
+        UndoSimulatedMove(&board, moves[i]);
+        CHECK(board.pieceCount == 6);
+    }
+    CHECK(captures == 2); // Txa5 et exd6 en passant
+}
+
+// a7 promeut au premier coup, et un pion plus loin avance jusqu'à la promotion sans que
+// l'IA tourne en rond (le gain reste acquis à chaque coup)
+static void TestKPKPromotes(void)
+{
+    static Board board;
+    int side;
+    SearchLimits limits = { .depth = 6 };
+
+    CHECK(BoardFromFEN(&board, "8/P7/8/8/8/1K6/8/7k w - - 0 1", &side));
+    Move first = ChooseMoveWithLimits(&board, &limits);
+    CHECK(first.startX == 0 && first.startY == 1 && first.endX == 0 && first.endY == 0);
+
+    CHECK(BoardFromFEN(&board, "8/8/8/P7/8/1K6/8/7k w - - 0 1", &side));
+    bool promoted = false;
+    for (int ply = 0; ply < 12 && !promoted; ply++)
+    {
+        Move m = ChooseMoveWithLimits(&board, &limits);
+        if (m.movingPieceID == 6 && m.endY == 0) promoted = true;
+        ApplyMove(&board, m, 0);
+        board.sideToMove = 1 - board.sideToMove;
+
+        int squares[64];
+        BoardSquares(&board, squares);
+        CHECK(Bitbase_Probe(squares, board.sideToMove) == BITBASE_WHITE_WINS);
+    }
+    CHECK(promoted);
+}
+
+// Une position déjà vue plus loin de la racine : le bonus de promotion relu de la table
+// est compté depuis la nouvelle racine (a7 puis a8 : même score avec ou sans table remplie)
+static int SearchScore(const char *fen, int depth)
+{
+    static Board board;
+    int side;
+    CHECK(BoardFromFEN(&board, fen, &side));
+    SearchLimits limits = { .depth = depth, .threads = 1 };
+    SearchPosition(&board, &limits);
+    return GetLastSearchStats()->score;
+}
+
+static void TestPromotionScoreTransposes(void)
+{
+    const char *near = "8/8/P7/8/8/1K6/8/7k w - - 0 1";
+    TT_Clear();
+    int fresh = SearchScore(near, 4);
+
+    // Rh1 depuis la position d'avant : 'near' est atteinte au ply 1, ses coups notés un ply plus loin
+    TT_Clear();
+    SearchScore("8/8/P7/8/8/1K6/8/6k1 b - - 0 1", 5);
+    CHECK(SearchScore(near, 4) == fresh);
+}
+
+int main(void)
+{
+    Zobrist_Init();
+    TT_Init(16);
+    if (Bitbase_Load("assets") != 3)
+    {
+        fprintf(stderr, "Bitbases absentes (make bitbases)\n");
+        return 1;
+    }
+
+    TestPieceCount();
+    TestPromotedPawnProbe();
+    TestKPKPromotes();
+    TestPromotionScoreTransposes();
+    return CheckReport("bitbase");
+}
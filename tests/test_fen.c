@@ -0,0 +1,32 @@
+// Positions FEN : une position sans exactement un roi par camp est refusée, comme une FEN mal formée.
+#include "chesscore.h"
+#include "check.h"
+
+static void TestKingsRequired(void)
+{
+    static Board board;
+    int side;
+    CHECK(BoardFromFEN(&board, "4k3/8/8/8/8/8/8/4K3 w - - 0 1", &side));
+    CHECK(board.pieceCount == 2);
+
+    CHECK(!BoardFromFEN(&board, "8/8/8/8/8/8/8/8 w - -", &side));          // Aucun roi
+    CHECK(!BoardFromFEN(&board, "8/8/8/8/8/8/8/4K3 w - -", &side));        // Roi noir absent
+    CHECK(!BoardFromFEN(&board, "4k3/8/8/8/8/8/8/8 b - -", &side));        // Roi blanc absent
+    CHECK(!BoardFromFEN(&board, "4k3/8/8/8/8/8/8/2K1K3 w - -", &side));    // Deux rois blancs
+    CHECK(!BoardFromFEN(&board, "3kk3/8/8/8/8/8/8/4K3 w - -", &side));     // Deux rois noirs
+}
+
+static void TestMalformed(void)
+{
+    static Board board;
+    int side;
+    CHECK(!BoardFromFEN(&board, "4k3/8/8/8/8/8/4K3 w - -", &side));        // Sept rangées
+    CHECK(!BoardFromFEN(&board, "4k3/8/8/8/8/8/8/4K2 w - -", &side));      // Rangée incomplète
+}
+
+int main(void)
+{
+    TestKingsRequired();
+    TestMalformed();
+    return CheckReport("fen");
+}
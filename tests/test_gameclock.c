@@ -0,0 +1,89 @@
+// Pendules : des coups de moins d'une milliseconde sont débités exactement, sans arrondi cumulé.
+#include "check.h"
+#include "gameclock.h"
+
+#define MS 1000000ull // En nanosecondes
+
+// 'moves' coups alternés de 'moveNs' chacun, à partir de l'instant 'start' ; renvoie l'instant final
+static uint64_t PlayMoves(GameClock *clock, uint64_t start, int moves, uint64_t moveNs)
+{
+    uint64_t now = start;
+    GameClock_Start(clock, 0, now);
+    for (int i = 0; i < moves; i++)
+    {
+        now += moveNs;
+        GameClock_Press(clock, now);
+    }
+    return now;
+}
+
+static void TestShortMovesCharged(void)
+{
+    // 1000 coups de 1,5 ms : 750 ms débitées à chaque camp (et non 500)
+    GameClock clock;
+    GameClock_Init(&clock, GAMECLOCK_FISCHER, 60000, 0);
+    uint64_t now = PlayMoves(&clock, 1000 * MS, 2000, 1500000);
+    GameClock_Stop(&clock, now);
+    CHECK(GameClock_RemainingMs(&clock, 0, now) == 60000 - 1500);
+    CHECK(GameClock_RemainingMs(&clock, 1, now) == 60000 - 1500);
+
+    // Délai simple de 3 s, coups de 3,0004 s : 0,4 ms débitée par coup, 40 ms en 100 coups
+    GameClock_Init(&clock, GAMECLOCK_DELAY, 60000, 3000);
+    now = PlayMoves(&clock, 0, 200, 3000 * MS + 400000);
+    GameClock_Stop(&clock, now);
+    CHECK(GameClock_RemainingMs(&clock, 0, now) == 60000 - 40);
+
+    // Bronstein : le temps rendu est celui du coup, à la nanoseconde
+    GameClock_Init(&clock, GAMECLOCK_BRONSTEIN, 60000, 2000);
+    now = PlayMoves(&clock, 0, 200, 1500000);
+    GameClock_Stop(&clock, now);
+    CHECK(GameClock_RemainingMs(&clock, 0, now) == 60000);
+}
+
+static void TestFlagBelowOneMillisecond(void)
+{
+    // Il reste 0,5 ms : affichage à 0, mais le camp n'est pas encore tombé
+    GameClock clock;
+    GameClock_Init(&clock, GAMECLOCK_FISCHER, 1000, 0);
+    GameClock_Start(&clock, 0, 0);
+    uint64_t now = 999 * MS + 500000;
+    CHECK(GameClock_RemainingMs(&clock, 0, now) == 0);
+    CHECK(!GameClock_Flagged(&clock, 0, now));
+    CHECK(GameClock_Flagged(&clock, 0, 1000 * MS));
+}
+
+static void TestRestartWithoutIncrement(void)
+{
+    GameClock clock;
+    GameClock_Init(&clock, GAMECLOCK_FISCHER, 60000, 2000);
+    GameClock_Start(&clock, 0, 0);
+    GameClock_Restart(&clock, 1, 1500 * MS);
+    CHECK(GameClock_RemainingMs(&clock, 0, 1500 * MS) == 60000 - 1500);
+    CHECK(clock.running == 1);
+}
+
+static void TestStopWithoutIncrement(void)
+{
+    // Fin de partie (mat, abandon, pat) pendant la réflexion : débit seul, aucun incrément
+    GameClock clock;
+    GameClock_Init(&clock, GAMECLOCK_FISCHER, 60000, 2000);
+    GameClock_Start(&clock, 0, 0);
+    GameClock_Stop(&clock, 500 * MS);
+    CHECK(GameClock_RemainingMs(&clock, 0, 500 * MS) == 60000 - 500);
+    CHECK(!GameClock_IsRunning(&clock));
+
+    // Bronstein : rien n'est rendu non plus
+    GameClock_Init(&clock, GAMECLOCK_BRONSTEIN, 60000, 2000);
+    GameClock_Start(&clock, 1, 0);
+    GameClock_Stop(&clock, 500 * MS);
+    CHECK(GameClock_RemainingMs(&clock, 1, 500 * MS) == 60000 - 500);
+}
+
+int main(void)
+{
+    TestShortMovesCharged();
+    TestFlagBelowOneMillisecond();
+    TestRestartWithoutIncrement();
+    TestStopWithoutIncrement();
+    return CheckReport("gameclock");
+}
@@ -0,0 +1,131 @@
+// Historique : chaque position passée se reconstruit à l'identique depuis les copies complètes,
+// roques, prise en passant et sous-promotion compris, y compris après un retour arrière.
+#include "chesscore.h"
+#include "check.h"
+#include "history.h"
+#include <string.h>
+
+#define TEST_PLIES (3 * HISTORY_KEYFRAME_INTERVAL + 5)
+
+static GameHistory history;
+static Board played[TEST_PLIES + 1]; // [ply] : position réelle après 'ply' demi-coups
+
+// État de jeu seulement : ni compteur de version (interface) ni accumulateur NNUE
+static bool SamePosition(const Board *a, const Board *b)
+{
+    for (int y = 0; y < BOARD_ROWS; y++)
+    {
+        for (int x = 0; x < BOARD_COLS; x++)
+        {
+            const Tile *ta = &a->tiles[y][x];
+            const Tile *tb = &b->tiles[y][x];
+            if (ta->layerCount != tb->layerCount) return false;
+            if (memcmp(ta->layers, tb->layers, sizeof(int) * (size_t)ta->layerCount) != 0) return false;
+        }
+    }
+    return a->sideToMove == b->sideToMove
+        && memcmp(a->kingMoved, b->kingMoved, sizeof(a->kingMoved)) == 0
+        && memcmp(a->rookMoved, b->rookMoved, sizeof(a->rookMoved)) == 0
+        && a->enPassantX == b->enPassantX && a->enPassantY == b->enPassantY
+        && a->capturedByWhiteCount == b->capturedByWhiteCount
+        && a->capturedByBlackCount == b->capturedByBlackCount
+        && memcmp(a->capturedByWhite, b->capturedByWhite, sizeof(int) * (size_t)a->capturedByWhiteCount) == 0
+        && memcmp(a->capturedByBlack, b->capturedByBlack, sizeof(int) * (size_t)a->capturedByBlackCount) == 0
+        && a->pieceCount == b->pieceCount;
+}
+
+// Joue le coup légal d'indice 'index' (modulo leur nombre) ou, si 'uci' est donné, le coup
+// "e2e4" correspondant ; l'enregistre et garde la position obtenue. false si aucun coup.
+static bool PlayMove(Board *board, int ply, const char *uci, int index, int promotionPieceID)
+{
+    Move moves[MAX_MOVES];
+    int count = GenerateLegalMoves(board, moves, board->sideToMove);
+    if (count == 0) return false;
+
+    Move move = moves[index % count];
+    if (uci != NULL)
+    {
+        int found = -1;
+        for (int i = 0; i < count; i++)
+        {
+            if (moves[i].startX == uci[0] - 'a' && moves[i].startY == '8' - uci[1]
+                && moves[i].endX == uci[2] - 'a' && moves[i].endY == '8' - uci[3]) found = i;
+        }
+        CHECK(found >= 0);
+        if (found < 0) return false;
+        move = moves[found];
+    }
+
+    ApplyMove(board, move, promotionPieceID);
+    board->sideToMove = 1 - board->sideToMove;
+    CHECK(History_Push(&history, move, promotionPieceID));
+    played[ply + 1] = *board;
+    return true;
+}
+
+static void CheckAllPositions(void)
+{
+    for (int ply = 0; ply <= history.count; ply++)
+    {
+        static Board rebuilt;
+        CHECK(History_Position(&history, ply, &rebuilt));
+        CHECK(SamePosition(&rebuilt, &played[ply]));
+    }
+    static Board beyond;
+    CHECK(!History_Position(&history, history.count + 1, &beyond));
+}
+
+// 1. e4 d5 2. e5 f5 3. exf6 e.p. Cc6 4. fxg7 Fe6 5. gxh8=C Dd7 6. Cf3 O-O-O 7. Fe2 a6 8. O-O
+static const char *OPENING[] = {
+    "e2e4", "d7d5", "e4e5", "f7f5", "e5f6", "b8c6", "f6g7", "c8e6",
+    "g7h8", "d8d7", "g1f3", "e8c8", "f1e2", "a7a6", "e1g1",
+};
+#define OPENING_PLIES (int)(sizeof(OPENING) / sizeof(OPENING[0]))
+
+static void TestReplayEveryPly(void)
+{
+    static Board board;
+    BoardReset(&board);
+    History_Init(&history, &board);
+    played[0] = board;
+
+    for (int ply = 0; ply < OPENING_PLIES; ply++)
+    {
+        int promotion = (ply == 8) ? 2 : 0; // gxh8 : Cavalier blanc
+        CHECK(PlayMove(&board, ply, OPENING[ply], 0, promotion));
+    }
+    CHECK(played[5].capturedByWhiteCount == 1);                     // exf6 en passant
+    CHECK(played[9].tiles[0][7].layers[played[9].tiles[0][7].layerCount - 1] == 2); // Cavalier en h8
+    CHECK(played[12].tiles[0][2].layers[played[12].tiles[0][2].layerCount - 1] == 11); // Roi noir en c8
+    CHECK(played[15].tiles[7][6].layers[played[15].tiles[7][6].layerCount - 1] == 10); // Roi blanc en g1
+
+    // Suite de la partie : coups légaux choisis de façon déterministe
+    int ply = OPENING_PLIES;
+    while (ply < TEST_PLIES && PlayMove(&board, ply, NULL, ply * 7 + 3, 0)) ply++;
+    CHECK(history.count > 2 * HISTORY_KEYFRAME_INTERVAL);
+    CheckAllPositions();
+}
+
+// Retour arrière au milieu de la deuxième copie, puis une autre suite : les copies suivantes
+// sont refaites depuis les nouveaux coups
+static void TestTruncateAndContinue(void)
+{
+    int keep = HISTORY_KEYFRAME_INTERVAL + 4;
+    History_Truncate(&history, keep);
+    CHECK(history.count == keep);
+    CheckAllPositions();
+
+    static Board board;
+    board = played[keep];
+    int ply = keep;
+    while (ply < TEST_PLIES && PlayMove(&board, ply, NULL, ply * 5 + 1, 0)) ply++;
+    CHECK(history.count > 2 * HISTORY_KEYFRAME_INTERVAL);
+    CheckAllPositions();
+}
+
+int main(void)
+{
+    TestReplayEveryPly();
+    TestTruncateAndContinue();
+    return CheckReport("history");
+}
@@ -0,0 +1,57 @@
+// Apprentissage : une position déjà cherchée aussi loin que le niveau de l'IA est rejouée sans
+// recherche quand l'interface la retrouve (limites de AILevel_Limits, budget de noeuds compris).
+#include "ailevel.h"
+#include "chesscore.h"
+#include "check.h"
+#include "learn.h"
+#include "searchstats.h"
+#include "tt.h"
+#include "zobrist.h"
+
+#define LEARN_TEST_PATH "build/test_learn.dat"
+
+static bool SameMove(Move a, Move b)
+{
+    return a.startX == b.startX && a.startY == b.startY && a.endX == b.endX && a.endY == b.endY;
+}
+
+static void TestLearnedRootWithLevelLimits(void)
+{
+    static Board board;
+    int side;
+    CHECK(BoardFromFEN(&board, "r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N2N2/PP2BPPP/R2QKB1R w KQ - 0 8", &side));
+
+    SearchLimits limits = AILevel_Limits(DIFF_MEDIUM, AILevel_Nodes(DIFF_MEDIUM, AI_REFERENCE_NPS), NULL);
+    CHECK(limits.depth > 0);
+
+    // Position inconnue : recherche normale
+    ChooseMoveWithLimits(&board, &limits);
+    CHECK(GetLastSearchStats()->source == SEARCH_SOURCE_SEARCH);
+
+    // Cherchée jusqu'à la profondeur du niveau (réflexion, analyse, partie précédente)
+    SearchLimits deep = { .depth = AILevel_Get(DIFF_MEDIUM)->depth, .threads = 1 };
+    Move expected = ChooseMoveWithLimits(&board, &deep);
+
+    Move move = ChooseMoveWithLimits(&board, &limits);
+    CHECK(GetLastSearchStats()->source == SEARCH_SOURCE_LEARN);
+    CHECK(GetLastSearchStats()->totalNodes == 0);
+    CHECK(SameMove(move, expected));
+}
+
+int main(void)
+{
+    Zobrist_Init();
+    TT_Init(16);
+    remove(LEARN_TEST_PATH);
+    if (!Learn_Open(LEARN_TEST_PATH, 1))
+    {
+        fprintf(stderr, "Impossible de créer %s\n", LEARN_TEST_PATH);
+        return 1;
+    }
+
+    TestLearnedRootWithLevelLimits();
+
+    Learn_Close();
+    remove(LEARN_TEST_PATH);
+    return CheckReport("learn");
+}
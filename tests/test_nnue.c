@@ -0,0 +1,142 @@
+// NNUE : l'accumulateur mis à jour coup par coup (MakeMove / UnmakeMove) reste égal à un recalcul
+// complet, et les poids de tools/nnuegen (évaluation matérielle) font jouer la recherche à l'identique.
+#include "chesscore.h"
+#include "check.h"
+#include "nnue.h"
+#include "searchstats.h"
+#include "tt.h"
+#include "zobrist.h"
+#include <string.h>
+
+#define NNUE_TEST_PATH "build/nnue_material.bin" // Écrit par make test (build/nnuegen)
+
+// Roques, prise en passant, promotions (avec et sans prise) possibles dès les premiers coups
+static const char *TEST_FENS[] = {
+    "r3k2r/pPp1pppp/8/3pP3/8/8/PPPP1PPP/R3K2R w KQkq d6 0 1",
+    "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+    "4k3/1P6/8/8/8/8/6p1/4K2R b K - 0 1",
+};
+
+static void BoardSquares(const Board *board, int squares[64])
+{
+    for (int sq = 0; sq < 64; sq++)
+    {
+        const Tile *t = &board->tiles[sq / 8][sq % 8];
+        squares[sq] = (t->layerCount > 1) ? t->layers[t->layerCount - 1] : 0;
+    }
+}
+
+// Perspectives invalidées (roi déplacé, promotion) recalculées comme dans la recherche, puis
+// comparaison avec un accumulateur recalculé depuis zéro
+static bool MatchesRefresh(Board *board)
+{
+    int squares[64];
+    BoardSquares(board, squares);
+    NNUE_Refresh(&board->nnue, squares);
+
+    NNUEAccumulator fresh;
+    memset(&fresh, 0, sizeof(fresh));
+    NNUE_Refresh(&fresh, squares);
+    return memcmp(board->nnue.values, fresh.values, sizeof(fresh.values)) == 0;
+}
+
+// Coups simulés en profondeur puis défaits : chaque noeud comparé à un recalcul
+static void WalkSimulated(Board *board, int depth, int *checked)
+{
+    if (depth == 0) return;
+
+    Move moves[MAX_MOVES];
+    int count = GenerateLegalMoves(board, moves, board->sideToMove);
+    for (int i = 0; i < count; i++)
+    {
+        NNUEAccumulator before = board->nnue;
+        SimulateMove(board, moves[i]);
+        board->sideToMove = 1 - board->sideToMove;
+        CHECK(MatchesRefresh(board));
+        (*checked)++;
+        WalkSimulated(board, depth - 1, checked);
+        board->sideToMove = 1 - board->sideToMove;
+        UndoSimulatedMove(board, moves[i]);
+
+        // Retour exact à l'accumulateur d'avant le coup (perspectives restées valides)
+        for (int p = 0; p < 2; p++)
+        {
+            if (before.computed[p] && board->nnue.computed[p])
+            {
+                CHECK(memcmp(before.values[p], board->nnue.values[p], sizeof(before.values[p])) == 0);
+            }
+        }
+        MatchesRefresh(board);
+    }
+}
+
+static void TestIncrementalMatchesRefresh(void)
+{
+    int checked = 0;
+    for (size_t i = 0; i < sizeof(TEST_FENS) / sizeof(TEST_FENS[0]); i++)
+    {
+        static Board board;
+        int side;
+        CHECK(BoardFromFEN(&board, TEST_FENS[i], &side));
+        CHECK(MatchesRefresh(&board));
+        WalkSimulated(&board, 3, &checked);
+    }
+    CHECK(checked > 1000);
+
+    // Coups réels (ApplyMove, promotions comprises) : même chose sur une partie entière
+    static Board board;
+    int side;
+    CHECK(BoardFromFEN(&board, TEST_FENS[0], &side));
+    CHECK(MatchesRefresh(&board));
+    for (int ply = 0; ply < 40; ply++)
+    {
+        Move moves[MAX_MOVES];
+        int count = GenerateLegalMoves(&board, moves, board.sideToMove);
+        if (count == 0) break;
+        ApplyMove(&board, moves[(ply * 7 + 3) % count], 0);
+        board.sideToMove = 1 - board.sideToMove;
+        CHECK(MatchesRefresh(&board));
+    }
+}
+
+// Les poids de nnuegen reproduisent l'évaluation matérielle : même score, même arbre
+static void TestMaterialWeightsSearch(void)
+{
+    for (size_t i = 0; i < sizeof(TEST_FENS) / sizeof(TEST_FENS[0]); i++)
+    {
+        static Board board;
+        int side;
+        CHECK(BoardFromFEN(&board, TEST_FENS[i], &side));
+
+        SearchLimits material = { .depth = 4, .threads = 1, .materialEval = true, .noBitbases = true };
+        SearchLimits network = material;
+        network.materialEval = false;
+
+        TT_Clear();
+        SearchPosition(&board, &material);
+        SearchStats expected = *GetLastSearchStats();
+        TT_Clear();
+        SearchPosition(&board, &network);
+        const SearchStats *stats = GetLastSearchStats();
+
+        CHECK(stats->score == expected.score);
+        CHECK(stats->totalNodes == expected.totalNodes);
+    }
+}
+
+int main(void)
+{
+    Zobrist_Init();
+    TT_Init(16);
+    if (!NNUE_Load(NNUE_TEST_PATH))
+    {
+        fprintf(stderr, "Poids absents : %s (build/nnuegen %s)\n", NNUE_TEST_PATH, NNUE_TEST_PATH);
+        return 1;
+    }
+
+    TestIncrementalMatchesRefresh();
+    TestMaterialWeightsSearch();
+
+    NNUE_Unload();
+    return CheckReport("nnue");
+}
@@ -0,0 +1,379 @@
+// Analyse d'un fichier de positions (libchesscore, sans fenêtre ni raylib) : meilleur coup,
+// score et variante principale de chaque position, recherches réparties sur tous les coeurs.
+// Usage : analyze <fichier|-> [--depth N] [--nodes N] [--movetime ms] [--concurrency K]
+//                 [--hash Mo] [--output fichier] [--nnue fichier] [--bitbases dossier]
+//
+// Entrée : une position FEN ou EPD par ligne ('#' = commentaire). Le fichier est lu au fur
+// et à mesure : seules quelques positions par thread sont en mémoire, quelle que soit sa taille.
+// Sortie : une ligne EPD par position, dans l'ordre du fichier :
+//   <position> bm Nf3; ce 25; acd 6; acn 41230; acs 0.052; pv Nf3 d5 d4; id "...";
+// ce est vu du camp au trait (centipions) ; un mat donne dm (coups) et ce = ±(32767 - demi-coups).
+
+#include "chesscore.h"
+#include "bitbase.h"
+#include "notation.h"
+#include "searchstats.h"
+#include "tt.h"
+#include "zobrist.h"
+#include "clock.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_WORKERS 256
+#define SLOTS_PER_WORKER 4        // Positions lues d'avance par thread
+#define LINE_SIZE 1024
+#define RESULT_SIZE 2048
+#define DEFAULT_DEPTH 6
+#define EPD_MATE_SCORE 32767
+#define PROGRESS_INTERVAL_NS 5000000000ull
+#define WORKER_STACK (8 * 1024 * 1024)
+
+typedef enum
+{
+    SLOT_EMPTY,   // Libre pour la lecture
+    SLOT_PENDING, // Position lue, en attente d'un thread
+    SLOT_DONE     // Résultat prêt, en attente d'écriture
+} SlotState;
+
+typedef struct
+{
+    SlotState state;
+    char line[LINE_SIZE];
+    char result[RESULT_SIZE];
+    long nodes;
+} Slot;
+
+// File circulaire : la position numéro n occupe la case n % slotCount.
+// Le lecteur (main) remplit readCount, les threads prennent nextJob, l'écriture suit writeCount.
+static Slot *gSlots = NULL;
+static long gSlotCount = 0;
+static long gReadCount = 0;
+static long gNextJob = 0;
+static long gWriteCount = 0;
+static bool gEndOfInput = false;
+static pthread_mutex_t gLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t gJobReady = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t gResultReady = PTHREAD_COND_INITIALIZER;
+
+static SearchLimits gLimits;
+static double gMoveTimeMs = 0.0;
+static int gHashMB = TT_DEFAULT_MB;
+
+static char *AppendText(char *out, char *end, const char *text)
+{
+    size_t room = (size_t)(end - out);
+    size_t n = strlen(text);
+    if (n >= room) n = room - 1;
+    memcpy(out, text, n);
+    out[n] = '\0';
+    return out + n;
+}
+
+// Position -> ligne EPD complète. Renvoie false (et un commentaire dans out) si la FEN est invalide.
+static bool AnalyzeLine(const char *line, Board *board, SearchControl *control, char out[RESULT_SIZE], long *nodes)
+{
+    char fields[6][96];
+    int n = sscanf(line, "%95s %95s %95s %95s %95s %95s", fields[0], fields[1], fields[2], fields[3], fields[4], fields[5]);
+    *nodes = 0;
+    if (n < 4)
+    {
+        snprintf(out, RESULT_SIZE, "# Position invalide : %.900s", line);
+        return false;
+    }
+
+    // Compteurs de la FEN facultatifs (EPD) : la recherche ne s'en sert pas
+    char fen[640];
+    snprintf(fen, sizeof(fen), "%s %s %s %s 0 1", fields[0], fields[1], fields[2], fields[3]);
+    int side = 0;
+    if (!BoardFromFEN(board, fen, &side))
+    {
+        snprintf(out, RESULT_SIZE, "# Position invalide : %.900s", line);
+        return false;
+    }
+
+    char *end = out + RESULT_SIZE;
+    char *p = out + snprintf(out, RESULT_SIZE, "%s %s %s %s", fields[0], fields[1], fields[2], fields[3]);
+
+    Move moves[MAX_MOVES];
+    if (GenerateLegalMoves(board, moves, side) == 0)
+    {
+        p = AppendText(p, end, IsKingInCheck(board, side) ? " c0 \"mat\";" : " c0 \"pat\";");
+    }
+    else
+    {
+        SearchControl_Reset(control);
+        if (gMoveTimeMs > 0.0) SearchControl_SetTime(control, gMoveTimeMs, gMoveTimeMs);
+        SearchLimits limits = gLimits;
+        limits.control = control;
+
+        TT_Clear();
+        uint64_t start = Clock_NowNs();
+        Move best = SearchPosition(board, &limits);
+        double seconds = (double)(Clock_NowNs() - start) * 1e-9;
+
+        const SearchStats *stats = GetLastSearchStats();
+        const SearchIteration *it = (stats->iterationCount > 0) ? &stats->iterations[stats->iterationCount - 1] : NULL;
+        int score = (side == 0) ? stats->score : -stats->score;
+        *nodes = stats->totalNodes;
+
+        char text[64];
+        MoveToSAN(board, best, 0, text);
+        p = AppendText(p, end, " bm ");
+        p = AppendText(p, end, text);
+        p = AppendText(p, end, ";");
+
+        // Mat : distance estimée par la longueur de la variante, comme le moteur UCI
+        if (score >= INFINITY || score <= -INFINITY)
+        {
+            int plies = (it != NULL && it->pvLength > 0) ? it->pvLength : 1;
+            int mateIn = (plies + 1) / 2;
+            snprintf(text, sizeof(text), " ce %d; dm %d;", (score > 0) ? EPD_MATE_SCORE - plies : -(EPD_MATE_SCORE - plies),
+                     (score > 0) ? mateIn : -mateIn);
+        }
+        else snprintf(text, sizeof(text), " ce %d;", score);
+        p = AppendText(p, end, text);
+
+        snprintf(text, sizeof(text), " acd %d; acn %ld; acs %.3f;", (it != NULL) ? it->depth : 0, stats->totalNodes, seconds);
+        p = AppendText(p, end, text);
+
+        // Variante principale rejouée sur une copie (notation algébrique de chaque coup)
+        if (it != NULL && it->pvLength > 0)
+        {
+            static _Thread_local Board played;
+            played = *board;
+            p = AppendText(p, end, " pv");
+            for (int i = 0; i < it->pvLength; i++)
+            {
+                Move move = it->pv[i];
+                MoveToSAN(&played, move, 0, text);
+                p = AppendText(p, end, " ");
+                p = AppendText(p, end, text);
+                ApplyMove(&played, move, 0);
+                played.sideToMove = 1 - played.sideToMove;
+            }
+            p = AppendText(p, end, ";");
+        }
+    }
+
+    // L'identifiant de la position (suites de tests EPD) est recopié tel quel
+    const char *id = strstr(line, " id ");
+    if (id != NULL)
+    {
+        const char *stop = strchr(id + 4, ';');
+        int length = (stop != NULL) ? (int)(stop - id) + 1 : (int)strcspn(id, "\r\n");
+        snprintf(p, (size_t)(end - p), "%.*s", length, id);
+    }
+    return true;
+}
+
+static void *Worker(void *arg)
+{
+    (void)arg;
+    TTable *table = TT_Create(gHashMB);
+    if (table == NULL)
+    {
+        fprintf(stderr, "Table de transposition : allocation impossible\n");
+        return NULL;
+    }
+    TT_Bind(table);
+    static _Thread_local Board board; // Trop gros pour la pile sous Windows
+    SearchControl control;
+
+    pthread_mutex_lock(&gLock);
+    for (;;)
+    {
+        while (gNextJob >= gReadCount && !gEndOfInput) pthread_cond_wait(&gJobReady, &gLock);
+        if (gNextJob >= gReadCount) break; // Fin du fichier, tout est distribué
+
+        Slot *slot = &gSlots[gNextJob % gSlotCount];
+        gNextJob++;
+        pthread_mutex_unlock(&gLock);
+
+        long nodes;
+        AnalyzeLine(slot->line, &board, &control, slot->result, &nodes);
+
+        pthread_mutex_lock(&gLock);
+        slot->nodes = nodes;
+        slot->state = SLOT_DONE;
+        pthread_cond_signal(&gResultReady);
+    }
+    pthread_mutex_unlock(&gLock);
+
+    TT_Bind(NULL);
+    TT_Destroy(table);
+    return NULL;
+}
+
+typedef struct
+{
+    FILE *out;
+    long positions;
+    long nodes;
+    uint64_t start;
+    uint64_t lastProgress;
+} Writer;
+
+// Écrit les résultats prêts dans l'ordre du fichier (appelé par main, verrou tenu)
+static void FlushResults(Writer *w)
+{
+    while (gWriteCount < gReadCount && gSlots[gWriteCount % gSlotCount].state == SLOT_DONE)
+    {
+        Slot *slot = &gSlots[gWriteCount % gSlotCount];
+        fprintf(w->out, "%s\n", slot->result);
+        w->positions++;
+        w->nodes += slot->nodes;
+        slot->state = SLOT_EMPTY;
+        gWriteCount++;
+    }
+
+    uint64_t now = Clock_NowNs();
+    if (now - w->lastProgress >= PROGRESS_INTERVAL_NS)
+    {
+        double seconds = (double)(now - w->start) * 1e-9;
+        fprintf(stderr, "%ld positions, %.1f positions/s, %.0f noeuds/s\n", w->positions, w->positions / seconds, w->nodes / seconds);
+        w->lastProgress = now;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const char *inputPath = NULL;
+    const char *outputPath = NULL;
+    const char *nnuePath = NULL;
+    const char *bitbaseDir = NULL;
+    int concurrency = Clock_CoreCount();
+    bool usage = false;
+
+    for (int i = 1; i < argc && !usage; i++)
+    {
+        bool hasValue = (i + 1 < argc);
+        if (strcmp(argv[i], "--depth") == 0 && hasValue) gLimits.depth = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--nodes") == 0 && hasValue) gLimits.nodes = atol(argv[++i]);
+        else if (strcmp(argv[i], "--movetime") == 0 && hasValue) gMoveTimeMs = atof(argv[++i]);
+        else if (strcmp(argv[i], "--concurrency") == 0 && hasValue) concurrency = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--hash") == 0 && hasValue) gHashMB = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--output") == 0 && hasValue) outputPath = argv[++i];
+        else if (strcmp(argv[i], "--nnue") == 0 && hasValue) nnuePath = argv[++i];
+        else if (strcmp(argv[i], "--bitbases") == 0 && hasValue) bitbaseDir = argv[++i];
+        else if (inputPath == NULL && (argv[i][0] != '-' || strcmp(argv[i], "-") == 0)) inputPath = argv[i];
+        else usage = true;
+    }
+    if (usage || inputPath == NULL)
+    {
+        fprintf(stderr, "Usage : analyze <fichier|-> [--depth N] [--nodes N] [--movetime ms] [--concurrency K]\n"
+                        "                [--hash Mo] [--output fichier] [--nnue fichier] [--bitbases dossier]\n");
+        return 1;
+    }
+    if (gLimits.depth <= 0 && gLimits.nodes <= 0 && gMoveTimeMs <= 0.0) gLimits.depth = DEFAULT_DEPTH;
+    gLimits.threads = 1; // Le parallélisme vient des positions : une recherche indépendante par thread
+    if (gHashMB <= 0) gHashMB = TT_DEFAULT_MB;
+    if (concurrency < 1) concurrency = 1;
+    if (concurrency > MAX_WORKERS) concurrency = MAX_WORKERS;
+
+    FILE *in = (strcmp(inputPath, "-") == 0) ? stdin : fopen(inputPath, "r");
+    if (in == NULL)
+    {
+        fprintf(stderr, "Impossible d'ouvrir %s\n", inputPath);
+        return 1;
+    }
+    Writer writer = { 0 };
+    writer.out = (outputPath != NULL) ? fopen(outputPath, "w") : stdout;
+    if (writer.out == NULL)
+    {
+        fprintf(stderr, "Impossible d'ouvrir %s\n", outputPath);
+        return 1;
+    }
+
+    gSlotCount = (long)concurrency * SLOTS_PER_WORKER;
+    gSlots = calloc((size_t)gSlotCount, sizeof(Slot));
+    if (gSlots == NULL)
+    {
+        fprintf(stderr, "Mémoire insuffisante\n");
+        return 1;
+    }
+
+    Zobrist_Init();
+    if (nnuePath != NULL && !NNUE_Load(nnuePath)) fprintf(stderr, "NNUE : impossible de charger %s\n", nnuePath);
+    if (bitbaseDir != NULL) Bitbase_Load(bitbaseDir);
+
+    writer.start = Clock_NowNs();
+    writer.lastProgress = writer.start;
+
+    pthread_t workers[MAX_WORKERS];
+    int started = 0;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, WORKER_STACK);
+    for (int i = 0; i < concurrency; i++)
+    {
+        if (pthread_create(&workers[started], &attr, Worker, NULL) == 0) started++;
+    }
+    pthread_attr_destroy(&attr);
+    if (started == 0)
+    {
+        fprintf(stderr, "Impossible de démarrer les threads d'analyse\n");
+        return 1;
+    }
+
+    // Lecture au fil de l'eau : une case se libère quand son résultat est écrit
+    char line[LINE_SIZE];
+    long skipped = 0;
+    while (fgets(line, sizeof(line), in) != NULL)
+    {
+        size_t length = strlen(line);
+        if (length == sizeof(line) - 1 && line[length - 1] != '\n')
+        {
+            // Ligne trop longue : le reste est ignoré
+            int c;
+            while ((c = fgetc(in)) != EOF && c != '\n') { }
+        }
+        line[strcspn(line, "\r\n")] = '\0';
+        const char *text = line + strspn(line, " \t");
+        if (*text == '\0' || *text == '#')
+        {
+            skipped++;
+            continue;
+        }
+
+        pthread_mutex_lock(&gLock);
+        Slot *slot = &gSlots[gReadCount % gSlotCount];
+        for (;;)
+        {
+            FlushResults(&writer);
+            if (slot->state == SLOT_EMPTY) break;
+            pthread_cond_wait(&gResultReady, &gLock);
+        }
+        snprintf(slot->line, sizeof(slot->line), "%s", text);
+        slot->state = SLOT_PENDING;
+        gReadCount++;
+        pthread_cond_signal(&gJobReady);
+        pthread_mutex_unlock(&gLock);
+    }
+
+    pthread_mutex_lock(&gLock);
+    gEndOfInput = true;
+    pthread_cond_broadcast(&gJobReady);
+    for (;;)
+    {
+        FlushResults(&writer);
+        if (gWriteCount >= gReadCount) break;
+        pthread_cond_wait(&gResultReady, &gLock);
+    }
+    pthread_mutex_unlock(&gLock);
+    for (int i = 0; i < started; i++) pthread_join(workers[i], NULL);
+
+    double seconds = (double)(Clock_NowNs() - writer.start) * 1e-9;
+    fprintf(stderr, "%ld positions analysées en %.2f s (%d threads) : %.1f positions/s, %ld noeuds, %.0f noeuds/s\n",
+            writer.positions, seconds, started, (seconds > 0.0) ? writer.positions / seconds : 0.0, writer.nodes,
+            (seconds > 0.0) ? writer.nodes / seconds : 0.0);
+    if (skipped > 0) fprintf(stderr, "%ld lignes vides ou commentaires ignorées\n", skipped);
+
+    if (in != stdin) fclose(in);
+    if (writer.out != stdout) fclose(writer.out);
+    free(gSlots);
+    Bitbase_Unload();
+    NNUE_Unload();
+    return 0;
+}
@@ -0,0 +1,283 @@
+// Générateur des bitbases KPK / KRK / KQK par analyse rétrograde.
+// Usage : bbgen [dossier]   (écrit kpk.bb, krk.bb et kqk.bb, "assets" par défaut)
+//
+// Convention du jeu : case = y * 8 + x, y = 0 est la rangée du haut (côté Noir).
+// Le camp fort est "Blanc" : son pion monte (y décroissant) et se promeut en y = 0.
+
+#include "bitbase.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// États d'une position pendant l'analyse
+#define ST_UNKNOWN 0
+#define ST_INVALID 1
+#define ST_DRAW 2
+#define ST_WIN 3
+
+#define PAWN_ID 6
+#define ROOK_ID 12
+#define QUEEN_ID 8
+
+static int SqX(int sq) { return sq % 8; }
+static int SqY(int sq) { return sq / 8; }
+
+static int Distance(int a, int b)
+{
+    int dx = abs(SqX(a) - SqX(b));
+    int dy = abs(SqY(a) - SqY(b));
+    return (dx > dy) ? dx : dy;
+}
+
+static const int KING_DX[8] = { -1, 0, 1, -1, 1, -1, 0, 1 };
+static const int KING_DY[8] = { -1, -1, -1, 0, 0, 1, 1, 1 };
+
+// Directions : 0..3 orthogonales (Tour), 4..7 diagonales (Fou)
+static const int DIR_DX[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+static const int DIR_DY[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+// La pièce blanche en 'pieceSq' attaque-t-elle 'target' ? ('blocker' = seul obstacle possible)
+static int PieceAttacks(int pieceID, int pieceSq, int target, int blocker)
+{
+    if (pieceSq == target) return 0;
+
+    int px = SqX(pieceSq), py = SqY(pieceSq);
+    int tx = SqX(target), ty = SqY(target);
+
+    if (pieceID == PAWN_ID)
+    {
+        return (ty == py - 1) && abs(tx - px) == 1;
+    }
+
+    int firstDir = 0;
+    int lastDir = (pieceID == ROOK_ID) ? 4 : 8;
+    for (int d = firstDir; d < lastDir; d++)
+    {
+        int x = px + DIR_DX[d];
+        int y = py + DIR_DY[d];
+        while (x >= 0 && x < 8 && y >= 0 && y < 8)
+        {
+            int sq = y * 8 + x;
+            if (sq == target) return 1;
+            if (sq == blocker) break;
+            x += DIR_DX[d];
+            y += DIR_DY[d];
+        }
+    }
+    return 0;
+}
+
+// La case est-elle contrôlée par les Blancs ? (le roi noir ne bloque pas : rayons X)
+static int WhiteAttacks(int pieceID, int wk, int pieceSq, int target)
+{
+    if (Distance(wk, target) <= 1) return 1;
+    return PieceAttacks(pieceID, pieceSq, target, wk);
+}
+
+static int IsValid(int pieceID, int stm, int wk, int bk, int pieceSq)
+{
+    if (wk == bk || wk == pieceSq || bk == pieceSq) return 0;
+    if (Distance(wk, bk) <= 1) return 0;
+    // Pion en y = 0 : déjà promu, Bitbase_Probe lit alors KQK (entrées de KPK jamais consultées)
+    if (pieceID == PAWN_ID && (SqY(pieceSq) == 0 || SqY(pieceSq) == 7)) return 0;
+    // Blancs au trait alors que le roi noir est en échec : impossible
+    if (stm == 0 && WhiteAttacks(pieceID, wk, pieceSq, bk)) return 0;
+    return 1;
+}
+
+// Classe une position à partir de l'état de ses successeurs
+static int Classify(const uint8_t *status, const uint8_t *queenTable, int pieceID, int stm, int wk, int bk, int pieceSq)
+{
+    int hasUnknown = 0;
+
+    if (stm == 0) // Blancs : gagnant si UN coup mène à un gain
+    {
+        // Coups du roi blanc
+        for (int k = 0; k < 8; k++)
+        {
+            int x = SqX(wk) + KING_DX[k];
+            int y = SqY(wk) + KING_DY[k];
+            if (x < 0 || x >= 8 || y < 0 || y >= 8) continue;
+            int to = y * 8 + x;
+            if (to == pieceSq || Distance(to, bk) <= 1) continue;
+
+            int s = status[BITBASE_INDEX(1, to, bk, pieceSq)];
+            if (s == ST_WIN) return ST_WIN;
+            if (s == ST_UNKNOWN) hasUnknown = 1;
+        }
+
+        // Coups de la pièce
+        if (pieceID == PAWN_ID)
+        {
+            int px = SqX(pieceSq), py = SqY(pieceSq);
+            int steps = (py == 6) ? 2 : 1;
+            for (int n = 1; n <= steps; n++)
+            {
+                int to = (py - n) * 8 + px;
+                if (to == wk || to == bk) break;
+
+                int s;
+                if (py - n == 0) s = queenTable[BITBASE_INDEX(1, wk, bk, to)]; // Promotion en Dame (comme l'IA)
+                else s = status[BITBASE_INDEX(1, wk, bk, to)];
+
+                if (s == ST_WIN) return ST_WIN;
+                if (s == ST_UNKNOWN) hasUnknown = 1;
+            }
+        }
+        else
+        {
+            int lastDir = (pieceID == ROOK_ID) ? 4 : 8;
+            for (int d = 0; d < lastDir; d++)
+            {
+                int x = SqX(pieceSq) + DIR_DX[d];
+                int y = SqY(pieceSq) + DIR_DY[d];
+                while (x >= 0 && x < 8 && y >= 0 && y < 8)
+                {
+                    int to = y * 8 + x;
+                    if (to == wk || to == bk) break;
+
+                    int s = status[BITBASE_INDEX(1, wk, bk, to)];
+                    if (s == ST_WIN) return ST_WIN;
+                    if (s == ST_UNKNOWN) hasUnknown = 1;
+                    x += DIR_DX[d];
+                    y += DIR_DY[d];
+                }
+            }
+        }
+        return hasUnknown ? ST_UNKNOWN : ST_DRAW;
+    }
+
+    // Noirs : nul si UN coup mène à un nul, gagnant (pour les Blancs) si tous perdent
+    int moveCount = 0;
+    for (int k = 0; k < 8; k++)
+    {
+        int x = SqX(bk) + KING_DX[k];
+        int y = SqY(bk) + KING_DY[k];
+        if (x < 0 || x >= 8 || y < 0 || y >= 8) continue;
+        int to = y * 8 + x;
+        if (to == wk || Distance(to, wk) <= 1) continue;
+
+        if (to == pieceSq)
+        {
+            // Capture de la pièce (non défendue par le roi blanc) : Roi contre Roi
+            return ST_DRAW;
+        }
+        if (PieceAttacks(pieceID, pieceSq, to, wk)) continue;
+
+        moveCount++;
+        int s = status[BITBASE_INDEX(0, wk, to, pieceSq)];
+        if (s == ST_DRAW) return ST_DRAW;
+        if (s == ST_UNKNOWN) hasUnknown = 1;
+    }
+
+    if (moveCount == 0)
+    {
+        // Mat ou pat
+        return WhiteAttacks(pieceID, wk, pieceSq, bk) ? ST_WIN : ST_DRAW;
+    }
+    return hasUnknown ? ST_UNKNOWN : ST_WIN;
+}
+
+// Itère jusqu'au point fixe ; les positions encore indécises sont nulles
+static void Generate(uint8_t *status, const uint8_t *queenTable, int pieceID)
+{
+    for (int stm = 0; stm < 2; stm++)
+        for (int wk = 0; wk < 64; wk++)
+            for (int bk = 0; bk < 64; bk++)
+                for (int p = 0; p < 64; p++)
+                {
+                    status[BITBASE_INDEX(stm, wk, bk, p)] = IsValid(pieceID, stm, wk, bk, p) ? ST_UNKNOWN : ST_INVALID;
+                }
+
+    int iteration = 0;
+    int changed = 1;
+    while (changed)
+    {
+        changed = 0;
+        iteration++;
+        for (int stm = 0; stm < 2; stm++)
+            for (int wk = 0; wk < 64; wk++)
+                for (int bk = 0; bk < 64; bk++)
+                    for (int p = 0; p < 64; p++)
+                    {
+                        uint8_t *s = &status[BITBASE_INDEX(stm, wk, bk, p)];
+                        if (*s != ST_UNKNOWN) continue;
+
+                        int result = Classify(status, queenTable, pieceID, stm, wk, bk, p);
+                        if (result != ST_UNKNOWN)
+                        {
+                            *s = (uint8_t)result;
+                            changed = 1;
+                        }
+                    }
+    }
+
+    for (int i = 0; i < BITBASE_POSITIONS; i++)
+    {
+        if (status[i] == ST_UNKNOWN) status[i] = ST_DRAW;
+    }
+    printf("  %d iterations\n", iteration);
+}
+
+static int Write(const char *directory, const char *fileName, int pieceID, const uint8_t *status)
+{
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", directory, fileName);
+
+    static uint8_t bits[BITBASE_POSITIONS / 8];
+    memset(bits, 0, sizeof(bits));
+
+    int wins = 0;
+    for (int i = 0; i < BITBASE_POSITIONS; i++)
+    {
+        if (status[i] == ST_WIN)
+        {
+            bits[i >> 3] |= (uint8_t)(1u << (i & 7));
+            wins++;
+        }
+    }
+
+    BitbaseHeader header;
+    memcpy(header.magic, BITBASE_MAGIC, 4);
+    header.version = BITBASE_VERSION;
+    header.pieceID = (uint32_t)pieceID;
+    header.positions = BITBASE_POSITIONS;
+
+    FILE *f = fopen(path, "wb");
+    if (f == NULL)
+    {
+        fprintf(stderr, "Impossible d'écrire %s\n", path);
+        return 0;
+    }
+    int ok = fwrite(&header, sizeof(header), 1, f) == 1 && fwrite(bits, sizeof(bits), 1, f) == 1;
+    fclose(f);
+
+    printf("  %s : %d positions gagnantes\n", path, wins);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    const char *directory = (argc > 1) ? argv[1] : "assets";
+
+    uint8_t *kqk = malloc(BITBASE_POSITIONS);
+    uint8_t *work = malloc(BITBASE_POSITIONS);
+    if (kqk == NULL || work == NULL) return 1;
+
+    // KQK d'abord : KPK s'y réfère pour les promotions
+    printf("KQK\n");
+    Generate(kqk, NULL, QUEEN_ID);
+    int ok = Write(directory, "kqk.bb", QUEEN_ID, kqk);
+
+    printf("KRK\n");
+    Generate(work, NULL, ROOK_ID);
+    ok = Write(directory, "krk.bb", ROOK_ID, work) && ok;
+
+    printf("KPK\n");
+    Generate(work, kqk, PAWN_ID);
+    ok = Write(directory, "kpk.bb", PAWN_ID, work) && ok;
+
+    free(work);
+    free(kqk);
+    return ok ? 0 : 1;
+}
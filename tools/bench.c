@@ -0,0 +1,82 @@
+// Banc d'essai de la recherche sur des positions fixes (libchesscore, sans fenêtre ni raylib).
+// Usage : bench [profondeur] [--nnue fichier] [--bitbases dossier]
+//
+// Chaque position part d'une table de transposition vide : les résultats sont reproductibles
+// et comparables d'une version du moteur à l'autre (noeuds identiques = même arbre).
+
+#include "chesscore.h"
+#include "bitbase.h"
+#include "searchstats.h"
+#include "tt.h"
+#include "zobrist.h"
+#include "clock.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *BENCH_FENS[] = {
+    START_FEN,
+    "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3",
+    "r1bqk2r/pppp1ppp/2n2n2/2b1p3/2B1P3/3P1N2/PPP2PPP/RNBQK2R w KQkq - 1 5",
+    "r2q1rk1/ppp2ppp/2np1n2/2b1p1B1/2B1P1b1/2NP1N2/PPP2PPP/R2Q1RK1 w - - 4 8",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1",
+};
+
+int main(int argc, char **argv)
+{
+    int depth = 4;
+    const char *nnuePath = NULL;
+    const char *bitbaseDir = NULL;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--nnue") == 0 && i + 1 < argc) nnuePath = argv[++i];
+        else if (strcmp(argv[i], "--bitbases") == 0 && i + 1 < argc) bitbaseDir = argv[++i];
+        else depth = atoi(argv[i]);
+    }
+    if (depth < 1) depth = 1;
+
+    Zobrist_Init();
+    if (!TT_Init(TT_DEFAULT_MB))
+    {
+        fprintf(stderr, "Table de transposition : allocation impossible\n");
+        return 1;
+    }
+    if (nnuePath != NULL && !NNUE_Load(nnuePath)) fprintf(stderr, "NNUE : impossible de charger %s\n", nnuePath);
+    if (bitbaseDir != NULL) Bitbase_Load(bitbaseDir);
+
+    static Board board; // Trop gros pour la pile sous Windows
+    long totalNodes = 0;
+    double totalMs = 0.0;
+    int positionCount = (int)(sizeof(BENCH_FENS) / sizeof(BENCH_FENS[0]));
+
+    printf("Profondeur %d, %d positions\n", depth, positionCount);
+    for (int i = 0; i < positionCount; i++)
+    {
+        if (!BoardFromFEN(&board, BENCH_FENS[i], NULL))
+        {
+            fprintf(stderr, "FEN invalide : %s\n", BENCH_FENS[i]);
+            continue;
+        }
+        TT_Clear();
+
+        uint64_t start = Clock_NowNs();
+        Move best = FindBestMove(&board, depth);
+        double ms = (double)(Clock_NowNs() - start) * 1e-6;
+
+        const SearchStats *stats = GetLastSearchStats();
+        char text[6];
+        MoveToString(best, text);
+        printf("%2d  %-5s  score %6d  %10ld noeuds  %9.1f ms  %8.0f noeuds/s\n",
+               i + 1, text, stats->score, stats->totalNodes, ms, (ms > 0.0) ? stats->totalNodes * 1000.0 / ms : 0.0);
+        totalNodes += stats->totalNodes;
+        totalMs += ms;
+    }
+
+    printf("Total : %ld noeuds, %.1f ms, %.0f noeuds/s\n", totalNodes, totalMs, (totalMs > 0.0) ? totalNodes * 1000.0 / totalMs : 0.0);
+
+    Bitbase_Unload();
+    NNUE_Unload();
+    TT_Free();
+    return 0;
+}
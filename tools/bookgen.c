@@ -0,0 +1,42 @@
+// Construction du livre d'ouverture depuis des parties PGN (libchesscore, sans fenêtre).
+// Usage : bookgen <sortie.bin> [--depth N] [--min-weight W] [--uniform] <fichiers.pgn...>
+
+#include "bookbuild.h"
+#include "zobrist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage : bookgen <sortie.bin> [--depth N] [--min-weight W] [--uniform] <fichiers.pgn...>\n");
+        return 1;
+    }
+    Zobrist_Init();
+
+    BookBuildOptions options = { 24, 1, false };
+    const char *outPath = argv[1];
+    const char **files = malloc(sizeof(char *) * (size_t)argc);
+    int fileCount = 0;
+
+    for (int i = 2; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--depth") == 0 && i + 1 < argc) options.maxPlies = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--min-weight") == 0 && i + 1 < argc) options.minWeight = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--uniform") == 0) options.uniform = true;
+        else files[fileCount++] = argv[i];
+    }
+
+    if (fileCount == 0)
+    {
+        fprintf(stderr, "Aucun fichier PGN donné\n");
+        free(files);
+        return 1;
+    }
+
+    long written = BuildBookFromPGN(outPath, files, fileCount, &options);
+    free(files);
+    return (written < 0) ? 1 : 0;
+}
@@ -0,0 +1,51 @@
+// Solveur de mat en ligne de commande (libchesscore, sans fenêtre).
+// Usage : mate "<FEN>" [distance] [noeuds]
+
+#include "chesscore.h"
+#include "matesearch.h"
+#include "zobrist.h"
+#include "clock.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage : mate \"<FEN>\" [distance] [noeuds]\n");
+        return 1;
+    }
+    Zobrist_Init();
+
+    static Board board; // Trop gros pour la pile sous Windows
+    int side = 0;
+    if (!BoardFromFEN(&board, argv[1], &side))
+    {
+        fprintf(stderr, "FEN invalide : %s\n", argv[1]);
+        return 1;
+    }
+
+    int distance = (argc > 2) ? atoi(argv[2]) : 5;
+    long maxNodes = (argc > 3) ? atol(argv[3]) : 1000000;
+
+    uint64_t start = Clock_NowNs();
+    MateResult result;
+    bool found = MateSearch(&board, side, distance, maxNodes, &result);
+    double ms = (double)(Clock_NowNs() - start) * 1e-6;
+
+    if (!found)
+    {
+        printf("Pas de mat en %d trouvé (%ld noeuds, %.1f ms)\n", distance, result.nodes, ms);
+        return 2;
+    }
+
+    printf("Mat en %d (%ld noeuds, %.1f ms) :", result.mateIn, result.nodes, ms);
+    for (int i = 0; i < result.lineLength; i++)
+    {
+        char text[6];
+        MoveToString(result.line[i], text);
+        printf(" %s", text);
+    }
+    printf("\n");
+    return 0;
+}
@@ -0,0 +1,140 @@
+// Générateur de poids NNUE de départ : un réseau construit à la main qui reproduit exactement
+// l'évaluation matérielle du moteur (EvalutatePosition : matériel + pions centraux).
+// Usage : nnuegen [fichier]   ("assets/nnue.bin" par défaut)
+//
+// Il sert de point de départ à un entraînement et à vérifier tout le chemin NNUE (chargement,
+// accumulateur incrémental, propagation) : avec ces poids, la recherche doit jouer comme sans réseau.
+//
+// Construction (perspective p, "propre" = pièces du camp p) :
+//  - accumulateur : un canal par type de pièce et par camp, nombre de pièces x CHANNEL_SCALE ;
+//    deux canaux de plus pour les pions centraux (colonnes d et e)
+//  - couche 1 : un neurone par canal, 64 + CHANNEL_SCALE x (propres - adverses) (biais de 64 : reste positif)
+//  - couche 2 : copies de ces neurones, assez pour que la sortie garde des poids int8
+//  - sortie : somme des copies pondérées, biais retirant les 64, soit le score en centipions
+// Exact tant que les écarts restent dans la plage des neurones : 7 pions, 3 pièces d'un même type.
+
+#include "nnue.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHANNELS 6 // Pion, Cavalier, Fou, Tour, Reine, pions centraux
+#define CENTRAL_CHANNEL 5
+#define NEURON_BIAS 64
+
+// Mêmes valeurs que EvalutatePosition (src/search.c)
+static const int CHANNEL_VALUE[CHANNELS] = { 100, 320, 330, 500, 900, 5 };
+static const int CHANNEL_SCALE[CHANNELS] = { 8, 16, 16, 16, 16, 8 }; // x nombre de pièces, jusqu'à 127
+
+static int16_t ftBias[NNUE_HALF_DIMS];
+static int32_t l1Bias[NNUE_L1];
+static int8_t l1Weights[NNUE_L1][2 * NNUE_HALF_DIMS];
+static int32_t l2Bias[NNUE_L2];
+static int8_t l2Weights[NNUE_L2][NNUE_L1];
+static int32_t outBias;
+static int8_t outWeights[NNUE_L2];
+
+// Ligne de la première couche pour une pièce (type 0..4, propre ou adverse) sur une case orientée
+static void FeatureRow(int16_t row[NNUE_HALF_DIMS], int pieceIndex, int square)
+{
+    memset(row, 0, sizeof(int16_t) * NNUE_HALF_DIMS);
+    int type = pieceIndex % 5;
+    int enemy = pieceIndex / 5;
+
+    row[type + 5 * enemy] = (int16_t)CHANNEL_SCALE[type];
+
+    int x = square % 8;
+    if (type == 0 && (x == 3 || x == 4)) row[10 + enemy] = (int16_t)CHANNEL_SCALE[CENTRAL_CHANNEL];
+}
+
+// Couches 1, 2 et sortie ; renvoie false si les copies ne tiennent pas dans la couche 2
+static int BuildLayers(void)
+{
+    memset(ftBias, 0, sizeof(ftBias));
+    memset(l1Bias, 0, sizeof(l1Bias));
+    memset(l1Weights, 0, sizeof(l1Weights));
+    memset(l2Bias, 0, sizeof(l2Bias));
+    memset(l2Weights, 0, sizeof(l2Weights));
+    memset(outWeights, 0, sizeof(outWeights));
+
+    // Couche 1 : seule la perspective du camp au trait (première moitié des entrées) est lue
+    for (int c = 0; c < CHANNELS; c++)
+    {
+        int own = (c == CENTRAL_CHANNEL) ? 10 : c;
+        int enemy = (c == CENTRAL_CHANNEL) ? 11 : c + 5;
+        l1Bias[c] = NEURON_BIAS << 6; // Décalage de 6 bits appliqué par NNUE_Evaluate
+        l1Weights[c][own] = 64;
+        l1Weights[c][enemy] = -64;
+    }
+
+    // Couche 2 et sortie : poids total 16 x valeur / échelle (sortie divisée par 16), réparti sur des copies
+    int copy = 0;
+    long totalWeight = 0;
+    for (int c = 0; c < CHANNELS; c++)
+    {
+        int weight = 16 * CHANNEL_VALUE[c] / CHANNEL_SCALE[c];
+        int copies = (weight + 126) / 127;
+        for (int k = 0; k < copies; k++)
+        {
+            if (copy >= NNUE_L2) return 0;
+            l2Weights[copy][c] = 64; // Recopie exacte
+            outWeights[copy] = (int8_t)(weight / copies + (k < weight % copies ? 1 : 0));
+            copy++;
+        }
+        totalWeight += weight;
+    }
+    outBias = (int32_t)(-NEURON_BIAS * totalWeight);
+    printf("  %d neurones de sortie utilisés sur %d\n", copy, NNUE_L2);
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = (argc > 1) ? argv[1] : "assets/nnue.bin";
+
+    if (!BuildLayers())
+    {
+        fprintf(stderr, "Couche 2 trop petite pour les copies\n");
+        return 1;
+    }
+
+    FILE *f = fopen(path, "wb");
+    if (f == NULL)
+    {
+        fprintf(stderr, "Impossible d'écrire %s\n", path);
+        return 1;
+    }
+
+    uint32_t version = NNUE_VERSION;
+    uint32_t halfDims = NNUE_HALF_DIMS;
+    int ok = fwrite(NNUE_MAGIC, 1, 8, f) == 8
+          && fwrite(&version, sizeof(version), 1, f) == 1
+          && fwrite(&halfDims, sizeof(halfDims), 1, f) == 1
+          && fwrite(ftBias, sizeof(ftBias), 1, f) == 1;
+
+    // Même ligne quelle que soit la case du roi : l'évaluation matérielle ne dépend pas du roi
+    int16_t row[NNUE_HALF_DIMS];
+    for (int king = 0; king < NNUE_KING_SQUARES && ok; king++)
+        for (int piece = 0; piece < NNUE_PIECE_TYPES && ok; piece++)
+            for (int sq = 0; sq < 64 && ok; sq++)
+            {
+                FeatureRow(row, piece, sq);
+                ok = fwrite(row, sizeof(row), 1, f) == 1;
+            }
+
+    ok = ok && fwrite(l1Bias, sizeof(l1Bias), 1, f) == 1
+            && fwrite(l1Weights, sizeof(l1Weights), 1, f) == 1
+            && fwrite(l2Bias, sizeof(l2Bias), 1, f) == 1
+            && fwrite(l2Weights, sizeof(l2Weights), 1, f) == 1
+            && fwrite(&outBias, sizeof(outBias), 1, f) == 1
+            && fwrite(outWeights, sizeof(outWeights), 1, f) == 1;
+    fclose(f);
+
+    if (!ok)
+    {
+        fprintf(stderr, "Erreur d'écriture de %s\n", path);
+        return 1;
+    }
+    printf("  %s : réseau matériel écrit\n", path);
+    return 0;
+}
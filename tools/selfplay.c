@@ -0,0 +1,637 @@
+// Tournoi automatique entre deux réglages du moteur (libchesscore, sans fenêtre ni raylib),
+// parties jouées en parallèle sur tous les coeurs.
+// Usage : selfplay --a <réglage> --b <réglage> [--games N] [--concurrency K] [--openings fichier]
+//                  [--sprt elo0,elo1[,alpha,beta]] [--pgn fichier] [--max-plies N]
+//                  [--nnue fichier] [--bitbases dossier]
+//
+// Réglage : liste "clé=valeur" séparée par des virgules, par exemple "depth=4,eval=material" :
+//   name=texte, depth=N, nodes=N, movetime=ms, tc=secondes+incrément (ex. 10+0.1),
+//   threads=N, hash=Mo, eval=nnue|material, bitbases=on|off
+//
+// Chaque ouverture est jouée deux fois, couleurs inversées. Résultats et Elo du point de vue de A.
+
+#include "chesscore.h"
+#include "bitbase.h"
+#include "notation.h"
+#include "searchstats.h"
+#include "tt.h"
+#include "zobrist.h"
+#include "clock.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_OPENINGS 4096
+#define MAX_WORKERS 256
+#define DEFAULT_MAX_PLIES 400   // Partie déclarée nulle au-delà
+#define DEFAULT_DEPTH 4         // Réglage sans profondeur, noeuds ni temps
+#define WORKER_STACK (8 * 1024 * 1024)
+
+typedef struct
+{
+    char name[32];
+    int depth;
+    long nodes;
+    double moveTimeMs;
+    double baseMs;      // Pendule (tc=), 0 = aucune
+    double incMs;
+    int threads;
+    int hashMB;
+    bool materialEval;
+    bool noBitbases;
+} EngineConfig;
+
+typedef enum
+{
+    RESULT_WHITE_WINS,
+    RESULT_BLACK_WINS,
+    RESULT_DRAW
+} GameResult;
+
+typedef struct
+{
+    long nodes;
+    double ms;
+    long moves;
+    long timeLosses;
+} EngineTotals;
+
+// Ouvertures par défaut : position initiale et premiers coups courants
+static const char *DEFAULT_OPENINGS[] = {
+    START_FEN,
+    "rnbqkbnr/pppp1ppp/8/4p3/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 2",
+    "rnbqkbnr/pp1ppppp/8/2p5/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 2",
+    "rnbqkbnr/pppp1ppp/4p3/8/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 2",
+    "rnbqkbnr/pp1ppppp/2p5/8/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 2",
+    "rnbqkbnr/ppp1pppp/8/3p4/3P4/8/PPP1PPPP/RNBQKBNR w KQkq - 0 2",
+    "rnbqkb1r/pppppppp/5n2/8/3P4/8/PPP1PPPP/RNBQKBNR w KQkq - 1 2",
+    "rnbqkbnr/pppppppp/8/8/2P5/8/PP1PPPPP/RNBQKBNR b KQkq - 0 1",
+    "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3",
+};
+
+static EngineConfig gEngines[2]; // [0] = A, [1] = B
+static char *gOpenings[MAX_OPENINGS];
+static int gOpeningCount = 0;
+static int gGameCount = 100;
+static int gMaxPlies = DEFAULT_MAX_PLIES;
+
+static atomic_int gNextGame;
+static atomic_bool gStop;          // Décision SPRT : plus de nouvelles parties
+
+static bool gSprt = false;
+static double gElo0 = 0.0, gElo1 = 5.0, gAlpha = 0.05, gBeta = 0.05;
+
+// Résultats partagés (sous gLock)
+static pthread_mutex_t gLock = PTHREAD_MUTEX_INITIALIZER;
+static long gWins = 0, gDraws = 0, gLosses = 0; // Pour A
+static EngineTotals gTotals[2];
+static int gFinished = 0;
+static FILE *gPgn = NULL;
+
+// ---------------------------------------------------------------------------------------------
+// Statistiques : Elo (intervalle à 95 %) et SPRT (approximation normale du rapport de vraisemblance)
+
+static double EloFromScore(double score)
+{
+    if (score < 1e-6) score = 1e-6;
+    if (score > 1.0 - 1e-6) score = 1.0 - 1e-6;
+    return -400.0 * log10(1.0 / score - 1.0);
+}
+
+static double ScoreFromElo(double elo)
+{
+    return 1.0 / (1.0 + pow(10.0, -elo / 400.0));
+}
+
+// Score moyen et variance d'une partie (victoire 1, nulle 1/2, défaite 0)
+static bool ScoreStats(long w, long d, long l, double *score, double *variance)
+{
+    long n = w + d + l;
+    if (n == 0) return false;
+    double s = (w + 0.5 * d) / n;
+    *score = s;
+    *variance = (w * (1.0 - s) * (1.0 - s) + d * (0.5 - s) * (0.5 - s) + l * s * s) / n;
+    return true;
+}
+
+static void EloEstimate(long w, long d, long l, double *elo, double *margin)
+{
+    double s, var;
+    *elo = 0.0;
+    *margin = 0.0;
+    if (!ScoreStats(w, d, l, &s, &var)) return;
+    double sd = sqrt(var / (w + d + l));
+    *elo = EloFromScore(s);
+    *margin = (EloFromScore(s + 1.96 * sd) - EloFromScore(s - 1.96 * sd)) / 2.0;
+}
+
+static double SprtLLR(long w, long d, long l)
+{
+    double s, var;
+    if (!ScoreStats(w, d, l, &s, &var) || var <= 0.0) return 0.0;
+    double s0 = ScoreFromElo(gElo0);
+    double s1 = ScoreFromElo(gElo1);
+    return (w + d + l) * (s1 - s0) * (2.0 * s - s0 - s1) / (2.0 * var);
+}
+
+static double SprtLower(void) { return log(gBeta / (1.0 - gAlpha)); }
+static double SprtUpper(void) { return log((1.0 - gBeta) / gAlpha); }
+
+// ---------------------------------------------------------------------------------------------
+// Règles de fin de partie absentes du moteur : répétition, 50 coups, matériel insuffisant
+
+static bool InsufficientMaterial(const Board *board)
+{
+    int minors = 0;
+    for (int y = 0; y < BOARD_ROWS; y++)
+    {
+        for (int x = 0; x < BOARD_COLS; x++)
+        {
+            const Tile *t = &board->tiles[y][x];
+            if (t->layerCount <= 1) continue;
+            int id = t->layers[t->layerCount - 1] & ~1;
+            if (id == 6 || id == 8 || id == 12) return false; // Pion, Dame, Tour
+            if (id == 2 || id == 4) minors++;
+        }
+    }
+    return minors <= 1;
+}
+
+// Champs 5 et 6 du FEN (demi-coups depuis une prise ou un pion, numéro du coup)
+static void FenCounters(const char *fen, int *halfmove, int *fullmove)
+{
+    *halfmove = 0;
+    *fullmove = 1;
+    int field = 0;
+    for (const char *p = fen; *p != '\0'; p++)
+    {
+        if (*p == ' ' && p[1] != ' ' && p[1] != '\0')
+        {
+            field++;
+            if (field == 4) *halfmove = atoi(p + 1);
+            else if (field == 5) *fullmove = atoi(p + 1);
+        }
+    }
+    if (*fullmove < 1) *fullmove = 1;
+}
+
+// ---------------------------------------------------------------------------------------------
+// Partie
+
+typedef struct
+{
+    char *text; // Coups en notation SAN, numérotés
+    size_t length;
+    size_t capacity;
+} MoveText;
+
+static void MoveTextAppend(MoveText *mt, const char *s)
+{
+    size_t n = strlen(s);
+    if (mt->length + n + 1 > mt->capacity)
+    {
+        size_t capacity = (mt->capacity + n + 1) * 2;
+        char *grown = realloc(mt->text, capacity);
+        if (grown == NULL) return;
+        mt->text = grown;
+        mt->capacity = capacity;
+    }
+    memcpy(mt->text + mt->length, s, n + 1);
+    mt->length += n;
+}
+
+static void WritePgn(int gameIndex, const char *fen, int aWhite, GameResult result, const char *reason, const MoveText *mt)
+{
+    static const char *RESULT_TEXT[] = { "1-0", "0-1", "1/2-1/2" };
+    fprintf(gPgn, "[Event \"selfplay\"]\n[Site \"?\"]\n[Round \"%d\"]\n", gameIndex + 1);
+    fprintf(gPgn, "[White \"%s\"]\n[Black \"%s\"]\n", gEngines[aWhite ? 0 : 1].name, gEngines[aWhite ? 1 : 0].name);
+    fprintf(gPgn, "[Result \"%s\"]\n", RESULT_TEXT[result]);
+    if (strcmp(fen, START_FEN) != 0) fprintf(gPgn, "[SetUp \"1\"]\n[FEN \"%s\"]\n", fen);
+    fprintf(gPgn, "[Termination \"%s\"]\n\n", reason);
+
+    // Lignes de 80 colonnes au plus
+    int column = 0;
+    const char *p = (mt->text != NULL) ? mt->text : "";
+    while (*p != '\0')
+    {
+        const char *end = strchr(p, ' ');
+        int n = (end != NULL) ? (int)(end - p) : (int)strlen(p);
+        if (column > 0 && column + 1 + n > 80)
+        {
+            fputc('\n', gPgn);
+            column = 0;
+        }
+        else if (column > 0)
+        {
+            fputc(' ', gPgn);
+            column++;
+        }
+        fwrite(p, 1, (size_t)n, gPgn);
+        column += n;
+        p += n;
+        while (*p == ' ') p++;
+    }
+    fprintf(gPgn, "%s%s\n\n", (column > 0) ? " " : "", RESULT_TEXT[result]);
+    fflush(gPgn);
+}
+
+static GameResult PlayGame(int gameIndex, TTable *tables[2], EngineTotals totals[2], MoveText *mt, const char **reason)
+{
+    const char *fen = gOpenings[(gameIndex / 2) % gOpeningCount];
+    int aWhite = (gameIndex % 2 == 0);
+
+    static _Thread_local Board board;
+    if (!BoardFromFEN(&board, fen, NULL))
+    {
+        *reason = "FEN invalide";
+        return RESULT_DRAW;
+    }
+    int halfmove, fullmove;
+    FenCounters(fen, &halfmove, &fullmove);
+
+    for (int e = 0; e < 2; e++)
+    {
+        TT_Bind(tables[e]);
+        TT_Clear();
+    }
+
+    double clockMs[2];
+    for (int c = 0; c < 2; c++)
+    {
+        const EngineConfig *cfg = &gEngines[(c == 0) == aWhite ? 0 : 1];
+        clockMs[c] = cfg->baseMs;
+    }
+
+    uint64_t *history = malloc(sizeof(uint64_t) * (size_t)(gMaxPlies + 1));
+    int historyCount = 0;
+    if (history != NULL) history[historyCount++] = PositionKey(&board, board.sideToMove);
+
+    mt->length = 0;
+    MoveTextAppend(mt, "");
+    SearchControl control;
+    GameResult result = RESULT_DRAW;
+    *reason = "limite de coups";
+
+    for (int ply = 0; ply < gMaxPlies; ply++)
+    {
+        int side = board.sideToMove;
+        Move moves[MAX_MOVES];
+        if (GenerateLegalMoves(&board, moves, side) == 0)
+        {
+            if (IsKingInCheck(&board, side))
+            {
+                result = (side == 0) ? RESULT_BLACK_WINS : RESULT_WHITE_WINS;
+                *reason = "mat";
+            }
+            else *reason = "pat";
+            break;
+        }
+        if (InsufficientMaterial(&board))
+        {
+            *reason = "matériel insuffisant";
+            break;
+        }
+        if (halfmove >= 100)
+        {
+            *reason = "règle des 50 coups";
+            break;
+        }
+        int repeats = 0;
+        for (int i = historyCount - 1; i >= 0 && history != NULL; i--)
+        {
+            if (history[i] == history[historyCount - 1]) repeats++;
+        }
+        if (repeats >= 3)
+        {
+            *reason = "répétition";
+            break;
+        }
+
+        int engine = (side == 0) == aWhite ? 0 : 1;
+        const EngineConfig *cfg = &gEngines[engine];
+        SearchControl_Reset(&control);
+        if (cfg->moveTimeMs > 0.0) SearchControl_SetTime(&control, cfg->moveTimeMs, cfg->moveTimeMs);
+        else if (cfg->baseMs > 0.0)
+        {
+            double softMs, hardMs;
+            AllocateMoveTime(clockMs[side], cfg->incMs, 0, 0.0, &softMs, &hardMs);
+            SearchControl_SetTime(&control, softMs, hardMs);
+        }
+
+        SearchLimits limits = { 0 };
+        limits.depth = cfg->depth;
+        limits.nodes = cfg->nodes;
+        limits.threads = cfg->threads;
+        limits.materialEval = cfg->materialEval;
+        limits.noBitbases = cfg->noBitbases;
+        limits.control = &control;
+
+        TT_Bind(tables[engine]);
+        uint64_t start = Clock_NowNs();
+        Move best = SearchPosition(&board, &limits);
+        double ms = (double)(Clock_NowNs() - start) * 1e-6;
+        totals[engine].nodes += GetLastSearchStats()->totalNodes;
+        totals[engine].ms += ms;
+        totals[engine].moves++;
+
+        // Pendule : temps réellement consommé, puis incrément
+        if (cfg->baseMs > 0.0)
+        {
+            clockMs[side] -= ms;
+            if (clockMs[side] < 0.0)
+            {
+                result = (side == 0) ? RESULT_BLACK_WINS : RESULT_WHITE_WINS;
+                *reason = "temps dépassé";
+                totals[engine].timeLosses++;
+                break;
+            }
+            clockMs[side] += cfg->incMs;
+        }
+
+        char number[16], san[16];
+        if (side == 0) snprintf(number, sizeof(number), "%d. ", fullmove);
+        else if (ply == 0) snprintf(number, sizeof(number), "%d... ", fullmove);
+        else number[0] = '\0';
+        MoveToSAN(&board, best, 0, san);
+        MoveTextAppend(mt, number);
+        MoveTextAppend(mt, san);
+        MoveTextAppend(mt, " ");
+
+        bool pawnMove = (best.movingPieceID == 6 || best.movingPieceID == 7);
+        bool capture = (best.capturedPieceID != 0 || best.isEnPassant);
+        halfmove = (pawnMove || capture) ? 0 : halfmove + 1;
+        if (side == 1) fullmove++;
+
+        ApplyMove(&board, best, 0);
+        board.sideToMove = 1 - side;
+        if (history != NULL) history[historyCount++] = PositionKey(&board, board.sideToMove);
+    }
+
+    free(history);
+    return result;
+}
+
+static void *Worker(void *arg)
+{
+    (void)arg;
+    TTable *tables[2] = { TT_Create(gEngines[0].hashMB), TT_Create(gEngines[1].hashMB) };
+    if (tables[0] == NULL || tables[1] == NULL)
+    {
+        fprintf(stderr, "Table de transposition : allocation impossible\n");
+        TT_Destroy(tables[0]);
+        TT_Destroy(tables[1]);
+        return NULL;
+    }
+    MoveText mt = { 0 };
+
+    while (!atomic_load(&gStop))
+    {
+        int game = atomic_fetch_add(&gNextGame, 1);
+        if (game >= gGameCount) break;
+
+        EngineTotals totals[2] = { 0 };
+        const char *reason;
+        GameResult result = PlayGame(game, tables, totals, &mt, &reason);
+        int aWhite = (game % 2 == 0);
+
+        pthread_mutex_lock(&gLock);
+        bool aWins = (result == RESULT_WHITE_WINS && aWhite) || (result == RESULT_BLACK_WINS && !aWhite);
+        if (result == RESULT_DRAW) gDraws++;
+        else if (aWins) gWins++;
+        else gLosses++;
+        for (int e = 0; e < 2; e++)
+        {
+            gTotals[e].nodes += totals[e].nodes;
+            gTotals[e].ms += totals[e].ms;
+            gTotals[e].moves += totals[e].moves;
+            gTotals[e].timeLosses += totals[e].timeLosses;
+        }
+        gFinished++;
+
+        double elo, margin;
+        EloEstimate(gWins, gDraws, gLosses, &elo, &margin);
+        static const char *RESULT_TEXT[] = { "1-0", "0-1", "1/2-1/2" };
+        printf("Partie %4d/%d  %s-%s %-7s (%s)  +%ld =%ld -%ld  Elo %+.1f +/- %.1f",
+               gFinished, gGameCount, gEngines[aWhite ? 0 : 1].name, gEngines[aWhite ? 1 : 0].name,
+               RESULT_TEXT[result], reason, gWins, gDraws, gLosses, elo, margin);
+        if (gSprt)
+        {
+            double llr = SprtLLR(gWins, gDraws, gLosses);
+            printf("  LLR %.2f [%.2f, %.2f]", llr, SprtLower(), SprtUpper());
+            if (llr <= SprtLower() || llr >= SprtUpper()) atomic_store(&gStop, true);
+        }
+        printf("\n");
+        fflush(stdout);
+        if (gPgn != NULL) WritePgn(game, gOpenings[(game / 2) % gOpeningCount], aWhite, result, reason, &mt);
+        pthread_mutex_unlock(&gLock);
+    }
+
+    free(mt.text);
+    TT_Bind(NULL);
+    TT_Destroy(tables[0]);
+    TT_Destroy(tables[1]);
+    return NULL;
+}
+
+// ---------------------------------------------------------------------------------------------
+// Ligne de commande
+
+static bool ParseConfig(EngineConfig *cfg, const char *text)
+{
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer), "%s", text);
+    for (char *item = strtok(buffer, ","); item != NULL; item = strtok(NULL, ","))
+    {
+        char *value = strchr(item, '=');
+        if (value == NULL) return false;
+        *value++ = '\0';
+
+        if (strcmp(item, "name") == 0) snprintf(cfg->name, sizeof(cfg->name), "%s", value);
+        else if (strcmp(item, "depth") == 0) cfg->depth = atoi(value);
+        else if (strcmp(item, "nodes") == 0) cfg->nodes = atol(value);
+        else if (strcmp(item, "movetime") == 0) cfg->moveTimeMs = atof(value);
+        else if (strcmp(item, "tc") == 0)
+        {
+            char *plus = strchr(value, '+');
+            cfg->baseMs = atof(value) * 1000.0;
+            cfg->incMs = (plus != NULL) ? atof(plus + 1) * 1000.0 : 0.0;
+        }
+        else if (strcmp(item, "threads") == 0) cfg->threads = atoi(value);
+        else if (strcmp(item, "hash") == 0) cfg->hashMB = atoi(value);
+        else if (strcmp(item, "eval") == 0) cfg->materialEval = (strcmp(value, "material") == 0);
+        else if (strcmp(item, "bitbases") == 0) cfg->noBitbases = (strcmp(value, "off") == 0);
+        else return false;
+    }
+    if (cfg->depth <= 0 && cfg->nodes <= 0 && cfg->moveTimeMs <= 0.0 && cfg->baseMs <= 0.0) cfg->depth = DEFAULT_DEPTH;
+    if (cfg->hashMB <= 0) cfg->hashMB = TT_DEFAULT_MB;
+    return true;
+}
+
+static void DescribeConfig(const EngineConfig *cfg)
+{
+    printf("  %-8s", cfg->name);
+    if (cfg->depth > 0) printf(" profondeur %d", cfg->depth);
+    if (cfg->nodes > 0) printf(" noeuds %ld", cfg->nodes);
+    if (cfg->moveTimeMs > 0.0) printf(" %.0f ms/coup", cfg->moveTimeMs);
+    if (cfg->baseMs > 0.0) printf(" pendule %.1f s + %.2f s", cfg->baseMs / 1000.0, cfg->incMs / 1000.0);
+    printf(", %d thread(s), table %d Mo, éval %s%s\n", (cfg->threads > 1) ? cfg->threads : 1, cfg->hashMB,
+           cfg->materialEval || !NNUE_IsLoaded() ? "matérielle" : "NNUE", cfg->noBitbases ? ", sans bitbases" : "");
+}
+
+static char *CopyString(const char *s)
+{
+    size_t n = strlen(s) + 1;
+    char *copy = malloc(n);
+    if (copy != NULL) memcpy(copy, s, n);
+    return copy;
+}
+
+// Une position par ligne (FEN ou EPD : seuls les 4 premiers champs sont obligatoires)
+static int LoadOpenings(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (f == NULL) return -1;
+    char line[512];
+    while (gOpeningCount < MAX_OPENINGS && fgets(line, sizeof(line), f) != NULL)
+    {
+        char fields[6][96];
+        int n = sscanf(line, "%95s %95s %95s %95s %95s %95s", fields[0], fields[1], fields[2], fields[3], fields[4], fields[5]);
+        if (n < 4 || fields[0][0] == '#') continue;
+
+        // EPD : compteurs absents (ou remplacés par des opérations "bm ...;")
+        bool counters = (n == 6 && fields[4][0] >= '0' && fields[4][0] <= '9' && fields[5][0] >= '0' && fields[5][0] <= '9');
+        char fen[640];
+        snprintf(fen, sizeof(fen), "%s %s %s %s %s %s", fields[0], fields[1], fields[2], fields[3],
+                 counters ? fields[4] : "0", counters ? fields[5] : "1");
+        gOpenings[gOpeningCount++] = CopyString(fen);
+    }
+    fclose(f);
+    return gOpeningCount;
+}
+
+int main(int argc, char **argv)
+{
+    const char *configA = "";
+    const char *configB = "";
+    const char *openingsPath = NULL;
+    const char *pgnPath = NULL;
+    const char *nnuePath = NULL;
+    const char *bitbaseDir = NULL;
+    int concurrency = Clock_CoreCount();
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = (i + 1 < argc);
+        if (strcmp(argv[i], "--a") == 0 && hasValue) configA = argv[++i];
+        else if (strcmp(argv[i], "--b") == 0 && hasValue) configB = argv[++i];
+        else if (strcmp(argv[i], "--games") == 0 && hasValue) gGameCount = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--concurrency") == 0 && hasValue) concurrency = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--openings") == 0 && hasValue) openingsPath = argv[++i];
+        else if (strcmp(argv[i], "--pgn") == 0 && hasValue) pgnPath = argv[++i];
+        else if (strcmp(argv[i], "--max-plies") == 0 && hasValue) gMaxPlies = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--nnue") == 0 && hasValue) nnuePath = argv[++i];
+        else if (strcmp(argv[i], "--bitbases") == 0 && hasValue) bitbaseDir = argv[++i];
+        else if (strcmp(argv[i], "--sprt") == 0 && hasValue)
+        {
+            gSprt = true;
+            sscanf(argv[++i], "%lf,%lf,%lf,%lf", &gElo0, &gElo1, &gAlpha, &gBeta);
+        }
+        else
+        {
+            fprintf(stderr, "Usage : selfplay --a <réglage> --b <réglage> [--games N] [--concurrency K] [--openings fichier]\n"
+                            "                 [--sprt elo0,elo1[,alpha,beta]] [--pgn fichier] [--max-plies N]\n"
+                            "                 [--nnue fichier] [--bitbases dossier]\n"
+                            "Réglage : name=,depth=,nodes=,movetime=ms,tc=s+inc,threads=,hash=Mo,eval=nnue|material,bitbases=on|off\n");
+            return 1;
+        }
+    }
+
+    snprintf(gEngines[0].name, sizeof(gEngines[0].name), "A");
+    snprintf(gEngines[1].name, sizeof(gEngines[1].name), "B");
+    if (!ParseConfig(&gEngines[0], configA) || !ParseConfig(&gEngines[1], configB))
+    {
+        fprintf(stderr, "Réglage invalide (clé=valeur séparés par des virgules)\n");
+        return 1;
+    }
+    if (gGameCount < 1) gGameCount = 1;
+    if (gMaxPlies < 1) gMaxPlies = DEFAULT_MAX_PLIES;
+    if (concurrency < 1) concurrency = 1;
+    if (concurrency > MAX_WORKERS) concurrency = MAX_WORKERS;
+    if (concurrency > gGameCount) concurrency = gGameCount;
+
+    Zobrist_Init();
+    if (nnuePath != NULL && !NNUE_Load(nnuePath)) fprintf(stderr, "NNUE : impossible de charger %s\n", nnuePath);
+    if (bitbaseDir != NULL) Bitbase_Load(bitbaseDir);
+
+    if (openingsPath != NULL)
+    {
+        if (LoadOpenings(openingsPath) <= 0)
+        {
+            fprintf(stderr, "Aucune ouverture lue dans %s\n", openingsPath);
+            return 1;
+        }
+    }
+    else
+    {
+        gOpeningCount = (int)(sizeof(DEFAULT_OPENINGS) / sizeof(DEFAULT_OPENINGS[0]));
+        for (int i = 0; i < gOpeningCount; i++) gOpenings[i] = CopyString(DEFAULT_OPENINGS[i]);
+    }
+
+    if (pgnPath != NULL && (gPgn = fopen(pgnPath, "w")) == NULL)
+    {
+        fprintf(stderr, "Impossible d'ouvrir %s\n", pgnPath);
+        return 1;
+    }
+
+    printf("%d parties, %d ouvertures, %d en parallèle\n", gGameCount, gOpeningCount, concurrency);
+    DescribeConfig(&gEngines[0]);
+    DescribeConfig(&gEngines[1]);
+    if (gSprt) printf("SPRT : elo0 %.1f, elo1 %.1f, alpha %.3f, beta %.3f\n", gElo0, gElo1, gAlpha, gBeta);
+
+    atomic_init(&gNextGame, 0);
+    atomic_init(&gStop, false);
+    uint64_t start = Clock_NowNs();
+
+    pthread_t workers[MAX_WORKERS];
+    int started = 0;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, WORKER_STACK);
+    for (int i = 0; i < concurrency; i++)
+    {
+        if (pthread_create(&workers[started], &attr, Worker, NULL) == 0) started++;
+    }
+    pthread_attr_destroy(&attr);
+    for (int i = 0; i < started; i++) pthread_join(workers[i], NULL);
+    double seconds = (double)(Clock_NowNs() - start) * 1e-9;
+
+    double elo, margin;
+    EloEstimate(gWins, gDraws, gLosses, &elo, &margin);
+    long n = gWins + gDraws + gLosses;
+    printf("\n%s contre %s : %ld parties en %.1f s\n", gEngines[0].name, gEngines[1].name, n, seconds);
+    printf("  +%ld =%ld -%ld, score %.1f %%\n", gWins, gDraws, gLosses, (n > 0) ? 100.0 * (gWins + 0.5 * gDraws) / n : 0.0);
+    printf("  Elo %+.1f +/- %.1f (95 %%)\n", elo, margin);
+    if (gSprt)
+    {
+        double llr = SprtLLR(gWins, gDraws, gLosses);
+        const char *verdict = (llr >= SprtUpper()) ? "H1 acceptée (A est meilleur d'au moins elo1)"
+                            : (llr <= SprtLower()) ? "H0 acceptée (gain inférieur à elo0)"
+                            : "pas de décision";
+        printf("  SPRT : LLR %.2f [%.2f, %.2f], %s\n", llr, SprtLower(), SprtUpper(), verdict);
+    }
+    for (int e = 0; e < 2; e++)
+    {
+        const EngineTotals *t = &gTotals[e];
+        printf("  %-8s %8.0f noeuds/s, %.1f ms par coup, %ld défaite(s) au temps\n", gEngines[e].name,
+               (t->ms > 0.0) ? t->nodes * 1000.0 / t->ms : 0.0, (t->moves > 0) ? t->ms / t->moves : 0.0, t->timeLosses);
+    }
+
+    if (gPgn != NULL) fclose(gPgn);
+    for (int i = 0; i < gOpeningCount; i++) free(gOpenings[i]);
+    Bitbase_Unload();
+    NNUE_Unload();
+    return 0;
+}
@@ -0,0 +1,261 @@
+// Résumé d'une trace de recherche enregistrée par une version TRACE=1 du jeu (option --trace).
+// Usage : tracestat <fichier> [numéro de recherche]
+//
+// Affiche les noeuds par profondeur, la qualité du tri des coups (indice de la coupure)
+// et le temps passé par itération et par coup racine (dernière recherche par défaut).
+
+#include "searchtrace.h"
+#include "tt.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_PLY 128
+#define MAX_DEPTH 64
+#define MAX_ROOT_MOVES 256
+#define MAX_ITERATIONS 4096
+#define CUTOFF_BUCKETS 6 // 0, 1, 2, 3, 4-7, 8+
+
+typedef struct
+{
+    long nodes;
+    long exits[5]; // Par raison TRACE_EXIT_*
+} DepthStats;
+
+typedef struct
+{
+    int search;
+    int depth;
+    long nodes;
+    uint32_t startUs;
+    uint32_t endUs;
+} IterationStats;
+
+typedef struct
+{
+    uint16_t move;
+    int score;
+    long nodes;
+    uint32_t timeUs;
+} RootMove;
+
+static DepthStats byPly[MAX_PLY];
+static DepthStats byDepth[MAX_DEPTH];
+static IterationStats iterations[MAX_ITERATIONS];
+static int iterationCount = 0;
+static RootMove rootMoves[MAX_ROOT_MOVES];
+static int rootMoveCount = 0;
+
+static long cutoffBuckets[CUTOFF_BUCKETS];
+static long cutoffNodes = 0;
+static long cutoffMovesSearched = 0;
+static long allNodes = 0;  // Noeuds parcourus sans coupure
+static long allMovesSearched = 0;
+
+static int CutoffBucket(int index)
+{
+    if (index < 4) return index;
+    return (index < 8) ? 4 : 5;
+}
+
+static void MoveToText(uint16_t move, char out[6])
+{
+    snprintf(out, 6, "%c%c%c%c",
+             'a' + TT_MOVE_START_X(move), '8' - TT_MOVE_START_Y(move),
+             'a' + TT_MOVE_END_X(move), '8' - TT_MOVE_END_Y(move));
+}
+
+static int CompareRootMoves(const void *a, const void *b)
+{
+    const RootMove *x = a;
+    const RootMove *y = b;
+    if (x->timeUs != y->timeUs) return (x->timeUs > y->timeUs) ? -1 : 1;
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage : tracestat <fichier> [numéro de recherche]\n");
+        return 1;
+    }
+    int targetSearch = (argc > 2) ? atoi(argv[2]) : -1;
+
+    FILE *f = fopen(argv[1], "rb");
+    if (f == NULL)
+    {
+        fprintf(stderr, "Impossible d'ouvrir %s\n", argv[1]);
+        return 1;
+    }
+
+    TraceHeader header;
+    if (fread(&header, sizeof(header), 1, f) != 1 || memcmp(header.magic, TRACE_MAGIC, 4) != 0
+        || header.version != TRACE_VERSION || header.recordSize != sizeof(TraceRecord))
+    {
+        fprintf(stderr, "%s n'est pas une trace de recherche valide\n", argv[1]);
+        fclose(f);
+        return 1;
+    }
+
+    // Pile des noeuds ouverts : instant d'entrée et compteur de noeuds à l'entrée
+    static uint32_t enterTime[MAX_PLY];
+    static long enterNodes[MAX_PLY];
+
+    int searchCount = 0;
+    long totalRecords = 0;
+    long totalNodes = 0;
+    uint32_t lastTime = 0;
+    IterationStats *iteration = NULL;
+    bool trackRoot = false;
+
+    static TraceRecord chunk[4096];
+    size_t read;
+    while ((read = fread(chunk, sizeof(TraceRecord), 4096, f)) > 0)
+    {
+        for (size_t i = 0; i < read; i++)
+        {
+            const TraceRecord *r = &chunk[i];
+            totalRecords++;
+            lastTime = r->timeUs;
+
+            switch (r->type)
+            {
+                case TRACE_SEARCH_BEGIN:
+                    if (iteration != NULL) iteration->endUs = lastTime;
+                    iteration = NULL;
+                    searchCount++;
+                    break;
+
+                case TRACE_ITERATION:
+                    if (iteration != NULL) iteration->endUs = r->timeUs;
+                    iteration = NULL;
+                    if (iterationCount < MAX_ITERATIONS)
+                    {
+                        iteration = &iterations[iterationCount++];
+                        iteration->search = searchCount;
+                        iteration->depth = r->depth;
+                        iteration->nodes = 0;
+                        iteration->startUs = r->timeUs;
+                        iteration->endUs = r->timeUs;
+                    }
+                    // Les coups racine retenus sont ceux de la dernière itération de la recherche choisie
+                    trackRoot = (targetSearch < 0 || targetSearch == searchCount);
+                    if (trackRoot) rootMoveCount = 0;
+                    break;
+
+                case TRACE_ENTER:
+                    totalNodes++;
+                    if (iteration != NULL) iteration->nodes++;
+                    if (r->ply < MAX_PLY)
+                    {
+                        byPly[r->ply].nodes++;
+                        enterTime[r->ply] = r->timeUs;
+                        enterNodes[r->ply] = totalNodes;
+                    }
+                    if (r->depth >= 0 && r->depth < MAX_DEPTH) byDepth[r->depth].nodes++;
+                    break;
+
+                case TRACE_EXIT:
+                {
+                    int reason = (r->info < 5) ? r->info : TRACE_EXIT_SEARCHED;
+                    if (r->ply < MAX_PLY) byPly[r->ply].exits[reason]++;
+                    if (r->depth >= 0 && r->depth < MAX_DEPTH) byDepth[r->depth].exits[reason]++;
+
+                    if (reason == TRACE_EXIT_SEARCHED)
+                    {
+                        if (r->extra != TRACE_NO_CUTOFF)
+                        {
+                            cutoffNodes++;
+                            cutoffMovesSearched += r->b;
+                            cutoffBuckets[CutoffBucket(r->extra)]++;
+                        }
+                        else
+                        {
+                            allNodes++;
+                            allMovesSearched += r->b;
+                        }
+                    }
+
+                    if (r->ply == 1 && trackRoot && rootMoveCount < MAX_ROOT_MOVES)
+                    {
+                        RootMove *rm = &rootMoves[rootMoveCount++];
+                        rm->move = r->move;
+                        rm->score = r->a;
+                        rm->nodes = totalNodes - enterNodes[1] + 1;
+                        rm->timeUs = r->timeUs - enterTime[1];
+                    }
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+    }
+    if (iteration != NULL) iteration->endUs = lastTime;
+    fclose(f);
+
+    printf("%s : %ld enregistrements, %d recherches, %ld noeuds\n\n", argv[1], totalRecords, searchCount, totalNodes);
+
+    printf("Noeuds par ply (distance à la racine)\n");
+    printf("  ply      noeuds  recherche    feuille      table    bitbase    mat/pat\n");
+    for (int p = 0; p < MAX_PLY; p++)
+    {
+        if (byPly[p].nodes == 0) continue;
+        printf("  %3d  %10ld", p, byPly[p].nodes);
+        for (int k = 0; k < 5; k++) printf(" %10ld", byPly[p].exits[k]);
+        printf("\n");
+    }
+
+    printf("\nNoeuds par profondeur restante\n");
+    printf("  prof     noeuds  recherche    feuille      table    bitbase    mat/pat\n");
+    for (int d = MAX_DEPTH - 1; d >= 0; d--)
+    {
+        if (byDepth[d].nodes == 0) continue;
+        printf("  %4d  %9ld", d, byDepth[d].nodes);
+        for (int k = 0; k < 5; k++) printf(" %10ld", byDepth[d].exits[k]);
+        printf("\n");
+    }
+
+    printf("\nTri des coups\n");
+    if (cutoffNodes > 0)
+    {
+        static const char *BUCKET_NAMES[CUTOFF_BUCKETS] = { "1er", "2e", "3e", "4e", "5e-8e", "9e+" };
+        printf("  %ld noeuds avec coupure, %.2f coups essayés en moyenne\n",
+               cutoffNodes, (double)cutoffMovesSearched / cutoffNodes);
+        for (int k = 0; k < CUTOFF_BUCKETS; k++)
+        {
+            printf("  coupure au %-6s coup : %10ld (%5.1f %%)\n",
+                   BUCKET_NAMES[k], cutoffBuckets[k], 100.0 * cutoffBuckets[k] / cutoffNodes);
+        }
+    }
+    if (allNodes > 0)
+    {
+        printf("  %ld noeuds sans coupure, %.2f coups en moyenne\n", allNodes, (double)allMovesSearched / allNodes);
+    }
+
+    printf("\nItérations\n");
+    printf("  rech  prof      noeuds    temps (ms)\n");
+    for (int i = 0; i < iterationCount; i++)
+    {
+        const IterationStats *it = &iterations[i];
+        if (targetSearch >= 0 && it->search != targetSearch) continue;
+        printf("  %4d  %4d  %10ld  %12.3f\n", it->search, it->depth, it->nodes, (it->endUs - it->startUs) / 1000.0);
+    }
+
+    if (rootMoveCount > 0)
+    {
+        qsort(rootMoves, (size_t)rootMoveCount, sizeof(RootMove), CompareRootMoves);
+        printf("\nCoups racine de la recherche %d (dernière itération, par temps)\n",
+               (targetSearch >= 0) ? targetSearch : searchCount);
+        printf("  coup       score      noeuds    temps (ms)\n");
+        for (int i = 0; i < rootMoveCount; i++)
+        {
+            char text[6];
+            MoveToText(rootMoves[i].move, text);
+            printf("  %-5s  %9d  %10ld  %12.3f\n", text, rootMoves[i].score, rootMoves[i].nodes, rootMoves[i].timeUs / 1000.0);
+        }
+    }
+    return 0;
+}
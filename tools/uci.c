@@ -0,0 +1,394 @@
+// Moteur UCI en console (libchesscore, sans fenêtre ni audio) : interfaces d'analyse,
+// gestionnaires de tournois, bancs de test.
+// Usage : uci [--nnue fichier] [--bitbases dossier]
+//
+// Commandes : uci, isready, setoption (Hash, Threads, Ponder, Move Overhead, Clear Hash),
+// ucinewgame, position [startpos | fen ...] [moves ...], go, stop, ponderhit, quit.
+// La recherche tourne sur son propre thread : "stop" et "ponderhit" sont lus pendant qu'elle calcule.
+
+#include "chesscore.h"
+#include "bitbase.h"
+#include "searchstats.h"
+#include "tt.h"
+#include "zobrist.h"
+#include "clock.h"
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define UCI_LINE_MAX 65536
+#define UCI_MAX_THREADS 64
+#define UCI_MAX_HASH_MB 4096
+#define UCI_DEFAULT_OVERHEAD_MS 30 // Latence de l'interface et du système, retirée du temps alloué
+#define UCI_THREAD_STACK (8 * 1024 * 1024)
+
+typedef struct
+{
+    double time, inc;  // Camp au trait, en ms
+    int movesToGo;
+    double moveTime;
+    int depth;
+    long nodes;
+    bool infinite;
+    bool ponder;
+} GoParams;
+
+static Board gBoard;        // Position reçue par "position"
+static Board gSearchBoard;  // Copie de travail du thread de recherche
+static SearchControl gControl;
+static SearchLimits gLimits;
+static uint64_t gSearchStart = 0;
+
+static pthread_t gSearchThread;
+static bool gSearching = false;
+static int gThreads = 1;
+static int gOverheadMs = UCI_DEFAULT_OVERHEAD_MS;
+
+// Réflexion sur le temps adverse ("go ponder") et analyse infinie : le coup n'est annoncé
+// qu'après "ponderhit" ou "stop", même si la recherche se termine avant
+static pthread_mutex_t gWakeLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t gWakeCond = PTHREAD_COND_INITIALIZER;
+static bool gPondering = false;
+static bool gInfinite = false;
+static double gPonderSoftMs = 0.0; // Temps appliqué au moment du "ponderhit"
+static double gPonderHardMs = 0.0;
+
+static pthread_mutex_t gOutputLock = PTHREAD_MUTEX_INITIALIZER;
+
+static void Send(const char *format, ...)
+{
+    pthread_mutex_lock(&gOutputLock);
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+    putchar('\n');
+    fflush(stdout);
+    pthread_mutex_unlock(&gOutputLock);
+}
+
+// Notation UCI : le moteur promeut toujours en Dame
+static void UciMove(Move move, char out[6])
+{
+    MoveToString(move, out);
+    if (move.startX >= 0 && ((move.movingPieceID == 6 && move.endY == 0) || (move.movingPieceID == 7 && move.endY == 7)))
+    {
+        out[4] = 'q';
+        out[5] = '\0';
+    }
+}
+
+static bool ApplyUciMove(Board *board, const char *text)
+{
+    if (strlen(text) < 4) return false;
+    int sx = text[0] - 'a', sy = '8' - text[1];
+    int ex = text[2] - 'a', ey = '8' - text[3];
+
+    Move moves[MAX_MOVES];
+    int count = GenerateLegalMoves(board, moves, board->sideToMove);
+    for (int i = 0; i < count; i++)
+    {
+        const Move *m = &moves[i];
+        if (m->startX != sx || m->startY != sy || m->endX != ex || m->endY != ey) continue;
+
+        // Pièce de promotion : ID blanc, +1 pour les Noirs (0 = Dame)
+        int promotion = 0;
+        switch (text[4])
+        {
+            case 'n': promotion = 2; break;
+            case 'b': promotion = 4; break;
+            case 'r': promotion = 12; break;
+            case 'q': promotion = 8; break;
+            default: break;
+        }
+        if (promotion != 0) promotion += board->sideToMove;
+
+        ApplyMove(board, *m, promotion);
+        board->sideToMove = 1 - board->sideToMove;
+        return true;
+    }
+    return false;
+}
+
+// Une ligne "info" par itération terminée (thread de recherche)
+static void SendIteration(void *user)
+{
+    (void)user;
+    const SearchStats *stats = GetLastSearchStats();
+    const SearchIteration *it = &stats->iterations[stats->iterationCount - 1];
+
+    // Score vu du camp au trait ; mat à ±INFINITY, distance estimée par la longueur de la variante
+    int score = (stats->side == 0) ? it->score : -it->score;
+    char scoreText[32];
+    if (score >= INFINITY || score <= -INFINITY)
+    {
+        int mateIn = (it->pvLength + 1) / 2;
+        snprintf(scoreText, sizeof(scoreText), "mate %d", (score > 0) ? mateIn : -mateIn);
+    }
+    else snprintf(scoreText, sizeof(scoreText), "cp %d", score);
+
+    char pv[SEARCH_MAX_PV * 6 + 1] = "";
+    for (int i = 0; i < it->pvLength; i++)
+    {
+        char move[6];
+        UciMove(it->pv[i], move);
+        if (i > 0) strcat(pv, " ");
+        strcat(pv, move);
+    }
+
+    double ms = (double)(Clock_NowNs() - gSearchStart) * 1e-6;
+    Send("info depth %d score %s nodes %ld nps %.0f time %.0f pv %s",
+         it->depth, scoreText, stats->totalNodes, (ms > 0.0) ? stats->totalNodes * 1000.0 / ms : 0.0, ms, pv);
+}
+
+static void *SearchMain(void *arg)
+{
+    (void)arg;
+    Move best = SearchPosition(&gSearchBoard, &gLimits);
+
+    pthread_mutex_lock(&gWakeLock);
+    while ((gPondering || gInfinite) && !atomic_load(&gControl.stop)) pthread_cond_wait(&gWakeCond, &gWakeLock);
+    pthread_mutex_unlock(&gWakeLock);
+
+    const SearchStats *stats = GetLastSearchStats();
+    double ms = (double)(Clock_NowNs() - gSearchStart) * 1e-6;
+    Send("info nodes %ld nps %.0f time %.0f", stats->totalNodes, (ms > 0.0) ? stats->totalNodes * 1000.0 / ms : 0.0, ms);
+
+    char move[6], ponder[6];
+    UciMove(best, move);
+    const SearchIteration *last = (stats->iterationCount > 0) ? &stats->iterations[stats->iterationCount - 1] : NULL;
+    if (last != NULL && last->pvLength >= 2)
+    {
+        UciMove(last->pv[1], ponder);
+        Send("bestmove %s ponder %s", move, ponder);
+    }
+    else Send("bestmove %s", move);
+    return NULL;
+}
+
+// Réveille le thread de recherche qui attend "stop" ou "ponderhit"
+static void Wake(bool stopPondering, bool stopSearch)
+{
+    pthread_mutex_lock(&gWakeLock);
+    if (stopPondering) gPondering = false;
+    if (stopSearch)
+    {
+        gInfinite = false;
+        SearchControl_Stop(&gControl);
+    }
+    pthread_cond_broadcast(&gWakeCond);
+    pthread_mutex_unlock(&gWakeLock);
+}
+
+static void StopSearch(void)
+{
+    if (!gSearching) return;
+    Wake(true, true);
+    pthread_join(gSearchThread, NULL);
+    gSearching = false;
+}
+
+// Temps alloué au coup : échéance douce (pas de nouvelle itération) et dure (arrêt immédiat)
+static void AllocateTime(const GoParams *go, double *softMs, double *hardMs)
+{
+    *softMs = 0.0;
+    *hardMs = 0.0;
+    if (go->moveTime > 0.0)
+    {
+        *hardMs = (go->moveTime - gOverheadMs > 1.0) ? go->moveTime - gOverheadMs : 1.0;
+        *softMs = *hardMs;
+        return;
+    }
+    if (go->time > 0.0) AllocateMoveTime(go->time, go->inc, go->movesToGo, gOverheadMs, softMs, hardMs);
+}
+
+static void Go(char *args)
+{
+    StopSearch();
+
+    GoParams go = { 0 };
+    double wtime = 0, btime = 0, winc = 0, binc = 0;
+    for (char *token = strtok(args, " \t"); token != NULL; token = strtok(NULL, " \t"))
+    {
+        char *value = NULL;
+        if (strcmp(token, "infinite") == 0) go.infinite = true;
+        else if (strcmp(token, "ponder") == 0) go.ponder = true;
+        else if ((value = strtok(NULL, " \t")) == NULL) break;
+        else if (strcmp(token, "wtime") == 0) wtime = atof(value);
+        else if (strcmp(token, "btime") == 0) btime = atof(value);
+        else if (strcmp(token, "winc") == 0) winc = atof(value);
+        else if (strcmp(token, "binc") == 0) binc = atof(value);
+        else if (strcmp(token, "movestogo") == 0) go.movesToGo = atoi(value);
+        else if (strcmp(token, "movetime") == 0) go.moveTime = atof(value);
+        else if (strcmp(token, "depth") == 0) go.depth = atoi(value);
+        else if (strcmp(token, "nodes") == 0) go.nodes = atol(value);
+        else if (strcmp(token, "mate") == 0) go.depth = 2 * atoi(value);
+    }
+    go.time = (gBoard.sideToMove == 0) ? wtime : btime;
+    go.inc = (gBoard.sideToMove == 0) ? winc : binc;
+
+    double softMs, hardMs;
+    AllocateTime(&go, &softMs, &hardMs);
+    SearchControl_Reset(&gControl);
+    gPondering = go.ponder;
+    gInfinite = go.infinite;
+    gPonderSoftMs = softMs;
+    gPonderHardMs = hardMs;
+    // En réflexion, la pendule ne part qu'au "ponderhit"
+    if (!go.ponder && !go.infinite) SearchControl_SetTime(&gControl, softMs, hardMs);
+
+    gLimits = (SearchLimits){ 0 };
+    gLimits.depth = go.depth;
+    gLimits.nodes = go.nodes;
+    gLimits.threads = gThreads;
+    gLimits.control = &gControl;
+    gLimits.onIteration = SendIteration;
+    gSearchBoard = gBoard;
+    gSearchStart = Clock_NowNs();
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, UCI_THREAD_STACK);
+    gSearching = (pthread_create(&gSearchThread, &attr, SearchMain, NULL) == 0);
+    pthread_attr_destroy(&attr);
+    if (!gSearching) Send("info string impossible de lancer la recherche");
+}
+
+static void Position(char *args)
+{
+    // position [startpos | fen <6 champs>] [moves <coup> ...]
+    char *movesPart = strstr(args, "moves");
+    if (movesPart != NULL)
+    {
+        *movesPart = '\0';
+        movesPart += 5;
+    }
+
+    char *fen = strstr(args, "fen");
+    if (fen != NULL)
+    {
+        fen += 3;
+        while (*fen == ' ') fen++;
+        if (!BoardFromFEN(&gBoard, fen, NULL))
+        {
+            Send("info string FEN invalide");
+            BoardReset(&gBoard);
+        }
+    }
+    else BoardReset(&gBoard);
+
+    for (char *token = (movesPart != NULL) ? strtok(movesPart, " \t") : NULL; token != NULL; token = strtok(NULL, " \t"))
+    {
+        if (!ApplyUciMove(&gBoard, token))
+        {
+            Send("info string coup illégal : %s", token);
+            break;
+        }
+    }
+}
+
+static void SetOption(char *args)
+{
+    // setoption name <nom avec espaces> [value <valeur>]
+    char *name = strstr(args, "name");
+    if (name == NULL) return;
+    name += 4;
+    char *value = strstr(name, " value ");
+    if (value != NULL)
+    {
+        *value = '\0';
+        value += 7;
+    }
+    while (*name == ' ') name++;
+
+    StopSearch();
+    if (strcmp(name, "Hash") == 0 && value != NULL)
+    {
+        int mb = atoi(value);
+        if (mb < 1) mb = 1;
+        if (mb > UCI_MAX_HASH_MB) mb = UCI_MAX_HASH_MB;
+        if (!TT_Init(mb)) Send("info string table de %d Mo impossible à allouer", mb);
+    }
+    else if (strcmp(name, "Threads") == 0 && value != NULL)
+    {
+        gThreads = atoi(value);
+        if (gThreads < 1) gThreads = 1;
+        if (gThreads > UCI_MAX_THREADS) gThreads = UCI_MAX_THREADS;
+    }
+    else if (strcmp(name, "Move Overhead") == 0 && value != NULL)
+    {
+        gOverheadMs = atoi(value);
+        if (gOverheadMs < 0) gOverheadMs = 0;
+    }
+    else if (strcmp(name, "Clear Hash") == 0) TT_Clear();
+    // "Ponder" : seule l'interface s'en sert (elle envoie "go ponder")
+}
+
+int main(int argc, char **argv)
+{
+    const char *nnuePath = NULL;
+    const char *bitbaseDir = NULL;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--nnue") == 0 && i + 1 < argc) nnuePath = argv[++i];
+        else if (strcmp(argv[i], "--bitbases") == 0 && i + 1 < argc) bitbaseDir = argv[++i];
+    }
+
+    Zobrist_Init();
+    if (!TT_Init(TT_DEFAULT_MB)) fprintf(stderr, "Table de transposition : allocation impossible\n");
+    if (nnuePath != NULL && !NNUE_Load(nnuePath)) fprintf(stderr, "NNUE : impossible de charger %s\n", nnuePath);
+    if (bitbaseDir != NULL) Bitbase_Load(bitbaseDir);
+    BoardReset(&gBoard);
+    SearchControl_Reset(&gControl);
+
+    static char line[UCI_LINE_MAX];
+    while (fgets(line, sizeof(line), stdin) != NULL)
+    {
+        line[strcspn(line, "\r\n")] = '\0';
+        char *command = line;
+        while (*command == ' ' || *command == '\t') command++;
+        char *args = command + strcspn(command, " \t");
+        if (*args != '\0') *args++ = '\0';
+
+        if (strcmp(command, "uci") == 0)
+        {
+            Send("id name projetC");
+            Send("id author projetC");
+            Send("option name Hash type spin default %d min 1 max %d", TT_DEFAULT_MB, UCI_MAX_HASH_MB);
+            Send("option name Threads type spin default 1 min 1 max %d", UCI_MAX_THREADS);
+            Send("option name Ponder type check default false");
+            Send("option name Move Overhead type spin default %d min 0 max 5000", UCI_DEFAULT_OVERHEAD_MS);
+            Send("option name Clear Hash type button");
+            Send("uciok");
+        }
+        else if (strcmp(command, "isready") == 0) Send("readyok");
+        else if (strcmp(command, "setoption") == 0) SetOption(args);
+        else if (strcmp(command, "ucinewgame") == 0)
+        {
+            StopSearch();
+            TT_Clear();
+        }
+        else if (strcmp(command, "position") == 0)
+        {
+            StopSearch();
+            Position(args);
+        }
+        else if (strcmp(command, "go") == 0) Go(args);
+        else if (strcmp(command, "stop") == 0) StopSearch();
+        else if (strcmp(command, "ponderhit") == 0)
+        {
+            // Le coup attendu a été joué : la réflexion devient une recherche normale, pendule lancée maintenant
+            SearchControl_SetTime(&gControl, gPonderSoftMs, gPonderHardMs);
+            Wake(true, false);
+        }
+        else if (strcmp(command, "quit") == 0) break;
+    }
+
+    StopSearch();
+    Bitbase_Unload();
+    NNUE_Unload();
+    TT_Free();
+    return 0;
+}